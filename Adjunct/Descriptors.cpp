@@ -11,170 +11,330 @@
 //	© 0000 (uncopyrighted; use at will)
 //
 #include "Descriptors.h"
+#include "FrameConstants.h"
 #include "ResourceTracker.h"
+#include "LayoutCache.h"
+#include "Helpers.h"
 
 
-Descriptors::Descriptors(vector<DescribEd>& describeds, Swapchain& swapchain, GraphicsDevice& device)
+Descriptors::Descriptors(vector<DescribEd>& describeds, Swapchain& swapchain, GraphicsDevice& device,
+						 Customizer customize, FrameConstants* pFrameConstants)
 	:	BufferBase(device),
 		describers(describeds),
 		numBuffers(static_cast<uint32_t>(swapchain.getImageViews().size())),
-		descriptorPool(VK_NULL_HANDLE)
+		allocator(device.getDescriptorAllocator()),
+		writer(device.getDescriptorWriter()),
+		bindless(device.getBindless()),
+		pFrameConstants((customize & SETS_BY_FREQUENCY) ? pFrameConstants : nullptr),
+		isByFrequency(customize & SETS_BY_FREQUENCY),
+		isBindless((customize & BINDLESS) && device.getBindless().IsEnabled()),
+		isPushable((customize & PUSH_DESCRIPTORS) && device.getDescriptorWriter().usesPushDescriptors())
 {
-	createDescriptorSetLayout();
-	if (describeds.size() == 0)
-		return;		// (no sense creating an empty pool)
+	assignGroups();
+	createDescriptorSetLayouts();
 	create();
 }
 
 Descriptors::~Descriptors()
 {
 	destroy();
-	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
+		if (! groups[iSet].isShared)
+			LayoutCache::ReleaseSetLayout(groups[iSet].layout);
 	Log(DEAD, "Destroyed: Descriptors");
 }
 
 void Descriptors::create()
 {
-	createDescriptorPool();
 	createDescriptorSets();
 }
 
 void Descriptors::destroy()
 {
-	if (descriptorPool != VK_NULL_HANDLE)
-		vkDestroyDescriptorPool(device, descriptorPool, nullptr);	// (note: destroys descriptorSets too)
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet) {
+		SetGroup& group = groups[iSet];
+		writer.Forget(group.sets);					// (in case never yet written)
+		allocator.Free(group.sets, group.pool);		// (back to the shared pool they came from)
+		group.pool = VK_NULL_HANDLE;
+		group.pushInfos.clear();
+	}
 }
 
 
-void Descriptors::createDescriptorSetLayout()
+// Which describers go in which set.  Given FrameConstants, set 0 is its set, so any else described
+//	PER_FRAME binds with the material.  Bindless, set 1 is the device-wide one (see BindlessDescriptors),
+//	so any described PER_MATERIAL (textures aren't, then) are bound per object instead.
+//
+void Descriptors::assignGroups()
 {
-	uint32_t numDescribers = (uint32_t) describers.size();
-	VkDescriptorSetLayoutBinding	layoutBindings[numDescribers];
-
-	for (uint32_t iBind = 0; iBind < numDescribers; ++iBind)
-		layoutBindings[iBind] = {
-			.binding  = iBind,
-			.descriptorType	 = describers[iBind].getDescriptorType(),
-			.descriptorCount = 1,
-			.stageFlags			= describers[iBind].getShaderStageFlags(),
-			.pImmutableSamplers = nullptr
-		};
-
-	VkDescriptorSetLayoutCreateInfo layoutInfo = {
-		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-		.pNext	= nullptr,
-		.flags	= 0,
-		.bindingCount = numDescribers,
-		.pBindings	  = layoutBindings
-	};
-
-	call = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout);
-
-	if (call != VK_SUCCESS)
-		Fatal("Create Descriptor Set Layout FAILURE" + ErrStr(call));
+	if (isByFrequency)
+		numGroups = NUM_DESCRIPTOR_FREQUENCIES;
+	else
+		numGroups = isBindless ? BindlessDescriptors::SET_INDEX + 1 : 1;
+
+	for (SetGroup& group : groups) {
+		group.iDescribers.clear();
+		group.hasDynamicOffset = false;
+	}
+
+	for (uint32_t iDescriber = 0; iDescriber < (uint32_t) describers.size(); ++iDescriber) {
+		uint32_t iSet = 0;
+		if (isByFrequency) {
+			iSet = describers[iDescriber].frequency;
+			if (pFrameConstants && iSet == PER_FRAME)
+				iSet = PER_MATERIAL;
+			if (isBindless && iSet == BindlessDescriptors::SET_INDEX)
+				iSet = PER_OBJECT;
+		}
+		groups[iSet].iDescribers.push_back(iDescriber);
+		if (describers[iDescriber].type == DYNAMIC_BUFFER)
+			groups[iSet].hasDynamicOffset = true;
+	}
 }
 
 
-void Descriptors::createDescriptorPool()
+// Shared with every other Descriptors of the same shape (see LayoutCache).  Every set index below the
+//	highest gets a layout, if only an empty one, as a pipeline layout has no gaps.
+//
+// If PUSH_DESCRIPTORS (and the device has VK_KHR_push_descriptor), the per-object set (the only set,
+//	unless SETS_BY_FREQUENCY) is pushed per draw instead (see DescriptorWriter::CmdPush), its layout so
+//	created, so long as it has no dynamic buffer (which pushing disallows) and few enough bindings.
+//
+void Descriptors::createDescriptorSetLayouts()
 {
-	uint32_t numDescribers = (uint32_t) describers.size();
-	VkDescriptorPoolSize	poolSizes[numDescribers];
-
-	for (int iPool = 0; iPool < numDescribers; ++iPool)
-		poolSizes[iPool] = {
-			.type	= describers[iPool].getDescriptorType(),
-			.descriptorCount  = numBuffers
-		};
-
-	VkDescriptorPoolCreateInfo poolInfo = {
-		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-		.pNext	= nullptr,
-		.flags	= 0,
-		.maxSets	= numBuffers,
-		.poolSizeCount	= numDescribers,
-		.pPoolSizes		= poolSizes
-	};
-
-	call = vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool);
-	if (call != VK_SUCCESS)
-		Fatal("Create Descriptor Pool" + ErrStr(call));
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet) {
+		SetGroup& group = groups[iSet];
+
+		if (pFrameConstants && iSet == PER_FRAME) {
+			group.layout	= pFrameConstants->getSetLayout();
+			group.isShared	= true;
+		} else if (isBindless && iSet == BindlessDescriptors::SET_INDEX) {
+			group.layout	= bindless.getSetLayout();
+			group.sharedSet	= bindless.getSet();
+			group.isShared	= true;
+		} else {
+			uint32_t numBindings = (uint32_t) group.iDescribers.size();
+			vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings);
+
+			for (uint32_t iBind = 0; iBind < numBindings; ++iBind) {
+				DescribEd& describer = describers[group.iDescribers[iBind]];
+				layoutBindings[iBind] = {
+					.binding  = iBind,
+					.descriptorType	 = describer.getDescriptorType(),
+					.descriptorCount = 1,
+					.stageFlags			= describer.getShaderStageFlags(),
+					.pImmutableSamplers = nullptr
+				};
+			}
+			group.isPushed = isPushable && iSet == (isByFrequency ? PER_OBJECT : 0)
+						  && ! group.hasDynamicOffset && numBindings > 0
+						  && numBindings <= DescriptorWriter::MAX_PUSH_DESCRIPTORS;
+			group.layout = LayoutCache::AcquireSetLayout(device, layoutBindings,
+									group.isPushed ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0);
+		}
+		group.layoutKey = LayoutCache::SetLayoutKey(group.layout);
+	}
 }
 
+
+// Contents are written by the (device's) DescriptorWriter, together with all others queued, before
+//	command buffers next record.  (No sense allocating empty sets.)  A pushed set's are simply kept,
+//	to be pushed as each draw is recorded.
+//
 void Descriptors::createDescriptorSets()
 {
-	uint32_t numDescribers = (uint32_t) describers.size();
-	vector<VkDescriptorSetLayout> layouts(numBuffers, descriptorSetLayout);
-	VkDescriptorSetAllocateInfo allocInfo = {
-		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-		.pNext	= nullptr,
-		.descriptorPool		= descriptorPool,
-		.descriptorSetCount	= numBuffers,
-		.pSetLayouts  = layouts.data()
-	};
-	descriptorSets.resize(numBuffers);
-
-	call = vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data());
-	if (call != VK_SUCCESS)
-		Fatal("Allocate Descriptor Sets FAILURE" + ErrStr(call));
-
-	for (int iBuffer = 0; iBuffer < numBuffers; ++iBuffer)
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
 	{
-		VkWriteDescriptorSet descriptorWrite[numDescribers];
-
-		for (uint32_t iBind = 0; iBind < numDescribers; ++iBind) {
-
-			VkDescriptorBufferInfo* pBufferInfo	= nullptr;
-			VkDescriptorImageInfo*	pImageInfo	= nullptr;
-
-			switch (describers[iBind].type) {
-				case DYNAMIC_BUFFER:
-					pBufferInfo = &describers[iBind].bufferInfo;
-					break;
-				case BUFFER:
-					pBufferInfo = &describers[iBind].bufferInfo;
-					break;
-				case TEXTURE:
-					// Check if per-frame image info is provided (for resources that vary per frame)
-					if (describers[iBind].hasPerFrameImageInfo()) {
-						// Use per-frame image info (e.g., shadow maps with frames-in-flight)
-						pImageInfo = &describers[iBind].perFrameImageInfo[iBuffer];
-					} else {
-						// Use single image info (normal case for static textures)
-						pImageInfo = &describers[iBind].imageInfo;
-					}
-					break;
-			}
+		SetGroup& group = groups[iSet];
+		uint32_t numBindings = (uint32_t) group.iDescribers.size();
+		if (group.isShared || numBindings == 0)
+			continue;
+
+		if (! group.isPushed) {
+			vector<VkDescriptorSetLayout> layouts(numBuffers, group.layout);
+
+			allocator.Allocate(layouts, group.sets, group.pool);
+		}
+
+		vector<VkDescriptorType>& types = group.types;
+		types.resize(numBindings);
+		for (uint32_t iBind = 0; iBind < numBindings; ++iBind)
+			types[iBind] = describers[group.iDescribers[iBind]].getDescriptorType();
 
-			descriptorWrite[iBind] = {
-				.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-				.pNext	= nullptr,
-				.dstSet			 = descriptorSets[iBuffer],
-				.dstBinding		 = iBind,
-				.dstArrayElement = 0,
-				.descriptorCount	= 1,
-				.descriptorType		= describers[iBind].getDescriptorType(),
-				.pImageInfo	 		= pImageInfo,
-				.pBufferInfo		= pBufferInfo,
-				.pTexelBufferView	= nullptr
-			};
+		for (int iBuffer = 0; iBuffer < numBuffers; ++iBuffer)
+		{
+			vector<DescriptorInfo> infos(numBindings);
 
+			for (uint32_t iBind = 0; iBind < numBindings; ++iBind) {
+				DescribEd& describer = describers[group.iDescribers[iBind]];
+
+				switch (describer.type) {
+					case DYNAMIC_BUFFER:
+						infos[iBind].buffer = describer.bufferInfo;
+						break;
+					case BUFFER:
+						infos[iBind].buffer = describer.bufferInfo;
+						break;
+					case TEXTURE:
+						// Check if per-frame image info is provided (for resources that vary per frame)
+						if (describer.hasPerFrameImageInfo()) {
+							// Use per-frame image info (e.g., shadow maps with frames-in-flight)
+							infos[iBind].image = describer.perFrameImageInfo[iBuffer];
+						} else {
+							// Use single image info (normal case for static textures)
+							infos[iBind].image = describer.imageInfo;
+						}
+						break;
+				}
+			}
+			if (group.isPushed)
+				group.pushInfos.push_back(std::move(infos));
+			else
+				writer.Write(group.sets[iBuffer], group.layout, types, std::move(infos));
 		}
-		vkUpdateDescriptorSets(device, numDescribers, descriptorWrite, 0, nullptr);
-	}								// ^write descriptor^			   ^copy descriptor^
+	}
 }
 
 
+// The set layouts stay as they were: descriptions are expected to be of the same shape, just new contents.
+//
 void Descriptors::Recreate(vector<DescribEd> descriptions, Swapchain& swapchain)
 {
 	destroy();
 
 	describers = descriptions;	// copy via assignment operator
 	numBuffers = static_cast<uint32_t>(swapchain.getImageViews().size());
+	assignGroups();
 
 	create();
 }
 
 
+#pragma mark - Binding
+
+bool Descriptors::CmdBind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, int iBuffer,
+						  uint32_t dynamicOffset, BoundDescriptorSets* pBound)
+{
+	VkDescriptorSetLayout setLayouts[MAX_DESCRIPTOR_SETS] = {};
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
+		setLayouts[iSet] = groups[iSet].layout;
+
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet) {
+		SetGroup& group = groups[iSet];
+
+		if (group.isPushed) {
+			if (iBuffer < 0 || iBuffer >= (int) group.pushInfos.size()) {
+				Log(ERROR, "DESCRIPTOR OOB: pushed set %d bufferIndex=%d", iSet, iBuffer);
+				return false;
+			}
+			writer.CmdPush(commandBuffer, pipelineLayout, iSet, group.types, group.pushInfos[iBuffer]);
+			if (pBound)
+				pBound->Record(iSet, setLayouts, VK_NULL_HANDLE, 0);	// (never "already bound")
+			continue;
+		}
+
+		VkDescriptorSet set;
+		if (group.isShared)
+			set = group.sharedSet != VK_NULL_HANDLE ? group.sharedSet
+													: pFrameConstants->getSet(iBuffer);	// (as recreated)
+		else {
+			if (group.iDescribers.empty())
+				continue;						// (nothing in it to bind)
+			if (iBuffer < 0 || iBuffer >= (int) group.sets.size()) {
+				Log(ERROR, "DESCRIPTOR OOB: set %d bufferIndex=%d sets.size()=%zu", iSet, iBuffer, group.sets.size());
+				return false;
+			}
+			set = group.sets[iBuffer];
+		}
+		if (set == VK_NULL_HANDLE) {
+			Log(ERROR, "DESCRIPTOR NULL: set %d bufferIndex=%d", iSet, iBuffer);
+			return false;
+		}
+		uint32_t numDynamicOffsets = group.hasDynamicOffset ? 1 : 0;
+		uint32_t offset = group.hasDynamicOffset ? dynamicOffset : 0;
+
+		if (pBound && pBound->IsBound(iSet, setLayouts, set, offset))
+			continue;
+
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+								iSet, 1, &set, numDynamicOffsets, &offset);
+		if (pBound)
+			pBound->Record(iSet, setLayouts, set, offset);
+	}
+	return true;
+}
+
+// Per the "pipeline layout compatibility" rules: a set stays bound across pipeline layouts whose set
+//	layouts (and push constant ranges, here always the same) are identical up to and including it.
+//	Identically defined set layouts are the same handle (see LayoutCache).
+//
+bool BoundDescriptorSets::IsBound(uint32_t iSet, const VkDescriptorSetLayout setLayouts[],
+								  VkDescriptorSet set, uint32_t dynamicOffset)
+{
+	if (sets[iSet] != set || dynamicOffsets[iSet] != dynamicOffset)
+		return false;
+	for (uint32_t iLower = 0; iLower <= iSet; ++iLower)
+		if (layouts[iLower] != setLayouts[iLower])
+			return false;
+	return true;
+}
+
+// Binding at iSet disturbs any lower set bound by a differing layout, and every higher one if the
+//	layouts through iSet differ.  Those are forgotten (while taking on the new layouts).
+//
+void BoundDescriptorSets::Record(uint32_t iSet, const VkDescriptorSetLayout setLayouts[],
+								 VkDescriptorSet set, uint32_t dynamicOffset)
+{
+	bool isCompatible = true;
+	for (uint32_t iLower = 0; iLower < iSet; ++iLower)
+		if (layouts[iLower] != setLayouts[iLower])
+			isCompatible = false;
+
+	if (! isCompatible)
+		for (uint32_t iLower = 0; iLower < iSet; ++iLower) {
+			layouts[iLower] = setLayouts[iLower];
+			sets[iLower]	= VK_NULL_HANDLE;
+		}
+
+	if (! isCompatible || layouts[iSet] != setLayouts[iSet])
+		for (uint32_t iHigher = iSet + 1; iHigher < MAX_DESCRIPTOR_SETS; ++iHigher) {
+			layouts[iHigher] = setLayouts[iHigher];
+			sets[iHigher]	 = VK_NULL_HANDLE;
+		}
+
+	layouts[iSet]		 = setLayouts[iSet];
+	sets[iSet]			 = set;
+	dynamicOffsets[iSet] = dynamicOffset;
+}
+
+
+#pragma mark - getters
+
+vector<VkDescriptorSetLayout> Descriptors::SetLayouts()
+{
+	vector<VkDescriptorSetLayout> setLayouts(numGroups);
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
+		setLayouts[iSet] = groups[iSet].layout;
+	return setLayouts;
+}
+
+uint64_t Descriptors::LayoutKey()
+{
+	uint64_t key = numGroups;
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
+		hashCombine(key, groups[iSet].layoutKey);
+	return key;
+}
+
+bool Descriptors::exist()
+{
+	for (uint32_t iSet = 0; iSet < numGroups; ++iSet)
+		if (! groups[iSet].sets.empty() || ! groups[iSet].pushInfos.empty() || groups[iSet].isShared)
+			return true;
+	return false;
+}
+
+
 /* DEV NOTE
  Pondering VkDescriptorTypes...
  Texture-related
@@ -4,6 +4,8 @@
 //
 // "DESCRIBE" to Vulkan: add-ons like a Uniform Buffer Object or
 //	a Texture Image object.  Descriptors include Pool, Sets, Layout.
+//	(The pool is shared, by DescriptorAllocator, and the layout too, by LayoutCache;
+//	 sets are written in batches, by DescriptorWriter.)
 //
 // Created 6/14/19 by Tadd Jensen
 //	© 0000 (uncopyrighted; use at will)
@@ -13,6 +15,7 @@
 
 #include "BufferBase.h"
 #include "Swapchain.h"
+#include "Customizer.h"
 
 
 enum GeneralVkDescriptorType {
@@ -22,6 +25,19 @@ enum GeneralVkDescriptorType {
 };
 
 
+// How often a descriptor's contents change, hence (customized SETS_BY_FREQUENCY) which set it goes in.
+//	Each is bound only when it changes: a pass's draws share one frame set; draws of the same material,
+//	one material set (or all, bindless); only the object set is bound per draw.
+//
+enum DescriptorFrequency {
+	PER_FRAME,				// layout(set = 0, ...	view/projection, lights, shadow (see FrameConstants)
+	PER_MATERIAL,			// layout(set = 1, ...	textures (or, if BINDLESS, the bindless array)
+	PER_OBJECT,				// layout(set = 2, ...	e.g. model matrix
+	NUM_DESCRIPTOR_FREQUENCIES
+};
+const uint32_t MAX_DESCRIPTOR_SETS = NUM_DESCRIPTOR_FREQUENCIES;
+
+
 struct DescribEd {	// Pronounced "describe-ed" meaning: "the thing being described" - by a Descriptor.
 									// Specifically, these are objects bound (via binding) to a shader.
 	GeneralVkDescriptorType	type;
@@ -30,6 +46,7 @@ struct DescribEd {	// Pronounced "describe-ed" meaning: "the thing being describ
 		VkDescriptorImageInfo  imageInfo;
 	};
 	VkShaderStageFlags		stage;
+	DescriptorFrequency		frequency = PER_OBJECT;		// (only matters if SETS_BY_FREQUENCY)
 
 	// Per-frame image info for resources that vary per swapchain image (e.g., shadow maps with frames-in-flight).
 	// When populated, imageInfo at index iFrame is used instead of single imageInfo above.
@@ -55,10 +72,37 @@ struct DescribEd {	// Pronounced "describe-ed" meaning: "the thing being describ
 
 
 
+// Which set a command buffer last bound at each set index, and with which set layout (that of the
+//	pipeline layout it was bound with), so that draws after the first may skip binding those unchanged.
+//	Reset it after anything binding sets by other means (e.g. vkCmdExecuteCommands).
+//
+struct BoundDescriptorSets {
+	VkDescriptorSetLayout	layouts[MAX_DESCRIPTOR_SETS]		= {};
+	VkDescriptorSet			sets[MAX_DESCRIPTOR_SETS]			= {};
+	uint32_t				dynamicOffsets[MAX_DESCRIPTOR_SETS]	= {};
+
+	// True if set iSet is bound already, by way of identical layouts through iSet (so undisturbed).
+	bool IsBound(uint32_t iSet, const VkDescriptorSetLayout setLayouts[], VkDescriptorSet set, uint32_t dynamicOffset);
+	void Record(uint32_t iSet, const VkDescriptorSetLayout setLayouts[], VkDescriptorSet set, uint32_t dynamicOffset);
+	void Reset()	{ *this = {}; }
+};
+
+
+// Without SETS_BY_FREQUENCY, all described go in one set, at set 0, with bindings numbered in order
+//	(and if BINDLESS, the bindless set follows at set 1).  With it, they are split by their frequency
+//	into up to three sets, at set = frequency, bindings numbered in order within each.  Given the shared
+//	FrameConstants, set 0 is its set instead, and anything else described PER_FRAME (e.g. shadow maps)
+//	goes with the material's set.  With PUSH_DESCRIPTORS, the per-object set isn't allocated but pushed
+//	by each draw (see DescriptorWriter::CmdPush), where the device supports it.
+//
+class FrameConstants;
+
+
 class Descriptors : BufferBase
 {
 public:
-	Descriptors(vector<DescribEd>& describeds, Swapchain& swapchain, GraphicsDevice& device);
+	Descriptors(vector<DescribEd>& describeds, Swapchain& swapchain, GraphicsDevice& device,
+				Customizer customize = NONE, FrameConstants* pFrameConstants = nullptr);
 	~Descriptors();
 
 		// MEMBERS
@@ -67,27 +111,50 @@ private:
 
 	uint32_t				numBuffers;	 // will == numSwapchainImages !
 
-	VkDescriptorPool		descriptorPool;
-	vector<VkDescriptorSet>	descriptorSets;
-
-	VkDescriptorSetLayout	descriptorSetLayout;
+	struct SetGroup {		// Those describers bound at one set index.
+		vector<uint32_t>		iDescribers;
+		VkDescriptorSetLayout	layout	  = VK_NULL_HANDLE;
+		uint64_t				layoutKey = 0;		// (see LayoutCache: equal keys, identical layouts)
+		VkDescriptorPool		pool	  = VK_NULL_HANDLE;	// (shared: the one sets were allocated from)
+		vector<VkDescriptorSet>	sets;				// (per swapchain image; empty if not ours to allocate)
+		VkDescriptorSet			sharedSet = VK_NULL_HANDLE;	// (same for every image, e.g. bindless)
+		bool					isShared = false;	// (layout and sets not ours: bindless or frame constants)
+		bool					isPushed = false;	// (no sets: pushInfos pushed per draw instead)
+		bool					hasDynamicOffset = false;
+		vector<VkDescriptorType>		types;		// (per binding)
+		vector<vector<DescriptorInfo>>	pushInfos;	// (per swapchain image, if isPushed)
+	}	groups[MAX_DESCRIPTOR_SETS];
+	uint32_t				numGroups = 1;
+
+	DescriptorAllocator&	allocator;
+	DescriptorWriter&		writer;
+	BindlessDescriptors&	bindless;
+	FrameConstants*			pFrameConstants;	// (only if SETS_BY_FREQUENCY)
+
+	bool					isByFrequency;
+	bool					isBindless;
+	bool					isPushable;
 
 		// METHODS
 private:
 	void create();
 	void destroy();
-	void createDescriptorSetLayout();
-	void createDescriptorPool();
+	void assignGroups();
+	void createDescriptorSetLayouts();
 	void createDescriptorSets();
 public:
 	void Recreate(vector<DescribEd> descriptions, Swapchain& swapchain);
 
+	// Bind each set at its index (for swapchain image iBuffer), skipping any pBound shows already
+	//	bound, and updating it.  Returns false if a set is missing (so the draw should be skipped).
+	bool CmdBind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, int iBuffer,
+				 uint32_t dynamicOffset, BoundDescriptorSets* pBound = nullptr);
+
 		// getters
-	VkDescriptorSetLayout*		getpLayout()  { return &descriptorSetLayout; }
-	vector<VkDescriptorSet>&	getSets()	  { return descriptorSets;		 }
-	VkDescriptorPool&			getPool()	  { return descriptorPool;		 }
+	vector<VkDescriptorSetLayout>	SetLayouts();	// (in set order, for the pipeline layout)
+	uint64_t	LayoutKey();						// All set layouts' keys, combined.
 
-	bool						exist()		  { return ! descriptorSets.empty(); }
+	bool		exist();
 };
 
 #endif // Descriptors_h
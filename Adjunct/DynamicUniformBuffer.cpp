@@ -45,6 +45,7 @@ void DynamicUniformBuffer::create()
 	uniformBuffers.resize(framesInFlight);
 	uniformBuffersMemory.resize(framesInFlight);
 	mappedMemory.resize(framesInFlight);
+	objectTransforms.resize(maxObjects, mat4(1.0f));
 
 	for (uint32_t i = 0; i < framesInFlight; ++i) {
 		// Use BufferBase's helper method to create the buffer
@@ -99,6 +100,8 @@ void DynamicUniformBuffer::updateObjectTransform(uint32_t frameIndex, uint32_t o
 	objectData->effectFlags = effectFlags;
 	objectData->effectParam = effectParam;
 	objectData->effectParam2 = effectParam2;
+
+	objectTransforms[objectIndex] = modelMatrix;
 }
 
 uint32_t DynamicUniformBuffer::getDynamicOffset(uint32_t objectIndex) const
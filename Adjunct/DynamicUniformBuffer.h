@@ -46,6 +46,10 @@ public:
 	// Get the size per object (aligned)
 	uint32_t getAlignedObjectSize() const { return alignedObjectSize; }
 
+	// CPU-side copy of an object's most recently written model matrix, e.g. for depth sorting or instancing.
+	const mat4& getObjectTransform(uint32_t objectIndex) const { return objectTransforms[objectIndex]; }
+	uint32_t getObjectIndex(uint32_t dynamicOffset) const { return dynamicOffset / alignedObjectSize; }
+
 	// Recreate buffers (e.g., on window resize)
 	void Recreate(uint32_t maxObjects, uint32_t framesInFlight);
 
@@ -59,6 +63,7 @@ private:
 	std::vector<VkBuffer> uniformBuffers;
 	std::vector<VkDeviceMemory> uniformBuffersMemory;
 	std::vector<void*> mappedMemory;
+	std::vector<mat4> objectTransforms;	// Last-written model matrix per object (any frame)
 
 	// Configuration
 	uint32_t maxObjects;
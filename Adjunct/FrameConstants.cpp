@@ -0,0 +1,128 @@
+//
+// FrameConstants.cpp
+//	Vulkan Add-ons
+//
+// See matched header file for definitive main comment.
+//
+// Note that herein:
+//	numBuffers = numSwapchainImages;
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "FrameConstants.h"
+#include "LayoutCache.h"
+
+
+FrameConstants::FrameConstants(Swapchain& swapchain, GraphicsDevice& device)
+	:	BufferBase(device),
+		numBuffers(static_cast<uint32_t>(swapchain.getImageViews().size())),
+		allocator(device.getDescriptorAllocator()),
+		writer(device.getDescriptorWriter())
+{
+	create();
+}
+
+FrameConstants::~FrameConstants()
+{
+	destroy();
+}
+
+void FrameConstants::destroy()
+{
+	destroyPerImage();
+
+	if (setLayout != VK_NULL_HANDLE)
+		LayoutCache::ReleaseSetLayout(setLayout);
+	setLayout = VK_NULL_HANDLE;
+}
+
+// Buffers and sets, which depend on the swapchain image count; not the set layout, which Descriptors
+//	share without a reference of their own, so must outlive a swapchain resize.
+//
+void FrameConstants::destroyPerImage()
+{
+	writer.Forget(descriptorSets);						// (in case never yet written)
+	allocator.Free(descriptorSets, descriptorPool);
+	descriptorPool = VK_NULL_HANDLE;
+
+	for (uint32_t iBuffer = 0; iBuffer < uniformBuffers.size(); ++iBuffer) {
+		vkUnmapMemory(device, uniformBuffersMemory[iBuffer]);
+		vkDestroyBuffer(device, uniformBuffers[iBuffer], nullALLOC);
+		vkFreeMemory(device, uniformBuffersMemory[iBuffer], nullALLOC);
+	}
+	uniformBuffers.clear();
+	uniformBuffersMemory.clear();
+	mappedMemory.clear();
+}
+
+
+void FrameConstants::create()
+{
+	uniformBuffers.resize(numBuffers);
+	uniformBuffersMemory.resize(numBuffers);
+	mappedMemory.resize(numBuffers);
+
+	for (uint32_t iBuffer = 0; iBuffer < numBuffers; ++iBuffer) {
+		createGeneralBuffer(sizeof(UBO_Frame), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+							uniformBuffers[iBuffer], uniformBuffersMemory[iBuffer]);
+
+		call = vkMapMemory(device, uniformBuffersMemory[iBuffer], 0, sizeof(UBO_Frame), 0, &mappedMemory[iBuffer]);
+		if (call != VK_SUCCESS)
+			Fatal("Frame Constants Map Memory FAILURE" + ErrStr(call));
+	}
+
+	vector<VkDescriptorSetLayoutBinding> layoutBindings = {{
+		.binding  = 0,
+		.descriptorType	 = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+		.descriptorCount = 1,
+		.stageFlags			= VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+		.pImmutableSamplers = nullptr
+	}};
+	if (setLayout == VK_NULL_HANDLE)				// (kept by Recreate)
+		setLayout = LayoutCache::AcquireSetLayout(device, layoutBindings);
+
+	createDescriptorSets();
+}
+
+// One set per swapchain image, each reading its own buffer (written by the DescriptorWriter, with all
+//	others queued, before command buffers next record).
+//
+void FrameConstants::createDescriptorSets()
+{
+	vector<VkDescriptorSetLayout> layouts(numBuffers, setLayout);
+
+	allocator.Allocate(layouts, descriptorSets, descriptorPool);
+
+	const vector<VkDescriptorType> types = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER };
+
+	for (uint32_t iBuffer = 0; iBuffer < numBuffers; ++iBuffer) {
+		vector<DescriptorInfo> infos(1);
+		infos[0].buffer = {
+			.buffer	= uniformBuffers[iBuffer],
+			.offset	= 0,
+			.range	= sizeof(UBO_Frame)
+		};
+		writer.Write(descriptorSets[iBuffer], setLayout, types, std::move(infos));
+	}
+}
+
+
+void FrameConstants::Recreate(Swapchain& swapchain)
+{
+	destroyPerImage();
+
+	numBuffers = static_cast<uint32_t>(swapchain.getImageViews().size());
+
+	create();
+}
+
+
+void FrameConstants::Update(int iNextImage)
+{
+	if (iNextImage < 0 || iNextImage >= (int) mappedMemory.size())
+		return;
+
+	memcpy(mappedMemory[iNextImage], &frame, sizeof(UBO_Frame));
+}
@@ -0,0 +1,68 @@
+//
+// FrameConstants.h
+//	Vulkan Add-ons
+//
+// What every renderable sees alike in a frame: camera view/projection, light and shadow matrix (UBO_Frame),
+//	held in one uniform buffer per swapchain image and written once per frame (Update), rather than each
+//	renderable carrying its own UBO(UBO_VP&), UBO(UBO_Light&) and UBO(UBO_Shadow&), so uploading the same
+//	matrices N times.  Renderables customized SETS_BY_FREQUENCY bind its descriptor set as their set 0
+//	(see Descriptors), one set shared by all, so RenderBatch binds it once per pass; their own UBOs then
+//	need hold only what is per object, e.g. UBO(mat4& model):
+//		layout(set = 0, binding = 0) uniform Frame { ... } frame;		// (see UBO_Frame)
+//		layout(set = 2, binding = 0) uniform Object { mat4 model; } object;
+//
+// Owned by VulkanSetup and recreated with the swapchain.  Its set layout is LayoutCache's, so a
+//	renderable describing an identical UBO in its own set 0 would still share pipeline layouts.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef FrameConstants_h
+#define FrameConstants_h
+
+#include "BufferBase.h"
+#include "Swapchain.h"
+#include "UniformBufferLiterals.h"
+
+
+class FrameConstants : BufferBase
+{
+public:
+	FrameConstants(Swapchain& swapchain, GraphicsDevice& device);
+	~FrameConstants();
+
+		// MEMBERS
+public:
+	UBO_Frame				frame;		// App writes this, then calls Update, each frame.
+private:
+	uint32_t				numBuffers;	 // will == numSwapchainImages !
+
+	vector<VkBuffer>		uniformBuffers;
+	vector<VkDeviceMemory>	uniformBuffersMemory;
+	vector<void*>			mappedMemory;		// (persistently)
+
+	VkDescriptorSetLayout	setLayout = VK_NULL_HANDLE;
+	VkDescriptorPool		descriptorPool = VK_NULL_HANDLE;	// (shared: see DescriptorAllocator)
+	vector<VkDescriptorSet>	descriptorSets;
+	DescriptorAllocator&	allocator;
+	DescriptorWriter&		writer;
+
+		// METHODS
+private:
+	void create();
+	void createDescriptorSets();
+	void destroyPerImage();
+public:
+	void destroy();		// Public for device-loss teardown (old device); idempotent.
+	void Recreate(Swapchain& swapchain);		// (keeping setLayout: groups of Descriptors share it)
+
+	void Update(int iNextImage);		// Copy `frame` into the buffer swapchain image iNextImage reads.
+
+		// getters
+	VkDescriptorSetLayout	getSetLayout()	{ return setLayout; }
+	VkDescriptorSet			getSet(int iBuffer) {
+		return iBuffer >= 0 && iBuffer < (int) descriptorSets.size() ? descriptorSets[iBuffer] : VK_NULL_HANDLE;
+	}
+};
+
+#endif // FrameConstants_h
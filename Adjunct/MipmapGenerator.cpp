@@ -0,0 +1,498 @@
+//
+// MipmapGenerator.cpp
+//	Vulkan Add-ons
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "MipmapGenerator.h"
+#include <algorithm>
+
+
+// How an image's levels are being accessed, on either side of a barrier.
+//
+struct LevelAccess {
+	VkPipelineStageFlags2KHR	stage;
+	VkAccessFlags2KHR			access;
+	VkImageLayout				layout;
+};
+
+const LevelAccess WrittenByTransfer	= { VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR,
+										VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
+const LevelAccess ReadByTransfer	= { VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_READ_BIT_KHR,
+										VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL };
+const LevelAccess UsedByCompute		= { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR,
+										VK_ACCESS_2_SHADER_READ_BIT_KHR | VK_ACCESS_2_SHADER_WRITE_BIT_KHR,
+										VK_IMAGE_LAYOUT_GENERAL };
+const LevelAccess SampledToDraw		= { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR,
+										VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+static VkImageMemoryBarrier2KHR transition(VkImage image, uint32_t iBaseLevel, uint32_t numLevels,
+										   const LevelAccess& from, const LevelAccess& to)
+{
+	return {
+		.sType	= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
+		.pNext	= nullptr,
+		.srcStageMask	= from.stage,
+		.srcAccessMask	= from.access,
+		.dstStageMask	= to.stage,
+		.dstAccessMask	= to.access,
+		.oldLayout	= from.layout,
+		.newLayout	= to.layout,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image	= image,
+		.subresourceRange = {
+			.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+			.baseMipLevel	= iBaseLevel,
+			.levelCount		= numLevels,
+			.baseArrayLayer	= 0,
+			.layerCount		= 1
+		}
+	};
+}
+
+static int32_t levelSize(int32_t size, uint32_t iLevel)
+{
+	return std::max(size >> iLevel, 1);
+}
+
+static uint32_t groupsFor(int32_t texels)
+{
+	return (texels + MipmapGenerator::GROUP_SIZE - 1) / MipmapGenerator::GROUP_SIZE;
+}
+
+
+MipmapGenerator::MipmapGenerator(GraphicsDevice& graphics)
+	:	graphicsDevice(graphics),
+		device(graphics.getLogical())
+{
+	Recreate();
+}
+
+MipmapGenerator::~MipmapGenerator()
+{
+	destroy();
+}
+
+void MipmapGenerator::destroy()
+{
+	if (pipeline != VK_NULL_HANDLE) {
+		vkDestroyPipeline(device, pipeline, nullALLOC);
+		vkDestroyPipelineLayout(device, pipelineLayout, nullALLOC);
+		vkDestroyDescriptorSetLayout(device, setLayout, nullALLOC);
+		vkDestroySampler(device, sampler, nullALLOC);
+		Log(DEAD, "Destroyed: MipmapGenerator (compute downsampler)");
+	}
+	pipeline	   = VK_NULL_HANDLE;
+	pipelineLayout = VK_NULL_HANDLE;
+	setLayout	   = VK_NULL_HANDLE;
+	sampler		   = VK_NULL_HANDLE;
+}
+
+void MipmapGenerator::Recreate()
+{
+	destroy();
+
+	cmdPipelineBarrier2 = nullptr;
+	if (graphicsDevice.hasSynchronization2())
+		cmdPipelineBarrier2 = (PFN_vkCmdPipelineBarrier2KHR)
+							   vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2KHR");
+}
+
+void MipmapGenerator::SetComputeDownsampler(ShaderModules& shader)
+{
+	destroy();						// (any pipeline of another shader: recreated at next use)
+	pDownsampleShader = &shader;
+}
+
+// Blit if the format can be, as Mipmaps requires; else by compute, if it can be written as storage
+//	(and sampled) and a downsampler is set; else not at all.
+//
+MipmapGenerator::Method MipmapGenerator::MethodFor(VkFormat format)
+{
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties(graphicsDevice.getGPU(), format, &formatProperties);
+
+	VkFormatFeatureFlags features = formatProperties.optimalTilingFeatures;
+
+	const VkFormatFeatureFlags BLITTABLE = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT
+										 | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	const VkFormatFeatureFlags DOWNSAMPLABLE = VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+	if ((features & BLITTABLE) == BLITTABLE)
+		return BLIT;
+	if ((features & DOWNSAMPLABLE) == DOWNSAMPLABLE && pDownsampleShader
+	 && graphicsDevice.writesStorageWithoutFormat())
+		return COMPUTE;
+	return UNSUPPORTED;
+}
+
+
+// Per level (1 onward), one barrier batch then every target's blit or dispatch of that level:
+//	  blitted - level above it TRANSFER_DST -> _SRC (the level itself is already TRANSFER_DST);
+//	  by compute - before level 1, all levels TRANSFER_DST -> GENERAL; thereafter, the level above
+//		it made visible (written by the previous dispatch).
+//	Then one batch to SHADER_READ_ONLY for all, including those UNSUPPORTED, skipped until then.
+//
+void MipmapGenerator::Record(VkCommandBuffer commandBuffer, const vector<Target>& targets, Scratch& scratch)
+{
+	vector<Method> methods;
+	uint32_t maxLevels = 1;
+	for (const Target& target : targets) {
+		methods.push_back(target.numLevels > 1 ? MethodFor(target.format) : BLIT);
+		if (methods.back() == UNSUPPORTED)
+			Log(WARN, "Texture image format %s supports neither linear blitting, nor compute downsampling"
+					  " (see MipmapGenerator): mipmaps not generated.", AltVkFormatString(target.format));
+		maxLevels = std::max(maxLevels, target.numLevels);
+	}
+
+	vector<VkDescriptorSet> sets;
+	vector<uint32_t>		iFirstSets;		// (per target, its level 1's)
+	if (std::find(methods.begin(), methods.end(), COMPUTE) != methods.end())
+		prepareDownsamples(targets, methods, scratch, sets, iFirstSets);
+
+	vector<VkImageMemoryBarrier2KHR> barriers;
+	barriers.reserve(targets.size() * 2);
+
+	for (uint32_t iLevel = 1; iLevel < maxLevels; ++iLevel) {
+		barriers.clear();
+		for (uint32_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+			const Target& target = targets[iTarget];
+			if (iLevel >= target.numLevels || methods[iTarget] == UNSUPPORTED)
+				continue;
+			if (methods[iTarget] == BLIT)
+				barriers.push_back(transition(target.image, iLevel - 1, 1, WrittenByTransfer, ReadByTransfer));
+			else if (iLevel == 1)
+				barriers.push_back(transition(target.image, 0, target.numLevels, WrittenByTransfer, UsedByCompute));
+			else
+				barriers.push_back(transition(target.image, iLevel - 1, 1, UsedByCompute, UsedByCompute));
+		}
+		cmdBarriers(commandBuffer, barriers);
+
+		bool isBound = false;
+		for (uint32_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+			const Target& target = targets[iTarget];
+			if (iLevel >= target.numLevels || methods[iTarget] == UNSUPPORTED)
+				continue;
+			if (methods[iTarget] == BLIT)
+				cmdBlit(commandBuffer, target, iLevel);
+			else {
+				if (! isBound)
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+				isBound = true;
+				cmdDownsample(commandBuffer, target, iLevel, sets[iFirstSets[iTarget] + iLevel - 1]);
+			}
+		}
+	}
+
+	barriers.clear();
+	for (uint32_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+		const Target& target = targets[iTarget];
+		uint32_t iLast = target.numLevels - 1;
+		if (methods[iTarget] == COMPUTE)
+			barriers.push_back(transition(target.image, 0, target.numLevels, UsedByCompute, SampledToDraw));
+		else if (methods[iTarget] == UNSUPPORTED)
+			barriers.push_back(transition(target.image, 0, target.numLevels, WrittenByTransfer, SampledToDraw));
+		else {
+			if (iLast > 0)
+				barriers.push_back(transition(target.image, 0, iLast, ReadByTransfer, SampledToDraw));
+			barriers.push_back(transition(target.image, iLast, 1, WrittenByTransfer, SampledToDraw));
+		}
+	}
+	cmdBarriers(commandBuffer, barriers);
+}
+
+void MipmapGenerator::Release(Scratch& scratch)
+{
+	for (VkImageView& view : scratch.views)
+		vkDestroyImageView(device, view, nullALLOC);
+	scratch.views.clear();
+
+	if (scratch.pool != VK_NULL_HANDLE)
+		vkDestroyDescriptorPool(device, scratch.pool, nullALLOC);	// (freeing its sets)
+	scratch.pool = VK_NULL_HANDLE;
+}
+
+// Through vkCmdPipelineBarrier2KHR if available, else all at once between the union of their stages.
+//	(Each legacy stage or access bit has the value of its "2" equivalent, which is all used here.)
+//
+void MipmapGenerator::cmdBarriers(VkCommandBuffer commandBuffer, const vector<VkImageMemoryBarrier2KHR>& barriers)
+{
+	if (barriers.empty())
+		return;
+
+	if (cmdPipelineBarrier2) {
+		VkDependencyInfoKHR dependencyInfo = {
+			.sType	= VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR,
+			.pNext	= nullptr,
+			.dependencyFlags = 0,
+			.memoryBarrierCount			= 0,
+			.pMemoryBarriers			= nullptr,
+			.bufferMemoryBarrierCount	= 0,
+			.pBufferMemoryBarriers		= nullptr,
+			.imageMemoryBarrierCount	= (uint32_t) barriers.size(),
+			.pImageMemoryBarriers		= barriers.data()
+		};
+		cmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+		return;
+	}
+
+	VkPipelineStageFlags sourceStages = 0, destinationStages = 0;
+	vector<VkImageMemoryBarrier> legacyBarriers;
+	legacyBarriers.reserve(barriers.size());
+
+	for (const VkImageMemoryBarrier2KHR& barrier : barriers) {
+		sourceStages	  |= (VkPipelineStageFlags) barrier.srcStageMask;
+		destinationStages |= (VkPipelineStageFlags) barrier.dstStageMask;
+		legacyBarriers.push_back({
+			.sType	= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.pNext	= nullptr,
+			.srcAccessMask	= (VkAccessFlags) barrier.srcAccessMask,
+			.dstAccessMask	= (VkAccessFlags) barrier.dstAccessMask,
+			.oldLayout	= barrier.oldLayout,
+			.newLayout	= barrier.newLayout,
+			.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex,
+			.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex,
+			.image	= barrier.image,
+			.subresourceRange = barrier.subresourceRange
+		});
+	}
+
+	vkCmdPipelineBarrier(commandBuffer, sourceStages, destinationStages, 0,
+						 0, nullptr,
+						 0, nullptr,
+						 (uint32_t) legacyBarriers.size(), legacyBarriers.data());
+}
+
+
+#pragma mark - Blit
+
+void MipmapGenerator::cmdBlit(VkCommandBuffer commandBuffer, const Target& target, uint32_t iLevel)
+{
+	VkImageBlit blit = {
+		.srcSubresource = {
+			.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+			.mipLevel		= iLevel - 1,
+			.baseArrayLayer	= 0,
+			.layerCount		= 1
+		},
+		.srcOffsets =	{	{ 0, 0, 0 },
+							{ levelSize(target.wide, iLevel - 1), levelSize(target.high, iLevel - 1), 1 }
+						},
+		.dstSubresource = {
+			.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+			.mipLevel		= iLevel,
+			.baseArrayLayer	= 0,
+			.layerCount		= 1
+		},
+		.dstOffsets =	{	{ 0, 0, 0 },
+							{ levelSize(target.wide, iLevel), levelSize(target.high, iLevel), 1 }
+						}
+	};
+
+	vkCmdBlitImage(commandBuffer,
+				   target.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				   target.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				   1, &blit,
+				   VK_FILTER_LINEAR);
+}
+
+
+#pragma mark - Compute
+
+// Sampler, set layout, pipeline layout and pipeline, once a downsample is first recorded.
+//	(Texels are only ever fetched whole, never filtered.)
+//
+void MipmapGenerator::obtainPipeline()
+{
+	if (pipeline != VK_NULL_HANDLE)
+		return;
+
+	VkSamplerCreateInfo samplerInfo = {
+		.sType	= VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.magFilter	= VK_FILTER_NEAREST,
+		.minFilter	= VK_FILTER_NEAREST,
+		.mipmapMode	= VK_SAMPLER_MIPMAP_MODE_NEAREST,
+		.addressModeU	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.addressModeV	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.addressModeW	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.mipLodBias		= 0.0f,
+		.anisotropyEnable	= VK_FALSE,
+		.maxAnisotropy		= 1.0f,
+		.compareEnable		= VK_FALSE,
+		.compareOp			= VK_COMPARE_OP_ALWAYS,
+		.minLod	= 0.0f,
+		.maxLod	= 0.0f,
+		.borderColor	= VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK,
+		.unnormalizedCoordinates = VK_FALSE
+	};
+	call = vkCreateSampler(device, &samplerInfo, nullALLOC, &sampler);
+	if (call != VK_SUCCESS)
+		Fatal("Create Sampler for mipmap downsampling FAILURE" + ErrStr(call));
+
+	VkDescriptorSetLayoutBinding bindings[] = {
+		{ 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+		{ 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,		   1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+	};
+	VkDescriptorSetLayoutCreateInfo setLayoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.bindingCount	= N_ELEMENTS_IN_ARRAY(bindings),
+		.pBindings		= bindings
+	};
+	call = vkCreateDescriptorSetLayout(device, &setLayoutInfo, nullALLOC, &setLayout);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Set Layout for mipmap downsampling FAILURE" + ErrStr(call));
+
+	VkPushConstantRange pushRange = { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants) };
+
+	VkPipelineLayoutCreateInfo layoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.setLayoutCount			= 1,
+		.pSetLayouts			= &setLayout,
+		.pushConstantRangeCount	= 1,
+		.pPushConstantRanges	= &pushRange
+	};
+	call = vkCreatePipelineLayout(device, &layoutInfo, nullALLOC, &pipelineLayout);
+	if (call != VK_SUCCESS)
+		Fatal("Create Pipeline Layout for mipmap downsampling FAILURE" + ErrStr(call));
+
+	VkComputePipelineCreateInfo pipelineInfo = {
+		.sType	= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.stage	= *pDownsampleShader->ShaderStages(),
+		.layout	= pipelineLayout,
+		.basePipelineHandle	= VK_NULL_HANDLE,
+		.basePipelineIndex	= -1
+	};
+	call = vkCreateComputePipelines(device, graphicsDevice.getPipelineCache().getVkPipelineCache(),
+									1, &pipelineInfo, nullALLOC, &pipeline);
+	if (call != VK_SUCCESS)
+		Fatal("Create Compute Pipeline for mipmap downsampling FAILURE" + ErrStr(call));
+}
+
+// For each target downsampled by compute, a view of every level, and a set for every level but 0
+//	reading the level above it and writing it; all in `scratch`, but for the sets, freed with its pool.
+//
+void MipmapGenerator::prepareDownsamples(const vector<Target>& targets, const vector<Method>& methods,
+										 Scratch& scratch, vector<VkDescriptorSet>& sets, vector<uint32_t>& iFirstSets)
+{
+	obtainPipeline();
+
+	uint32_t nSets = 0;
+	iFirstSets.assign(targets.size(), 0);
+	for (uint32_t iTarget = 0; iTarget < targets.size(); ++iTarget)
+		if (methods[iTarget] == COMPUTE) {
+			iFirstSets[iTarget] = nSets;
+			nSets += targets[iTarget].numLevels - 1;
+		}
+
+	VkDescriptorPoolSize poolSizes[] = {
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, nSets },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, nSets }
+	};
+	VkDescriptorPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.maxSets		= nSets,
+		.poolSizeCount	= N_ELEMENTS_IN_ARRAY(poolSizes),
+		.pPoolSizes		= poolSizes
+	};
+	call = vkCreateDescriptorPool(device, &poolInfo, nullALLOC, &scratch.pool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Pool for mipmap downsampling FAILURE" + ErrStr(call));
+
+	vector<VkDescriptorSetLayout> setLayouts(nSets, setLayout);
+	VkDescriptorSetAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.descriptorPool		= scratch.pool,
+		.descriptorSetCount	= nSets,
+		.pSetLayouts		= setLayouts.data()
+	};
+	sets.resize(nSets);
+	call = vkAllocateDescriptorSets(device, &allocInfo, sets.data());
+	if (call != VK_SUCCESS)
+		Fatal("Allocate Descriptor Sets for mipmap downsampling FAILURE" + ErrStr(call));
+
+	vector<VkWriteDescriptorSet>	writes;
+	vector<VkDescriptorImageInfo>	imageInfos(nSets * 2);		// (reserved: written pointers must stay put)
+
+	for (uint32_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+		if (methods[iTarget] != COMPUTE)
+			continue;
+		const Target& target = targets[iTarget];
+
+		size_t iFirstView = scratch.views.size();
+		for (uint32_t iLevel = 0; iLevel < target.numLevels; ++iLevel) {
+			VkImageViewCreateInfo viewInfo = {
+				.sType	= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+				.pNext	= nullptr,
+				.flags	= 0,
+				.image		= target.image,
+				.viewType	= VK_IMAGE_VIEW_TYPE_2D,
+				.format		= target.format,
+				.components = { .r = VK_COMPONENT_SWIZZLE_IDENTITY, .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+								.b = VK_COMPONENT_SWIZZLE_IDENTITY, .a = VK_COMPONENT_SWIZZLE_IDENTITY },
+				.subresourceRange = {
+					.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+					.baseMipLevel	= iLevel,
+					.levelCount		= 1,
+					.baseArrayLayer = 0,
+					.layerCount		= 1
+				}
+			};
+			scratch.views.emplace_back();
+			call = vkCreateImageView(device, &viewInfo, nullALLOC, &scratch.views.back());
+			if (call != VK_SUCCESS)
+				Fatal("Create Image View for mipmap level FAILURE" + ErrStr(call));
+		}
+
+		for (uint32_t iLevel = 1; iLevel < target.numLevels; ++iLevel) {
+			uint32_t iSet = iFirstSets[iTarget] + iLevel - 1;
+			VkDescriptorImageInfo* pSource = &imageInfos[iSet * 2];
+			VkDescriptorImageInfo* pTarget = &imageInfos[iSet * 2 + 1];
+			*pSource = { sampler, scratch.views[iFirstView + iLevel - 1], VK_IMAGE_LAYOUT_GENERAL };
+			*pTarget = { VK_NULL_HANDLE, scratch.views[iFirstView + iLevel], VK_IMAGE_LAYOUT_GENERAL };
+
+			for (uint32_t iBind = 0; iBind < 2; ++iBind)
+				writes.push_back({
+					.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+					.pNext	= nullptr,
+					.dstSet				= sets[iSet],
+					.dstBinding			= iBind,
+					.dstArrayElement	= 0,
+					.descriptorCount	= 1,
+					.descriptorType		= iBind == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+													 : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+					.pImageInfo			= iBind == 0 ? pSource : pTarget,
+					.pBufferInfo		= nullptr,
+					.pTexelBufferView	= nullptr
+				});
+		}
+	}
+	vkUpdateDescriptorSets(device, (uint32_t) writes.size(), writes.data(), 0, nullptr);
+}
+
+void MipmapGenerator::cmdDownsample(VkCommandBuffer commandBuffer, const Target& target, uint32_t iLevel,
+									VkDescriptorSet set)
+{
+	PushConstants constants = {
+		.sourceSize = { levelSize(target.wide, iLevel - 1), levelSize(target.high, iLevel - 1) },
+		.targetSize = { levelSize(target.wide, iLevel),		levelSize(target.high, iLevel) }
+	};
+
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &set, 0, nullptr);
+	vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+	vkCmdDispatch(commandBuffer, groupsFor(constants.targetSize[0]), groupsFor(constants.targetSize[1]), 1);
+}
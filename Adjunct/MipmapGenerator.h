@@ -0,0 +1,96 @@
+//
+// MipmapGenerator.h
+//	Vulkan Add-ons
+//
+// Generate the mipmaps of many textures at once, into one command buffer (e.g. TextureLoader's, in the
+//	same submission as their uploads): level by level, every image's blit from the level above it,
+//	behind one barrier batch per level shared by them all, and at the end one batch making every image
+//	shader-readable.  Versus Mipmaps::Generate per texture: a single-submit command buffer each,
+//	barriers image by image, waited idle.  With VK_KHR_synchronization2, each barrier carries its own
+//	stages (vkCmdPipelineBarrier2KHR); without, a batch's stages are merged into one vkCmdPipelineBarrier.
+//
+// A format the device can't linearly blit (see MethodFor) may instead be downsampled by compute, if the
+//	app supplies the shader (SetComputeDownsampler), e.g. MipDownsample.comp (see TestHarness/src/shaders)
+//	taking the descriptors and push constants laid out below.  Its levels are dispatched in the same
+//	passes, behind the same barriers, as other images' blits.  Such an image needs STORAGE usage, and
+//	its format storage support, plus the device's shaderStorageImageWriteWithoutFormat; float or
+//	normalized formats only (sampled as sampler2D).
+//
+// Owned by TextureLoader.  Use from the main thread.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef MipmapGenerator_h
+#define MipmapGenerator_h
+
+#include "GraphicsDevice.h"
+#include "ShaderModules.h"
+
+
+class MipmapGenerator
+{
+public:
+	MipmapGenerator(GraphicsDevice& graphics);
+	~MipmapGenerator();
+
+	static constexpr uint32_t GROUP_SIZE = 8;		// (8 x 8 threads per workgroup, the shader's local_size)
+
+	struct PushConstants {
+		int32_t		sourceSize[2];		// texels of the level read
+		int32_t		targetSize[2];		// texels of the level written
+	};
+
+	enum Method {
+		BLIT,
+		COMPUTE,
+		UNSUPPORTED
+	};
+
+	struct Target {						// Level 0 written, every level in TRANSFER_DST_OPTIMAL.
+		VkImage		image;
+		VkFormat	format;
+		int32_t		wide, high;
+		uint32_t	numLevels;
+	};
+
+	struct Scratch {					// What a recording downsampling by compute refers to:
+		vector<VkImageView>	views;		//	keep until its command buffer has executed, then Release.
+		VkDescriptorPool	pool = VK_NULL_HANDLE;
+	};
+
+		// MEMBERS
+private:
+	GraphicsDevice&	graphicsDevice;
+	VkDevice&		device;
+
+	PFN_vkCmdPipelineBarrier2KHR	cmdPipelineBarrier2 = nullptr;
+
+	ShaderModules*			pDownsampleShader = nullptr;
+	VkSampler				sampler			= VK_NULL_HANDLE;
+	VkDescriptorSetLayout	setLayout		= VK_NULL_HANDLE;	// (0: source sampler2D, 1: target image2D)
+	VkPipelineLayout		pipelineLayout	= VK_NULL_HANDLE;
+	VkPipeline				pipeline		= VK_NULL_HANDLE;	// (created at first use)
+
+		// METHODS
+public:
+	void	SetComputeDownsampler(ShaderModules& shader);		// (which must outlive its use)
+	Method	MethodFor(VkFormat format);
+
+	// Generate every level but 0 of each target, leaving all levels SHADER_READ_ONLY_OPTIMAL.  (One whose
+	//	format is UNSUPPORTED is only transitioned, levels but 0 left undefined, and warned of.)
+	void	Record(VkCommandBuffer commandBuffer, const vector<Target>& targets, Scratch& scratch);
+	void	Release(Scratch& scratch);
+
+	void	destroy();			// Public for device-loss teardown (old device); idempotent.
+	void	Recreate();
+private:
+	void	obtainPipeline();
+	void	prepareDownsamples(const vector<Target>& targets, const vector<Method>& methods,
+							   Scratch& scratch, vector<VkDescriptorSet>& sets, vector<uint32_t>& iFirstSets);
+	void	cmdBlit(VkCommandBuffer commandBuffer, const Target& target, uint32_t iLevel);
+	void	cmdDownsample(VkCommandBuffer commandBuffer, const Target& target, uint32_t iLevel, VkDescriptorSet set);
+	void	cmdBarriers(VkCommandBuffer commandBuffer, const vector<VkImageMemoryBarrier2KHR>& barriers);
+};
+
+#endif	// MipmapGenerator_h
@@ -34,6 +34,12 @@ public:
 		return numLevels;
 	}
 
+	uint32_t SetNumberOfLevels(uint32_t levels)		// (e.g. as many as were pre-baked)
+	{
+		numLevels = levels;
+		return numLevels;
+	}
+
 	uint32_t NumLevels()	{ return numLevels; }
 
 
@@ -172,7 +172,8 @@ void PrimitiveBuffer::createDeviceLocalBuffer(void* pSourceData, VkDeviceSize si
 	memcpy(pData, pSourceData, (size_t) size);						// fill the main RAM block
 	vkUnmapMemory(device, cpuSideBufferMemory);						//	that Vulkan provided
 
-	createGeneralBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+	createGeneralBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+								| VK_BUFFER_USAGE_TRANSFER_SRC_BIT,		// (for Holds)
 						VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 						deviceBuffer, specificMemory);
 
@@ -218,6 +219,50 @@ void PrimitiveBuffer::UpdateIndexBufferMapped(void* pNewIndexData, VkDeviceSize
 	vkUnmapMemory(device, bufferMemory);
 }
 
+// Whether the (device-local) buffer's first size bytes equal the given data, by copying them back to
+//	a CPU-side buffer to compare.  Slow, so reserved for the rare need, e.g. confirming a hash match.
+//
+bool PrimitiveBuffer::Holds(const void* pData, VkDeviceSize size)
+{
+	VkBuffer cpuSideBuffer;
+	VkDeviceMemory cpuSideBufferMemory = 0;
+	createGeneralBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+						VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						cpuSideBuffer, cpuSideBufferMemory);
+
+	VkCommandBuffer commands = beginSingleSubmitCommands();
+
+		VkBufferCopy copyRegion = {
+			.srcOffset	= 0,
+			.dstOffset	= 0,
+			.size		= size
+		};
+		vkCmdCopyBuffer(commands, buffer, cpuSideBuffer, 1, &copyRegion);
+
+		VkMemoryBarrier toHost = {		// (make the copy visible to the host's read below)
+			.sType	= VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext	= nullptr,
+			.srcAccessMask	= VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask	= VK_ACCESS_HOST_READ_BIT
+		};
+		vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+							 1, &toHost, 0, nullptr, 0, nullptr);
+
+	endAndSubmitCommands(commands);
+
+	void* pHeld;
+	call = vkMapMemory(device, cpuSideBufferMemory, 0, size, 0, &pHeld);
+	if (call != VK_SUCCESS)
+		Fatal("Primitive Buffer Map Memory FAILURE" + ErrStr(call));
+
+	bool isSame = memcmp(pHeld, pData, (size_t) size) == 0;
+	vkUnmapMemory(device, cpuSideBufferMemory);
+
+	vkDestroyBuffer(device, cpuSideBuffer, nullALLOC);
+	vkFreeMemory(device, cpuSideBufferMemory, nullALLOC);
+	return isSame;
+}
+
 void PrimitiveBuffer::copyBufferViaVulkan(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
 {
 	VkCommandBuffer commands = beginSingleSubmitCommands();
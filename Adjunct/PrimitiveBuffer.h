@@ -46,6 +46,7 @@ public:
 	void	 UpdateVertexBuffer(void* pNewVertexData, VkDeviceSize size);		// Update existing vertex buffer, only for host-visible buffers.
 	void	 UpdateVertexBufferMapped(void* pNewVertexData, VkDeviceSize size);	// Fast update for host-visible buffers, no command buffers.
 	void	 UpdateIndexBufferMapped(void* pNewIndexData, VkDeviceSize size);	// Fast update for host-visible index buffers, no command buffers.
+	bool	 Holds(const void* pData, VkDeviceSize size);		// Read back (device-local) buffer, compare to given data.
 private:
 	void	 createDeviceLocalBuffer(void* pSourceData, VkDeviceSize size, VkBufferUsageFlags usage,
 									 VkBuffer& deviceBuffer, VkDeviceMemory& deviceMemory);
@@ -14,11 +14,13 @@
 
 #include "PrimitiveBuffer.h"
 #include "Customizer.h"
+#include "Helpers.h"
 
 
 AddOns::AddOns(DrawableSpecifier& drawable, VulkanSetup& setup, iPlatform& abstractPlatform)
 	:	vulkan(setup),
-		platform(abstractPlatform)
+		platform(abstractPlatform),
+		isBindless((drawable.customize & BINDLESS) && setup.device.getBindless().IsEnabled())
 {
 	createVertexAndOrIndexBuffers(drawable.mesh, drawable.customize);
 	createDescribedItems(drawable.pUBOs, drawable.textures, drawable.runtimeTextures,
@@ -47,36 +49,86 @@ void AddOns::createVertexAndOrIndexBuffers(MeshObject& meshObject, Customizer cu
 			VkDeviceSize bufferSize = meshObject.vertexBufferSize();
 			pVertexBuffer->CreateVertexBuffer(meshObject.vertices, bufferSize, true);  // hostVisible = true
 		} else {	// Create standard device-local vertex buffer: best GPU performance, uses staging for updates.
-			pVertexBuffer = new PrimitiveBuffer(meshObject, commandPool, vulkan.device);
+			if (! meshObject.hasBounds)		// (static, so its extent won't change; e.g. for occlusion culling)
+				meshObject.computeBounds();
+			auto create = [&] { return new PrimitiveBuffer(meshObject, commandPool, vulkan.device); };
+			pVertexBuffer = sharedPrimitive(vertexSource, meshObject.vertices, meshObject.vertexBufferSize(), create);
 		}
 
 		if (meshObject.indices) {
 			if (isDynamic) {	// Create host-visible index buffer for dynamic geometry
 				pIndexBuffer = new PrimitiveBuffer(commandPool, vulkan.device);
-				VkDeviceSize indexBufferSize = meshObject.indexCount *
-					(meshObject.indexType == MeshDefaultIndexType ? sizeof(IndexBufferDefaultIndexType) : sizeof(uint32_t));
+				VkDeviceSize indexBufferSize = meshObject.indexBufferSize();		// (all LODs)
 				pIndexBuffer->CreateIndexBuffer(meshObject.indices, indexBufferSize, meshObject.indexType, true); // ← hostVisible = true
 			} else {	// Create standard device-local index buffer
-				if (meshObject.indexType == MeshDefaultIndexType) {
-					pIndexBuffer = new PrimitiveBuffer((IndexBufferDefaultIndexType*) meshObject.indices,
-													   meshObject.indexCount,
-													   commandPool, vulkan.device);
-				} else {
-					pIndexBuffer = new PrimitiveBuffer(meshObject.indexType, meshObject.indices, meshObject.indexCount,
-													   commandPool, vulkan.device);
-				}
+				auto create = [&] {
+					if (meshObject.indexType == MeshDefaultIndexType)
+						return new PrimitiveBuffer((IndexBufferDefaultIndexType*) meshObject.indices,
+												   meshObject.indicesStored(),		// (all LODs)
+												   commandPool, vulkan.device);
+					return new PrimitiveBuffer(meshObject.indexType, meshObject.indices, meshObject.indicesStored(),
+											   commandPool, vulkan.device);
+				};
+				pIndexBuffer = sharedPrimitive(indexSource, meshObject.indices, meshObject.indexBufferSize(), create);
 			}
 		}
 	}
+
+	// Per-instance data is expected to change (e.g. instances move), so always host-visible, never shared.
+	if (meshObject.instances && meshObject.instanceBufferSize() > 0) {
+		pInstanceBuffer = new PrimitiveBuffer(vulkan.command.vkPool(), vulkan.device);
+		pInstanceBuffer->CreateVertexBuffer(meshObject.instances, meshObject.instanceBufferSize(), true);
+	}
 }
 
 void AddOns::destroyVertexAndOrIndexBuffers()
 {
-	delete pVertexBuffer;
-	pVertexBuffer = nullptr;
+	releasePrimitive(pVertexBuffer, vertexSource);
+	releasePrimitive(pIndexBuffer, indexSource);
 
-	delete pIndexBuffer;
-	pIndexBuffer = nullptr;
+	delete pInstanceBuffer;
+	pInstanceBuffer = nullptr;
+}
+
+
+std::map<AddOns::PrimitiveSource, AddOns::SharedPrimitive>	AddOns::sharedPrimitives;
+
+// Return the buffer already uploaded from identical data (compared once, by reading that buffer back),
+//	else create (and share) a new one.  Data merely hashing alike, the rare collision, gets a buffer of
+//	its own, not shared.
+//
+PrimitiveBuffer* AddOns::sharedPrimitive(PrimitiveSource& source, void* pData, VkDeviceSize size,
+										 const std::function<PrimitiveBuffer*()>& create)
+{
+	source = { hashBytes(pData, (size_t) size), size };
+
+	auto found = sharedPrimitives.find(source);
+	if (found != sharedPrimitives.end()) {
+		if (found->second.pBuffer->Holds(pData, size)) {
+			++found->second.refCount;
+			return found->second.pBuffer;
+		}
+		source = { 0, 0 };
+		return create();
+	}
+	PrimitiveBuffer* pBuffer = create();
+	sharedPrimitives[source] = { pBuffer, 1 };
+	return pBuffer;
+}
+
+void AddOns::releasePrimitive(PrimitiveBuffer*& pBuffer, PrimitiveSource& source)
+{
+	auto found = sharedPrimitives.find(source);
+	if (source.second > 0 && found != sharedPrimitives.end()) {
+		if (--found->second.refCount == 0) {
+			delete found->second.pBuffer;
+			sharedPrimitives.erase(found);
+		}
+	} else
+		delete pBuffer;
+
+	pBuffer = nullptr;
+	source = { 0, 0 };
 }
 
 
@@ -92,6 +144,14 @@ void AddOns::Recreate(MeshObject& meshObject)
 
 #pragma mark - UBO / TEXTURE DESCRIPTORS
 
+// Which set a UBO goes in, if SETS_BY_FREQUENCY: one holding a model matrix (or dynamic, holding
+//	every object's) varies per object; otherwise (view/projection, lights, shadow...) per frame.
+//
+static DescriptorFrequency frequencyOf(UBO& ubo)
+{
+	return (ubo.pModel || ubo.isDynamic) ? PER_OBJECT : PER_FRAME;
+}
+
 // Assemble a collection of Descriptors to be "added on."  Ordering is critical:
 //	make sure each INDEX matches its "layout(binding = <INDEX>)" in your Shader...
 //																					// e.g. :
@@ -108,25 +168,32 @@ void AddOns::createDescribedItems(vector<UBO>& UBOs, vector<TextureSpec>& textur
 			// Dynamic UBO: No per-object UniformBuffer created, using shared DynamicUniformBuffer
 			pUniformBuffers.push_back(nullptr);
 			VkDescriptorBufferInfo bufInfo = eachUBO.pDynamicUBO->getDescriptorBufferInfo(0);
-			described.emplace_back(bufInfo, eachUBO.getShaderStageFlags(), DYNAMIC_BUFFER);
+			described.emplace_back(bufInfo, eachUBO.getShaderStageFlags(), DYNAMIC_BUFFER)
+				.frequency = frequencyOf(eachUBO);
 		} else {
 			// Regular UBO: create UniformBuffer as before
 			UniformBuffer* pUniformBuffer = new UniformBuffer(eachUBO.byteSize, vulkan.swapchain, vulkan.device);
 			pUniformBuffers.push_back(pUniformBuffer);
 			described.emplace_back(pUniformBuffer->getDescriptorBufferInfo(),	// layout(binding = 0)	<-- appears in Vertex Shader
-									eachUBO.getShaderStageFlags());
+									eachUBO.getShaderStageFlags()).frequency = frequencyOf(eachUBO);
 		}
 	}																			// If there's > 1 UBO above, adjust the layout
 																				//	number below, (binding = N + 1) accordingly!
 	// Textures next (may be more than one)... order is important here too == binding index
+	for (TextureSpec& textureSpec : textureSpecs)								// (all decoding at once)
+		if (textureSpec.fileName && ! textureSpec.wantMutable)
+			vulkan.textureLoader.Prefetch(textureSpec.fileName, textureSpec.flipVertical);
 	for (TextureSpec& textureSpec : textureSpecs) {
 		if (textureSpec.fileName || textureSpec.pImageInfo) {
 			texspecs.push_back(textureSpec);
-			TextureImage* pTexture = new TextureImage(texspecs.back(), vulkan.command.vkPool(), vulkan.device, platform);
+			TextureImage* pTexture = new TextureImage(texspecs.back(), vulkan.command.vkPool(), vulkan.device, platform,
+													  VK_NULL_HANDLE, &vulkan.textureLoader, isBindless);
 			if (pTexture) {
 				pTextureImages.emplace_back(pTexture);
+				if (isBindless)		// (registered in the bindless array instead, see materialIndex)
+					continue;
 				described.emplace_back( pTexture->getDescriptorImageInfo(),			// layout(binding = 1) ... 2) ... 3)...	 <-- in Fragment Shader
-										VK_SHADER_STAGE_FRAGMENT_BIT);
+										VK_SHADER_STAGE_FRAGMENT_BIT).frequency = PER_MATERIAL;
 										// ^^^^^^ TODO: ^^^^^^^^ We don't have a mechanism (YET!) allowing an image to
 			}							//		be specified for the VERTEX STAGE, which could be helpful for something
 		}								//		like offseting vertices based on a depth map.
@@ -134,13 +201,13 @@ void AddOns::createDescribedItems(vector<UBO>& UBOs, vector<TextureSpec>& textur
 
 	// Runtime textures (e.g., shadow maps) - already created, just add descriptors:
 	for (VkDescriptorImageInfo& imageInfo : runtimeTextures) {
-		described.emplace_back(imageInfo, VK_SHADER_STAGE_FRAGMENT_BIT);
+		described.emplace_back(imageInfo, VK_SHADER_STAGE_FRAGMENT_BIT).frequency = PER_FRAME;
 	}
 
 	// Per-frame runtime textures (e.g., shadow maps with frames-in-flight).
 	// Each texture binding has one image per swapchain frame to prevent cross-frame races.
 	for (vector<VkDescriptorImageInfo>& perFrameImageInfo : perFrameRuntimeTextures) {
-		described.emplace_back(perFrameImageInfo, VK_SHADER_STAGE_FRAGMENT_BIT);
+		described.emplace_back(perFrameImageInfo, VK_SHADER_STAGE_FRAGMENT_BIT).frequency = PER_FRAME;
 	}
 }
 
@@ -170,8 +237,12 @@ void AddOns::RecreateDescribables()
 	for (auto& pTextureImage : pTextureImages)
 		delete pTextureImage;
 	pTextureImages.clear();
+	for (auto& texspec : texspecs)
+		if (texspec.fileName && ! texspec.wantMutable)
+			vulkan.textureLoader.Prefetch(texspec.fileName, texspec.flipVertical);
 	for (auto& texspec : texspecs) {
-		TextureImage* pTexture = new TextureImage(texspec, vulkan.command.vkPool(), vulkan.device, platform);
+		TextureImage* pTexture = new TextureImage(texspec, vulkan.command.vkPool(), vulkan.device, platform,
+												  VK_NULL_HANDLE, &vulkan.textureLoader, isBindless);
 		pTextureImages.emplace_back(pTexture);
 	}
 }
@@ -187,14 +258,27 @@ vector<DescribEd> AddOns::reDescribe()
 		if (ubos[index].isDynamic) {
 			// Dynamic UBO: query shared buffer info
 			VkDescriptorBufferInfo bufInfo = ubos[index].pDynamicUBO->getDescriptorBufferInfo(0);
-			redescribedAddOns.emplace_back(bufInfo, ubos[index].getShaderStageFlags(), DYNAMIC_BUFFER);
+			redescribedAddOns.emplace_back(bufInfo, ubos[index].getShaderStageFlags(), DYNAMIC_BUFFER)
+				.frequency = frequencyOf(ubos[index]);
 		} else {
 			redescribedAddOns.emplace_back(pUniformBuffers[index]->getDescriptorBufferInfo(),
-										   ubos[index].getShaderStageFlags());
+										   ubos[index].getShaderStageFlags()).frequency = frequencyOf(ubos[index]);
 		}
 	}
-	for (auto& pTextureImage : pTextureImages)
-		redescribedAddOns.emplace_back(pTextureImage->getDescriptorImageInfo(),
-									   VK_SHADER_STAGE_FRAGMENT_BIT);
+	if (! isBindless)
+		for (auto& pTextureImage : pTextureImages)
+			redescribedAddOns.emplace_back(pTextureImage->getDescriptorImageInfo(),
+										   VK_SHADER_STAGE_FRAGMENT_BIT).frequency = PER_MATERIAL;
 	return redescribedAddOns;
 }
+
+// Bindless, a material is identified by the slot of its first texture; a shader needing more textures
+//	than that can index a storage buffer (also bindless) of per-material slots by it, in turn.
+//
+uint32_t AddOns::materialIndex()
+{
+	if (! isBindless || pTextureImages.empty())
+		return 0;
+	uint32_t slot = pTextureImages.front()->getBindlessIndex();
+	return slot != BindlessDescriptors::NO_SLOT ? slot : 0;
+}
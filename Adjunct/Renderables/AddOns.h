@@ -27,6 +27,8 @@
 #include "UniformBuffer.h"
 #include "TextureImage.h"
 #include "Customizer.h"
+#include <map>
+#include <functional>
 
 class DrawableSpecifier;	// skirt circular reference including iRenderable.h
 
@@ -50,6 +52,21 @@ protected:
 
 	PrimitiveBuffer*	pVertexBuffer	= nullptr;
 	PrimitiveBuffer*	pIndexBuffer	= nullptr;
+	PrimitiveBuffer*	pInstanceBuffer	= nullptr;	// (host-visible, bound at INSTANCE_BINDING)
+
+	// Static (not DYNAMIC_GEOMETRY) vertex/index data uploads once, its buffer then shared by every
+	//	AddOns whose mesh holds identical bytes, so identical meshes also share the same VkBuffers.
+	//	(Identical byte for byte: on a hash match the shared buffer is read back and compared, rather
+	//	 than keeping a CPU-side copy of every mesh, should contents differ yet hash alike.)
+	typedef std::pair<uint64_t, VkDeviceSize>	PrimitiveSource;	// (hash of contents, byte size)
+	struct SharedPrimitive {
+		PrimitiveBuffer*	pBuffer;
+		int					refCount;
+	};
+	static std::map<PrimitiveSource, SharedPrimitive>	sharedPrimitives;
+
+	PrimitiveSource		vertexSource	= { 0, 0 };		// (size 0: buffer not shared, owned outright)
+	PrimitiveSource		indexSource		= { 0, 0 };
 
 	vector<UniformBuffer*>	pUniformBuffers;
 	vector<TextureImage*>	pTextureImages;
@@ -60,6 +77,8 @@ protected:
 	VulkanSetup&		vulkan;			// These are retained mainly
 	iPlatform&			platform;		//	for Recreate.
 
+	bool				isBindless;		// Customized BINDLESS (and the device supports it): textures aren't described.
+
 		// METHODS
 
 	void createVertexAndOrIndexBuffers(MeshObject& meshObject, Customizer customize = NONE);
@@ -77,10 +96,14 @@ protected:
 	void RecreateDescribables();
 private:
 	vector<DescribEd> reDescribe();
+	PrimitiveBuffer* sharedPrimitive(PrimitiveSource& source, void* pData, VkDeviceSize size,
+									 const std::function<PrimitiveBuffer*()>& create);
+	void releasePrimitive(PrimitiveBuffer*& pBuffer, PrimitiveSource& source);
 
 		// getters
 public:
 	vector<TextureImage*>&	textureImages()	 { return pTextureImages; }
+	uint32_t				materialIndex();	// (for DrawPushConstants, if isBindless)
 };
 
 #endif	// AddOns_h
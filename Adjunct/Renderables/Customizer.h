@@ -35,7 +35,17 @@ enum Customizer
 	LINE_TOPOLOGY			= 0b100000000000,	// Use VK_PRIMITIVE_TOPOLOGY_LINE_LIST instead of TRIANGLE_LIST.
 	POINT_TOPOLOGY			= 0b1000000000000,	// Use VK_PRIMITIVE_TOPOLOGY_POINT_LIST; requires shader to write gl_PointSize.
 	STRIP_TOPOLOGY			= 0b10000000000000,	// Use VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP instead of TRIANGLE_LIST.
-	DEPTH_BIAS				= 0b100000000000000	// Enable slope-scaled depth bias (for shadow map depth pass).
+	DEPTH_BIAS				= 0b100000000000000,	// Enable slope-scaled depth bias (for shadow map depth pass).
+	AUTO_INSTANCE			= 0b1000000000000000,	// Vertex shader reads its model matrix per-instance, so renderables sharing
+												//	mesh + material merge into one instanced draw (see RenderBatch.h).
+	DISABLE_COLOR_WRITE		= 0b10000000000000000,	// Write no color, only depth, e.g. for occlusion-query proxies.
+	PUSH_CONSTANTS			= 0b100000000000000000,	// Push DrawableProperties.pushConstants before each draw (see DrawPushConstants.h).
+	BINDLESS				= 0b1000000000000000000,	// Textures are sampled from the device-wide array (see BindlessDescriptors.h), by
+												//	pushed materialIndex, rather than bound in this renderable's own set.  Implies PUSH_CONSTANTS.
+	SETS_BY_FREQUENCY		= 0b10000000000000000000,	// Split descriptors into set 0 per-frame (the shared FrameConstants), set 1 per-material,
+												//	set 2 per-object (see Descriptors.h), each rebound only when it changes between draws.
+	PUSH_DESCRIPTORS		= 0b100000000000000000000	// Push the per-object descriptors with each draw (VK_KHR_push_descriptor, if supported)
+												//	rather than allocate a set per swapchain image; not for dynamic UBOs.
 };
 
 inline Customizer operator | (Customizer left, Customizer right)
@@ -0,0 +1,43 @@
+//
+// DrawPushConstants.h
+//	VulkanModule AddOns
+//
+// Small per-draw values pushed straight into the command buffer, rather than written to a UBO
+//	and reached through a (dynamic-offset) descriptor set rebind.
+//
+// Every GraphicsPipeline's layout declares this same range, for vertex and fragment stages, so all
+//	are compatible for push constants: values pushed stay valid across pipeline switches, and a shader
+//	not declaring the block simply ignores them.  Renderables customized PUSH_CONSTANTS push their
+//	DrawableProperties.pushConstants before drawing; their shaders read them as:
+//		layout(push_constant) uniform DrawConstants {
+//			uint	objectIndex;		// e.g. into a storage buffer of per-object data
+//			float	opacity;
+//			uint	effectFlags;
+//			uint	user;
+//			uint	materialIndex;		// into the bindless texture array, if customized BINDLESS
+//		} draw;
+//	To carry more, override by replacing this file (as with Customizer.h), within the device's
+//	maxPushConstantsSize (128 bytes is the minimum guaranteed).
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef DrawPushConstants_h
+#define DrawPushConstants_h
+
+#include "VulkanPlatform.h"
+
+
+struct DrawPushConstants
+{
+	uint32_t	objectIndex	= 0;
+	float		opacity		= 1.0f;
+	uint32_t	effectFlags	= 0;
+	uint32_t	user		= 0;
+	uint32_t	materialIndex = 0;		// (set by the renderable, if BINDLESS, to its first texture's slot)
+
+	static constexpr VkShaderStageFlags STAGES = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+};
+static_assert(sizeof(DrawPushConstants) <= 128, "DrawPushConstants exceeds guaranteed maxPushConstantsSize.");
+
+#endif	// DrawPushConstants_h
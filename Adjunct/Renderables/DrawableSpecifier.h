@@ -17,6 +17,8 @@
 #include "UniformBufferLiterals.h"
 #include "TextureImage.h"
 #include "Customizer.h"
+#include "DrawPushConstants.h"
+#include "SpecializationConstants.h"
 #include "GameClock.h"
 
 
@@ -34,6 +36,8 @@ public:
 	ShaderModules*		pSharedShaderModules = nullptr;  // Optional: use cached shared shaders
 	const char*			pass = nullptr;  // Render pass type (nullptr for primary spawn, "transparency"/"lines"/"shadow" for subsequent passes)
 	int					renderOrder = 0;  // Stable sort order within same pass (lower = rendered first)
+	DrawPushConstants	pushConstants;	  // Per-draw values, pushed if customized PUSH_CONSTANTS
+	SpecializationConstants	specialization;	  // Per-stage constants fixed at pipeline creation (see SpecializationConstants.h)
 };
 
 
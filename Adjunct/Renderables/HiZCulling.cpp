@@ -0,0 +1,579 @@
+//
+// HiZCulling.cpp
+//	VulkanModule AddOns
+//
+// See header file comment for overview.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "HiZCulling.h"
+#include "CommandObjects.h"
+#include "VulkanSetup.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+
+const VkFormat PyramidFormat = VK_FORMAT_R32_SFLOAT;
+
+// Largest power of two not exceeding each dimension, so every level halves exactly.
+//
+static VkExtent2D pyramidExtent(VkExtent2D depthExtent)
+{
+	return { std::bit_floor(std::max(depthExtent.width, 1u)), std::bit_floor(std::max(depthExtent.height, 1u)) };
+}
+
+static uint32_t groupsFor(uint32_t threads, uint32_t groupSize)
+{
+	return (threads + groupSize - 1) / groupSize;
+}
+
+
+#pragma mark - DepthPyramid
+
+DepthPyramid::DepthPyramid(VkExtent2D depthExtent, VkCommandPool& pool, GraphicsDevice& graphics)
+	:	ImageResource(graphics, &mipmaps),
+		CommandBufferBase(pool, graphics),
+		mipmaps(pool, graphics)
+{
+	create(depthExtent);
+}
+
+DepthPyramid::~DepthPyramid()
+{
+	destroyLevelViews();
+	destroy();
+
+	Log(DEAD, "Destroyed: DepthPyramid");
+}
+
+void DepthPyramid::create(VkExtent2D depthExtent)
+{
+	VkExtent2D extent = pyramidExtent(depthExtent);
+	imageInfo.wide	 = extent.width;
+	imageInfo.high	 = extent.height;
+	imageInfo.format = PyramidFormat;
+
+	createImage(extent.width, extent.height, PyramidFormat, VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	createImageView();		// (all levels, for the cull shader to sample)
+
+	for (uint32_t iLevel = 0; iLevel < NumLevels(); ++iLevel) {
+		VkImageViewCreateInfo viewInfo = {
+			.sType	= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+			.pNext	= nullptr,
+			.flags	= 0,
+			.image		= image,
+			.viewType	= VK_IMAGE_VIEW_TYPE_2D,
+			.format		= PyramidFormat,
+			.components = { .r = VK_COMPONENT_SWIZZLE_IDENTITY, .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+							.b = VK_COMPONENT_SWIZZLE_IDENTITY, .a = VK_COMPONENT_SWIZZLE_IDENTITY },
+			.subresourceRange = {
+				.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel	= iLevel,
+				.levelCount		= 1,
+				.baseArrayLayer = 0,
+				.layerCount		= 1
+			}
+		};
+		levelViews.emplace_back();
+		call = vkCreateImageView(device, &viewInfo, nullALLOC, &levelViews.back());
+		if (call != VK_SUCCESS)
+			Fatal("Create Image View for depth pyramid level FAILURE" + ErrStr(call));
+	}
+
+	clearToFarthest();
+}
+
+void DepthPyramid::destroyLevelViews()
+{
+	for (VkImageView& levelView : levelViews)
+		vkDestroyImageView(device, levelView, nullALLOC);
+	levelViews.clear();
+}
+
+void DepthPyramid::Recreate(VkExtent2D depthExtent)
+{
+	destroyLevelViews();
+	destroy();
+	create(depthExtent);
+}
+
+// Until a frame has been reduced into it, nothing is occluded: all at far plane, 1.0.
+//	Also transitions it to the GENERAL layout it then stays in.
+//
+void DepthPyramid::clearToFarthest()
+{
+	VkImageSubresourceRange allLevels = {
+		.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+		.baseMipLevel	= 0,
+		.levelCount		= NumLevels(),
+		.baseArrayLayer	= 0,
+		.layerCount		= 1
+	};
+	VkImageMemoryBarrier barrier = {
+		.sType	= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+		.pNext	= nullptr,
+		.srcAccessMask	= 0,
+		.dstAccessMask	= VK_ACCESS_TRANSFER_WRITE_BIT,
+		.oldLayout			= VK_IMAGE_LAYOUT_UNDEFINED,
+		.newLayout			= VK_IMAGE_LAYOUT_GENERAL,
+		.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED,
+		.image			= image,
+		.subresourceRange = allLevels
+	};
+
+	VkCommandBuffer commandBuffer = beginSingleSubmitCommands();
+
+	vkCmdPipelineBarrier(commandBuffer,
+						 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+						 0, nullptr,
+						 0, nullptr,
+						 1, &barrier);
+
+	VkClearColorValue farthest = { .float32 = { 1.0f, 0, 0, 0 } };
+	vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_GENERAL, &farthest, 1, &allLevels);
+
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.oldLayout	  = VK_IMAGE_LAYOUT_GENERAL;
+
+	vkCmdPipelineBarrier(commandBuffer,
+						 VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+						 0, nullptr,
+						 0, nullptr,
+						 1, &barrier);
+
+	endAndSubmitCommands(commandBuffer);
+}
+
+
+#pragma mark - HiZCandidates
+
+HiZCandidates::HiZCandidates()
+	:	BufferBase(CommandControl::device())
+{ }
+
+HiZCandidates::~HiZCandidates()
+{
+	destroyBuffer();
+	if (descriptorPool)
+		vkDestroyDescriptorPool(device, descriptorPool, nullALLOC);
+}
+
+uint32_t HiZCandidates::Add(const mat4& boxToClip, const uint32_t drawCommand[5])
+{
+	HiZCandidate& candidate = candidates.emplace_back();
+	candidate.boxToClip = boxToClip;
+	std::copy(drawCommand, drawCommand + 5, candidate.drawCommand);
+	return (uint32_t) candidates.size() - 1;
+}
+
+void HiZCandidates::Upload(HiZCulling* pCulling)
+{
+	if (candidates.empty())
+		return;
+
+	if (candidates.size() > capacity) {
+		grow(std::max(candidates.size(), capacity * 2));
+		pDescribedBy = nullptr;
+	}
+	memcpy(pMapped, candidates.data(), candidates.size() * sizeof(HiZCandidate));
+
+	if (pCulling != pDescribedBy || pCulling->Generation() != describedGeneration)
+		describe(pCulling);
+}
+
+void HiZCandidates::grow(size_t minimum)
+{
+	destroyBuffer();
+	capacity = minimum;
+
+	createGeneralBuffer(capacity * sizeof(HiZCandidate),
+						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+						VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						buffer, bufferMemory);
+	vkMapMemory(device, bufferMemory, 0, VK_WHOLE_SIZE, 0, &pMapped);
+}
+
+void HiZCandidates::destroyBuffer()
+{
+	if (buffer) {
+		vkUnmapMemory(device, bufferMemory);
+		vkDestroyBuffer(device, buffer, nullALLOC);
+		vkFreeMemory(device, bufferMemory, nullALLOC);
+		buffer = VK_NULL_HANDLE;
+	}
+}
+
+// (Re)allocate the cull shader's descriptor set, pointing it at this buffer and at the pyramid.
+//	Only happens when either changed, and only while this frame isn't in flight.
+//
+void HiZCandidates::describe(HiZCulling* pCulling)
+{
+	if (descriptorPool)
+		vkDestroyDescriptorPool(device, descriptorPool, nullALLOC);
+
+	VkDescriptorPoolSize poolSizes[] = {
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 },
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 }
+	};
+	VkDescriptorPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.maxSets		= 1,
+		.poolSizeCount	= N_ELEMENTS_IN_ARRAY(poolSizes),
+		.pPoolSizes		= poolSizes
+	};
+	call = vkCreateDescriptorPool(device, &poolInfo, nullALLOC, &descriptorPool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Pool for Hi-Z candidates FAILURE" + ErrStr(call));
+
+	VkDescriptorSetAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.descriptorPool		= descriptorPool,
+		.descriptorSetCount	= 1,
+		.pSetLayouts		= &pCulling->getCullSetLayout()
+	};
+	call = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet);
+	if (call != VK_SUCCESS)
+		Fatal("Allocate Descriptor Set for Hi-Z candidates FAILURE" + ErrStr(call));
+
+	VkDescriptorBufferInfo bufferInfo = { buffer, 0, VK_WHOLE_SIZE };
+	VkDescriptorImageInfo  imageInfo  = { pCulling->getSampler(), pCulling->getPyramidView(), VK_IMAGE_LAYOUT_GENERAL };
+
+	VkWriteDescriptorSet writes[] = {{
+		.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext	= nullptr,
+		.dstSet				= descriptorSet,
+		.dstBinding			= 0,
+		.dstArrayElement	= 0,
+		.descriptorCount	= 1,
+		.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.pImageInfo			= nullptr,
+		.pBufferInfo		= &bufferInfo,
+		.pTexelBufferView	= nullptr
+	}, {
+		.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext	= nullptr,
+		.dstSet				= descriptorSet,
+		.dstBinding			= 1,
+		.dstArrayElement	= 0,
+		.descriptorCount	= 1,
+		.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		.pImageInfo			= &imageInfo,
+		.pBufferInfo		= nullptr,
+		.pTexelBufferView	= nullptr
+	}};
+	vkUpdateDescriptorSets(device, N_ELEMENTS_IN_ARRAY(writes), writes, 0, nullptr);
+
+	pDescribedBy = pCulling;
+	describedGeneration = pCulling->Generation();
+}
+
+
+#pragma mark - HiZCulling
+
+HiZCulling::HiZCulling(ShaderModules& reduce, ShaderModules& cull, VulkanSetup& vulkan)
+	:	reduceShader(reduce),
+		cullShader(cull),
+		device(vulkan.device.getLogical()),
+		pipelineCache(vulkan.device.getPipelineCache().getVkPipelineCache()),
+		depthBuffer(vulkan.depthBuffer),
+		pyramid(vulkan.depthBuffer.getExtent(), CommandControl::vkPool(), vulkan.device)
+{
+	if (! vulkan.renderPass.keepsDepth() || ! depthBuffer.isSampledByShaders())
+		Fatal("HiZCulling requires VulkanSetup with DEPTH_PYRAMID (and a depth buffer).");
+
+	createSampler();
+
+	reduceSetLayout = createSetLayout(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+	cullSetLayout	= createSetLayout(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+
+	reduceLayout = createPipelineLayout(reduceSetLayout, sizeof(ReducePushConstants));
+	cullLayout	 = createPipelineLayout(cullSetLayout, sizeof(CullPushConstants));
+
+	reducePipeline = createPipeline(reduceShader, reduceLayout);
+	cullPipeline   = createPipeline(cullShader, cullLayout);
+
+	createReduceSets();
+}
+
+HiZCulling::~HiZCulling()
+{
+	destroyReduceSets();
+	vkDestroyPipeline(device, cullPipeline, nullALLOC);
+	vkDestroyPipeline(device, reducePipeline, nullALLOC);
+	vkDestroyPipelineLayout(device, cullLayout, nullALLOC);
+	vkDestroyPipelineLayout(device, reduceLayout, nullALLOC);
+	vkDestroyDescriptorSetLayout(device, cullSetLayout, nullALLOC);
+	vkDestroyDescriptorSetLayout(device, reduceSetLayout, nullALLOC);
+	vkDestroySampler(device, sampler, nullALLOC);
+
+	Log(DEAD, "Destroyed: HiZCulling");
+}
+
+// Texels are only ever fetched whole (texelFetch), never filtered.
+//
+void HiZCulling::createSampler()
+{
+	VkSamplerCreateInfo samplerInfo = {
+		.sType	= VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.magFilter	= VK_FILTER_NEAREST,
+		.minFilter	= VK_FILTER_NEAREST,
+		.mipmapMode	= VK_SAMPLER_MIPMAP_MODE_NEAREST,
+		.addressModeU	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.addressModeV	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.addressModeW	= VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+		.mipLodBias		= 0.0f,
+		.anisotropyEnable	= VK_FALSE,
+		.maxAnisotropy		= 1.0f,
+		.compareEnable		= VK_FALSE,
+		.compareOp			= VK_COMPARE_OP_ALWAYS,
+		.minLod	= 0.0f,
+		.maxLod	= VK_LOD_CLAMP_NONE,
+		.borderColor	= VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE,
+		.unnormalizedCoordinates = VK_FALSE
+	};
+	call = vkCreateSampler(device, &samplerInfo, nullALLOC, &sampler);
+	if (call != VK_SUCCESS)
+		Fatal("Create Sampler for depth pyramid FAILURE" + ErrStr(call));
+}
+
+VkDescriptorSetLayout HiZCulling::createSetLayout(VkDescriptorType binding0, VkDescriptorType binding1)
+{
+	VkDescriptorSetLayoutBinding bindings[] = {
+		{ 0, binding0, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+		{ 1, binding1, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+	};
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.bindingCount	= N_ELEMENTS_IN_ARRAY(bindings),
+		.pBindings		= bindings
+	};
+	VkDescriptorSetLayout setLayout;
+	call = vkCreateDescriptorSetLayout(device, &layoutInfo, nullALLOC, &setLayout);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Set Layout for Hi-Z FAILURE" + ErrStr(call));
+	return setLayout;
+}
+
+VkPipelineLayout HiZCulling::createPipelineLayout(VkDescriptorSetLayout& setLayout, uint32_t pushSize)
+{
+	VkPushConstantRange pushRange = { VK_SHADER_STAGE_COMPUTE_BIT, 0, pushSize };
+
+	VkPipelineLayoutCreateInfo layoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.setLayoutCount			= 1,
+		.pSetLayouts			= &setLayout,
+		.pushConstantRangeCount	= 1,
+		.pPushConstantRanges	= &pushRange
+	};
+	VkPipelineLayout pipelineLayout;
+	call = vkCreatePipelineLayout(device, &layoutInfo, nullALLOC, &pipelineLayout);
+	if (call != VK_SUCCESS)
+		Fatal("Create Pipeline Layout for Hi-Z FAILURE" + ErrStr(call));
+	return pipelineLayout;
+}
+
+VkPipeline HiZCulling::createPipeline(ShaderModules& shader, VkPipelineLayout& layout)
+{
+	VkComputePipelineCreateInfo pipelineInfo = {
+		.sType	= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.stage	= *shader.ShaderStages(),
+		.layout	= layout,
+		.basePipelineHandle	= VK_NULL_HANDLE,
+		.basePipelineIndex	= -1
+	};
+	VkPipeline pipeline;
+	call = vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullALLOC, &pipeline);
+	if (call != VK_SUCCESS)
+		Fatal("Create Compute Pipeline for Hi-Z FAILURE" + ErrStr(call));
+	return pipeline;
+}
+
+// Each level's set reads the level above it (level 0 reads the depth buffer itself) and writes that level.
+//
+void HiZCulling::createReduceSets()
+{
+	uint32_t nLevels = pyramid.NumLevels();
+
+	VkDescriptorPoolSize poolSizes[] = {
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, nLevels },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, nLevels }
+	};
+	VkDescriptorPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.maxSets		= nLevels,
+		.poolSizeCount	= N_ELEMENTS_IN_ARRAY(poolSizes),
+		.pPoolSizes		= poolSizes
+	};
+	call = vkCreateDescriptorPool(device, &poolInfo, nullALLOC, &reducePool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Pool for Hi-Z reduction FAILURE" + ErrStr(call));
+
+	vector<VkDescriptorSetLayout> setLayouts(nLevels, reduceSetLayout);
+	VkDescriptorSetAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.descriptorPool		= reducePool,
+		.descriptorSetCount	= nLevels,
+		.pSetLayouts		= setLayouts.data()
+	};
+	reduceSets.resize(nLevels);
+	call = vkAllocateDescriptorSets(device, &allocInfo, reduceSets.data());
+	if (call != VK_SUCCESS)
+		Fatal("Allocate Descriptor Sets for Hi-Z reduction FAILURE" + ErrStr(call));
+
+	for (uint32_t iLevel = 0; iLevel < nLevels; ++iLevel) {
+		VkDescriptorImageInfo sourceInfo = iLevel == 0
+			? VkDescriptorImageInfo { sampler, *depthBuffer.getpImageView(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL }
+			: VkDescriptorImageInfo { sampler, pyramid.getLevelView(iLevel - 1), VK_IMAGE_LAYOUT_GENERAL };
+		VkDescriptorImageInfo targetInfo = { VK_NULL_HANDLE, pyramid.getLevelView(iLevel), VK_IMAGE_LAYOUT_GENERAL };
+
+		VkWriteDescriptorSet writes[] = {{
+			.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext	= nullptr,
+			.dstSet				= reduceSets[iLevel],
+			.dstBinding			= 0,
+			.dstArrayElement	= 0,
+			.descriptorCount	= 1,
+			.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+			.pImageInfo			= &sourceInfo,
+			.pBufferInfo		= nullptr,
+			.pTexelBufferView	= nullptr
+		}, {
+			.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext	= nullptr,
+			.dstSet				= reduceSets[iLevel],
+			.dstBinding			= 1,
+			.dstArrayElement	= 0,
+			.descriptorCount	= 1,
+			.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+			.pImageInfo			= &targetInfo,
+			.pBufferInfo		= nullptr,
+			.pTexelBufferView	= nullptr
+		}};
+		vkUpdateDescriptorSets(device, N_ELEMENTS_IN_ARRAY(writes), writes, 0, nullptr);
+	}
+}
+
+void HiZCulling::destroyReduceSets()
+{
+	if (reducePool) {
+		vkDestroyDescriptorPool(device, reducePool, nullALLOC);
+		reducePool = VK_NULL_HANDLE;
+	}
+	reduceSets.clear();
+}
+
+// Zero the instanceCount of every candidate the pyramid shows to be hidden, then make those
+//	writes visible to the render pass's indirect draws.
+//
+void HiZCulling::CmdCull(VkCommandBuffer& commandBuffer, HiZCandidates& candidates)
+{
+	if (candidates.Count() == 0)
+		return;
+
+	VkMemoryBarrier pyramidBuilt = {			// (by the last frame's CmdBuildPyramid)
+		.sType	= VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.pNext	= nullptr,
+		.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT,
+		.dstAccessMask	= VK_ACCESS_SHADER_READ_BIT
+	};
+	vkCmdPipelineBarrier(commandBuffer,
+						 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+						 1, &pyramidBuilt,
+						 0, nullptr,
+						 0, nullptr);
+
+	VkExtent2D extent = pyramid.getExtent();
+	CullPushConstants constants = {
+		.nCandidates = candidates.Count(),
+		.nLevels	 = pyramid.NumLevels(),
+		.pyramidSize = { (float) extent.width, (float) extent.height }
+	};
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullLayout, 0, 1,
+							&candidates.getDescriptorSet(), 0, nullptr);
+	vkCmdPushConstants(commandBuffer, cullLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+	vkCmdDispatch(commandBuffer, groupsFor(constants.nCandidates, CULL_GROUP_SIZE), 1, 1);
+
+	VkMemoryBarrier commandsWritten = {
+		.sType	= VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.pNext	= nullptr,
+		.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT,
+		.dstAccessMask	= VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+	};
+	vkCmdPipelineBarrier(commandBuffer,
+						 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0,
+						 1, &commandsWritten,
+						 0, nullptr,
+						 0, nullptr);
+}
+
+// Reduce this frame's depth buffer into the pyramid, level by level, each waiting on the one before.
+//	The render pass's outgoing dependency already orders its depth writes before level 0's reads.
+//
+void HiZCulling::CmdBuildPyramid(VkCommandBuffer& commandBuffer)
+{
+	VkMemoryBarrier levelDone = {
+		.sType	= VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.pNext	= nullptr,
+		.srcAccessMask	= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,	// (first: this frame's cull reads)
+		.dstAccessMask	= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+	};
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+
+	VkExtent2D depthExtent = depthBuffer.getExtent();
+	VkExtent2D source = depthExtent;
+	VkExtent2D target = pyramid.getExtent();
+
+	for (uint32_t iLevel = 0; iLevel < pyramid.NumLevels(); ++iLevel) {
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+							 1, &levelDone,
+							 0, nullptr,
+							 0, nullptr);
+
+		ReducePushConstants constants = {
+			.sourceSize = { (int32_t) source.width, (int32_t) source.height },
+			.targetSize = { (int32_t) target.width, (int32_t) target.height }
+		};
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reduceLayout, 0, 1,
+								&reduceSets[iLevel], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, reduceLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+		vkCmdDispatch(commandBuffer, groupsFor(target.width, REDUCE_GROUP_SIZE),
+									 groupsFor(target.height, REDUCE_GROUP_SIZE), 1);
+
+		source = target;
+		target = { std::max(target.width / 2, 1u), std::max(target.height / 2, 1u) };
+	}
+}
+
+// Upon resize, after the depth buffer has been recreated.
+//
+void HiZCulling::Recreate(VulkanSetup& vulkan)
+{
+	destroyReduceSets();
+	pyramid.Recreate(depthBuffer.getExtent());
+	createReduceSets();
+	++generation;
+}
@@ -0,0 +1,193 @@
+//
+// HiZCulling.h
+//	VulkanModule AddOns
+//
+// Cull renderables hidden behind others entirely on the GPU, against a hierarchical-Z depth pyramid.
+//	After the render pass, a compute pass reduces the depth buffer into a mip chain whose every texel
+//	holds the farthest depth of the texels it covers.  Next frame, before the render pass, a second
+//	compute pass projects each candidate's bounding box, picks the mip at which the box spans about
+//	one texel, and if the box's nearest depth is still behind the farthest there, zeroes the
+//	instanceCount of the candidate's indirect draw command.  The CPU never reads the verdict back.
+//
+// The pyramid lags one frame behind, so an object emerging from behind a moving occluder may be
+//	missing for that frame; in exchange, nothing stalls.  Candidates are as for OcclusionCulling
+//	(opaque, individually drawn, static-geometry renderables with bounds and model, view and projection
+//	matrices), which Hi-Z supersedes when both are enabled.
+//
+// Requires VulkanSetup(platform, DEPTH_PYRAMID) so that the depth buffer is stored and sampleable.
+//	As with ShadowPass, the app supplies the compute shaders, e.g. HiZReduce.comp and HiZCull.comp
+//	(see TestHarness/src/shaders), taking the descriptors and push constants laid out below.
+//	Then enable it:  command.SetHiZCulling(&hiZCulling);  and delete it with other device resources.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef HiZCulling_h
+#define HiZCulling_h
+
+#include "VulkanPlatform.h"
+#include "iRenderable.h"
+#include "DepthBuffer.h"
+#include "Mipmaps.h"
+#include <cstddef>
+
+class VulkanSetup;
+class HiZCulling;
+
+
+// Mip chain of farthest depths, R32_SFLOAT, kept in GENERAL layout to be both written and sampled.
+//	Level 0 is the largest power of two not exceeding the depth buffer, so each level halves evenly.
+//
+class DepthPyramid : protected ImageResource, CommandBufferBase
+{
+public:
+	DepthPyramid(VkExtent2D depthExtent, VkCommandPool& pool, GraphicsDevice& graphics);
+	~DepthPyramid();
+
+		// MEMBERS
+private:
+	Mipmaps				mipmaps;			// (supplies number of levels)
+	vector<VkImageView>	levelViews;			// One per level, for writing as storage image.
+
+		// METHODS
+public:
+	void	Recreate(VkExtent2D depthExtent);
+private:
+	void	create(VkExtent2D depthExtent);
+	void	destroyLevelViews();
+	void	clearToFarthest();
+
+		// getters
+public:
+	uint32_t		NumLevels()				{ return mipmaps.NumLevels(); }
+	VkExtent2D		getExtent()				{ return { (uint32_t) imageInfo.wide, (uint32_t) imageInfo.high }; }
+	VkImageView&	getImageView()			{ return imageView; }
+	VkImageView&	getLevelView(uint32_t iLevel)	{ return levelViews[iLevel]; }
+};
+
+
+// Bounding box and indirect draw command of one culling candidate, as the cull shader sees it (std430).
+//	drawCommand is a VkDrawIndexedIndirectCommand or, if not indexed, a VkDrawIndirectCommand; either
+//	way instanceCount is its second word, which is all the shader writes.
+//
+struct HiZCandidate
+{
+	mat4		boxToClip;			// (unit cube to clip space)
+	uint32_t	drawCommand[5];
+	uint32_t	pad[3];
+};
+static_assert(sizeof(HiZCandidate) == 96, "HiZCandidate must match the cull shader's std430 layout.");
+
+
+// One frame's candidates: owned by that frame's RenderBatchManager, so rewritten only after that
+//	frame has completed.  The buffer is host-visible; it only grows (by doubling) and is otherwise reused.
+//
+class HiZCandidates : BufferBase
+{
+public:
+	HiZCandidates();
+	~HiZCandidates();
+
+	static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+		// MEMBERS
+private:
+	vector<HiZCandidate>	candidates;
+
+	VkBuffer			buffer		   = VK_NULL_HANDLE;
+	VkDeviceMemory		bufferMemory   = VK_NULL_HANDLE;
+	void*				pMapped		   = nullptr;
+	size_t				capacity	   = 0;
+
+	VkDescriptorPool	descriptorPool = VK_NULL_HANDLE;
+	VkDescriptorSet		descriptorSet  = VK_NULL_HANDLE;
+	HiZCulling*			pDescribedBy   = nullptr;		// Descriptor set is current for this,
+	uint32_t			describedGeneration = 0;		//	as of its generation.
+
+		// METHODS
+public:
+	void		Clear()	{ candidates.clear(); }
+	uint32_t	Add(const mat4& boxToClip, const uint32_t drawCommand[5]);
+	void		Upload(HiZCulling* pCulling);
+
+	static VkDeviceSize DrawOffset(uint32_t slot) {
+		return slot * sizeof(HiZCandidate) + offsetof(HiZCandidate, drawCommand);
+	}
+private:
+	void		grow(size_t minimum);
+	void		destroyBuffer();
+	void		describe(HiZCulling* pCulling);
+
+		// getters
+public:
+	uint32_t			Count()		{ return (uint32_t) candidates.size(); }
+	VkBuffer&			getVkBuffer()		{ return buffer; }
+	VkDescriptorSet&	getDescriptorSet()	{ return descriptorSet; }
+};
+
+
+class HiZCulling
+{
+public:
+	HiZCulling(ShaderModules& reduceShader, ShaderModules& cullShader, VulkanSetup& vulkan);
+	~HiZCulling();
+
+	static constexpr uint32_t REDUCE_GROUP_SIZE = 8;	// (8 x 8 threads per workgroup)
+	static constexpr uint32_t CULL_GROUP_SIZE	= 64;	//	...must match the shaders' local_size.
+
+	struct ReducePushConstants {
+		int32_t		sourceSize[2];		// texels of level being read (for level 0: depth buffer)
+		int32_t		targetSize[2];		// texels of level being written
+	};
+	struct CullPushConstants {
+		uint32_t	nCandidates;
+		uint32_t	nLevels;
+		float		pyramidSize[2];		// level 0 texels
+	};
+
+		// MEMBERS
+private:
+	ShaderModules&		reduceShader;
+	ShaderModules&		cullShader;
+	VkDevice&			device;
+	VkPipelineCache&	pipelineCache;
+	DepthBuffer&		depthBuffer;
+
+	DepthPyramid		pyramid;
+	VkSampler			sampler;
+
+	VkDescriptorSetLayout	reduceSetLayout;		// (0: source sampler2D, 1: target image2D)
+	VkDescriptorSetLayout	cullSetLayout;			// (0: candidates buffer, 1: pyramid sampler2D)
+	VkPipelineLayout		reduceLayout;
+	VkPipelineLayout		cullLayout;
+	VkPipeline				reducePipeline;
+	VkPipeline				cullPipeline;
+
+	VkDescriptorPool		reducePool = VK_NULL_HANDLE;
+	vector<VkDescriptorSet>	reduceSets;				// One per pyramid level.
+
+	uint32_t	generation = 0;		// Bumps whenever the pyramid is recreated, invalidating cull sets.
+
+		// METHODS
+public:
+	void	CmdCull(VkCommandBuffer& commandBuffer, HiZCandidates& candidates);	// (precedes render pass)
+	void	CmdBuildPyramid(VkCommandBuffer& commandBuffer);					// (follows render pass)
+
+	void	Recreate(VulkanSetup& vulkan);
+private:
+	VkDescriptorSetLayout	createSetLayout(VkDescriptorType binding0, VkDescriptorType binding1);
+	VkPipelineLayout		createPipelineLayout(VkDescriptorSetLayout& setLayout, uint32_t pushSize);
+	VkPipeline				createPipeline(ShaderModules& shader, VkPipelineLayout& layout);
+	void	createSampler();
+	void	createReduceSets();
+	void	destroyReduceSets();
+
+		// getters
+public:
+	uint32_t				Generation()		{ return generation; }
+	VkDescriptorSetLayout&	getCullSetLayout()	{ return cullSetLayout; }
+	VkImageView&			getPyramidView()	{ return pyramid.getImageView(); }
+	VkSampler&				getSampler()		{ return sampler; }
+};
+
+#endif	// HiZCulling_h
@@ -0,0 +1,52 @@
+//
+// LevelOfDetail.cpp
+//	VulkanModule AddOns
+//
+// See header file comment for overview.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "LevelOfDetail.h"
+#include "iRenderable.h"
+#include <algorithm>
+
+
+uint32_t LODSelector::Select(iRenderable& renderable, float viewportHigh) const
+{
+	MeshObject& mesh = renderable.vertexObject;
+	uint32_t current = renderable.lod;
+
+	if (mesh.lods.empty())
+		return 0;
+
+	const mat4* pModel = renderable.modelMatrix();
+	const mat4* pView  = renderable.viewMatrix();
+	const mat4* pProj  = renderable.projectionMatrix();
+	if (! pModel || ! pView || ! pProj)
+		return current;
+
+	// Errors are model-space, so scale them as the model matrix does (by its largest axis).
+	const mat4& model = *pModel;
+	float scale = std::max(glm::length(vec3(model[0])), std::max(glm::length(vec3(model[1])), glm::length(vec3(model[2]))));
+
+	// From the eye to the nearest of the bounds' enclosing sphere, or to the origin lacking bounds.
+	vec3 center = mesh.hasBounds ? (mesh.boundsMin + mesh.boundsMax) * 0.5f : vec3(0.0f);
+	float radius = mesh.hasBounds ? glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f * scale : 0.0f;
+	float distance = glm::length(vec3((*pView) * model * vec4(center, 1.0f))) - radius;
+
+	bool isPerspective = (*pProj)[2][3] != 0.0f;	// (orthographic: size is independent of distance)
+	if (isPerspective && distance <= 0.0f)
+		return 0;									// Eye is within its bounds: full detail.
+
+	float pixelsPerUnit = std::abs((*pProj)[1][1]) * 0.5f * viewportHigh * scale / (isPerspective ? distance : 1.0f);
+
+	uint32_t selected = 0;
+	for (uint32_t level = 1; level <= mesh.lods.size(); ++level) {
+		float tolerance = level > current ? pixelTolerance * (1.0f - hysteresis) : pixelTolerance;
+		if (mesh.lods[level - 1].error * pixelsPerUnit > tolerance)
+			break;
+		selected = level;
+	}
+	return selected;
+}
@@ -0,0 +1,36 @@
+//
+// LevelOfDetail.h
+//	VulkanModule AddOns
+//
+// Choose, each frame, which of a mesh's levels of detail (see MeshObject.lods) a renderable draws:
+//	the coarsest whose error, projected to the screen from the renderable's nearest bounds, still
+//	stays within pixelTolerance.  So detail falls off with distance and with the projection's
+//	field of view alike, and a level's error, not a hand-tuned distance, decides where it switches.
+//
+// To keep levels from flickering back and forth at a boundary, stepping to a coarser level requires
+//	its error to be a further hysteresis fraction below tolerance; stepping finer does not.
+//
+// Renderables need model, view and projection matrices (as for depth sorting and occlusion culling);
+//	those without keep their last level.  Tune it via command.levelOfDetail, e.g.:
+//		vulkan.command.levelOfDetail.pixelTolerance = 2.0f;		// (coarser, for weaker GPUs)
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef LevelOfDetail_h
+#define LevelOfDetail_h
+
+#include "VulkanPlatform.h"
+
+struct iRenderable;
+
+
+struct LODSelector
+{
+	float	pixelTolerance = 1.0f;		// Most on-screen error, in pixels, a level may show.
+	float	hysteresis	   = 0.25f;		// Fraction further below it to step coarser.
+
+	uint32_t Select(iRenderable& renderable, float viewportHigh) const;
+};
+
+#endif	// LevelOfDetail_h
@@ -24,6 +24,17 @@
 class PrimitiveBuffer;
 
 
+// A coarser level of detail: a sub-range of the mesh's own index array (so of its index buffer), plus
+//	how far, in model-space units, this level's surface strays from full detail at most.
+//
+struct MeshLOD
+{
+	uint32_t	firstIndex;
+	uint32_t	indexCount;
+	float		error;
+};
+
+
 struct MeshObject
 {
 	VertexAbstract&	vertexType;
@@ -47,18 +58,70 @@ struct MeshObject
 	uint32_t		instanceCount = 1;		// (while these are shared between
 	uint32_t		firstInstance = 0;		//	Vertex Buffer and Index Buffer)
 
+	void*			instances	  = nullptr;	// Optional per-instance data, instanceCount of them, if vertexType
+												//	describes INSTANCE_BINDING (see InstancedVertexDescription).
+
+	vec3			boundsMin	  = vec3(0.0f);	// Model-space axis-aligned bounding box of all vertices,
+	vec3			boundsMax	  = vec3(0.0f);	//	valid only if hasBounds (see computeBounds below).
+	bool			hasBounds	  = false;
+
+	vector<MeshLOD>	lods;					// Optional, indexed meshes only: coarser levels, finest first, each
+											//	with greater error.  Full detail (indexCount above) is level 0.
+
 
 	VkDeviceSize vertexBufferSize() {
 		return vertexCount * vertexType.byteSize();
 	}
 
 	VkDeviceSize indexBufferSize() {
-		return indexCount * MeshIndexByteSizes[indexType];
+		return indicesStored() * MeshIndexByteSizes[indexType];
+	}
+
+	// Number of indices the index array holds: all levels of detail, wherever they lie within it.
+	uint32_t indicesStored() {
+		uint32_t nIndices = indexCount;
+		for (MeshLOD& lod : lods)
+			if (lod.firstIndex + lod.indexCount > nIndices)
+				nIndices = lod.firstIndex + lod.indexCount;
+		return nIndices;
+	}
+
+	// Index range drawn at a level of detail (0, or beyond the coarsest, being full detail).
+	MeshLOD lodRange(uint32_t level) {
+		if (level == 0 || level > lods.size())
+			return { firstIndex, indexCount, 0.0f };
+		return lods[level - 1];
+	}
+
+	VkDeviceSize instanceBufferSize() {
+		return instanceCount * vertexType.instanceByteSize();
 	}
 
 	bool isUndefined() {
 		return vertices == nullptr || vertexCount == 0;
 	}
+
+	// Scan the vertices for their extent, provided their first attribute is a vec3 position (as is
+	//	the case for every Vertex3D type).  Returns false, leaving hasBounds unset, if not.
+	bool computeBounds() {
+		hasBounds = false;
+		if (isUndefined() || vertexType.nAttributeDescriptions() == 0)
+			return false;
+
+		const VkVertexInputAttributeDescription& position = vertexType.pAttributeDescriptions()[0];
+		if (position.format != VK_FORMAT_R32G32B32_SFLOAT || position.binding != VERTEX_BINDING)
+			return false;
+
+		size_t stride = vertexType.byteSize();
+		const uint8_t* pPosition = (const uint8_t*) vertices + position.offset;
+		boundsMin = boundsMax = *(const vec3*) pPosition;
+		for (uint32_t iVertex = 1; iVertex < vertexCount; ++iVertex) {
+			const vec3& point = *(const vec3*) (pPosition + iVertex * stride);
+			boundsMin = glm::min(boundsMin, point);
+			boundsMax = glm::max(boundsMax, point);
+		}
+		return hasBounds = true;
+	}
 };
 
 #endif // MeshObject_h
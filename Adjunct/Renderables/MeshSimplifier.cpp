@@ -0,0 +1,529 @@
+//
+// MeshSimplifier.cpp
+//	VulkanModule AddOns
+//
+// See header file comment for overview.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "MeshSimplifier.h"
+#include "FileSystem.h"
+#include "Helpers.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cfloat>
+
+
+const char		CacheMagic[4] = { 'V', 'L', 'O', 'D' };
+const uint32_t	CacheVersion  = 1;
+
+
+static int floatsInFormat(VkFormat format)
+{
+	switch (format) {
+		case VK_FORMAT_R32_SFLOAT:			return 1;
+		case VK_FORMAT_R32G32_SFLOAT:		return 2;
+		case VK_FORMAT_R32G32B32_SFLOAT:	return 3;
+		case VK_FORMAT_R32G32B32A32_SFLOAT:	return 4;
+		default:							return 0;	// (not a float attribute: ignored)
+	}
+}
+
+static uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+	return a < b ? ((uint64_t) a << 32) | b : ((uint64_t) b << 32) | a;
+}
+
+
+#pragma mark - Quadric
+
+void MeshSimplifier::Quadric::addPlane(const vec3& normal, float distance, double area)
+{
+	double a = normal.x, b = normal.y, c = normal.z, d = distance;
+
+	a2 += area * a * a;	 ab += area * a * b;  ac += area * a * c;  ad += area * a * d;
+	b2 += area * b * b;	 bc += area * b * c;  bd += area * b * d;
+	c2 += area * c * c;	 cd += area * c * d;
+	d2 += area * d * d;
+	weight += area;
+}
+
+void MeshSimplifier::Quadric::operator += (const Quadric& other)
+{
+	a2 += other.a2;	 ab += other.ab;  ac += other.ac;  ad += other.ad;
+	b2 += other.b2;	 bc += other.bc;  bd += other.bd;
+	c2 += other.c2;	 cd += other.cd;
+	d2 += other.d2;
+	weight += other.weight;
+}
+
+// Sum of (area-weighted) squared distances of point from every plane added.
+//
+double MeshSimplifier::Quadric::evaluate(const vec3& point) const
+{
+	double x = point.x, y = point.y, z = point.z;
+
+	return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+		 + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+		 + c2 * z * z + 2 * cd * z
+		 + d2;
+}
+
+
+#pragma mark - MeshSimplifier
+
+void MeshSimplifier::GenerateLODs(const vector<float>& ratios, const string& modelFileName)
+{
+	if (mesh.isUndefined() || ! mesh.indices || mesh.indexCount < 3) {
+		Log(WARN, "MeshSimplifier: mesh has no indexed triangles to simplify.");
+		return;
+	}
+
+	uint64_t hash = sourceHash(ratios);
+	string cachePath = modelFileName.empty() ? "" : FileSystem::ModelFileFullPath(modelFileName) + CACHE_EXTENSION;
+
+	vector<uint32_t> lodIndices;
+	vector<MeshLOD>	 lods;
+
+	if (! cachePath.empty() && readCache(cachePath, hash, lodIndices, lods)) {
+		storeIndices(lodIndices, lods);
+		return;
+	}
+
+	if (! readVertices())
+		return;
+	vector<uint32_t> indices;
+	readIndices(indices);
+	buildTopology(indices);
+
+	simplify(ratios, lodIndices, lods);
+
+	positions = {};  attributes = {};  triangles = {};  isTriangleAlive = {};	// (release working state)
+	vertexTriangles = {};  quadrics = {};  versions = {};  isLocked = {};  isCollapsed = {};
+
+	storeIndices(lodIndices, lods);
+	if (! cachePath.empty())
+		writeCache(cachePath, hash, lodIndices, lods);
+}
+
+// Gather positions and any other float attributes, relative to vertexOffset as indices are.
+//
+bool MeshSimplifier::readVertices()
+{
+	VertexAbstract& vertexType = mesh.vertexType;
+	const VkVertexInputAttributeDescription* pAttributes = vertexType.pAttributeDescriptions();
+
+	if (vertexType.nAttributeDescriptions() == 0 || pAttributes[0].format != VK_FORMAT_R32G32B32_SFLOAT
+		|| pAttributes[0].binding != VERTEX_BINDING) {
+		Log(WARN, "MeshSimplifier: vertex type's first attribute must be a vec3 position.");
+		return false;
+	}
+
+	struct FloatAttribute { uint32_t offset; int nFloats; };
+	vector<FloatAttribute> floatAttributes;
+	nAttributeFloats = 0;
+	for (uint32_t iAttr = 1; iAttr < vertexType.nAttributeDescriptions(); ++iAttr) {
+		int nFloats = floatsInFormat(pAttributes[iAttr].format);
+		if (pAttributes[iAttr].binding == VERTEX_BINDING && nFloats > 0) {
+			floatAttributes.push_back({ pAttributes[iAttr].offset, nFloats });
+			nAttributeFloats += nFloats;
+		}
+	}
+
+	uint32_t firstVertex = (uint32_t) std::max(mesh.vertexOffset, 0);
+	uint32_t nVertices	 = mesh.vertexCount > firstVertex ? mesh.vertexCount - firstVertex : 0;
+	size_t stride = vertexType.byteSize();
+
+	positions.resize(nVertices);
+	attributes.resize((size_t) nVertices * nAttributeFloats);
+
+	const uint8_t* pVertex = (const uint8_t*) mesh.vertices + firstVertex * stride;
+	for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex, pVertex += stride) {
+		memcpy(&positions[iVertex], pVertex + pAttributes[0].offset, sizeof(vec3));
+
+		float* pFloats = &attributes[(size_t) iVertex * nAttributeFloats];
+		for (FloatAttribute& attribute : floatAttributes) {
+			memcpy(pFloats, pVertex + attribute.offset, attribute.nFloats * sizeof(float));
+			pFloats += attribute.nFloats;
+		}
+	}
+
+	vec3 lowest(FLT_MAX), highest(-FLT_MAX);
+	for (vec3& position : positions) {
+		lowest	= glm::min(lowest, position);
+		highest	= glm::max(highest, position);
+	}
+	meshSize = nVertices > 0 ? glm::length(highest - lowest) : 0.0f;
+	return true;
+}
+
+void MeshSimplifier::readIndices(vector<uint32_t>& indices)
+{
+	indices.resize(mesh.indexCount);
+	for (uint32_t iIndex = 0; iIndex < mesh.indexCount; ++iIndex)
+		indices[iIndex] = mesh.indexType == MESH_SMALL_INDEX
+						? ((const uint16_t*) mesh.indices)[mesh.firstIndex + iIndex]
+						: ((const uint32_t*) mesh.indices)[mesh.firstIndex + iIndex];
+}
+
+// Weld exact duplicates, lock seams, collect each vertex's triangles, and sum its quadric:
+//	its triangles' planes, plus for an open border edge, a plane perpendicular to it.
+//
+void MeshSimplifier::buildTopology(const vector<uint32_t>& indices)
+{
+	uint32_t nVertices = (uint32_t) positions.size();
+	size_t	 vertexBytes = nAttributeFloats * sizeof(float);
+
+	auto isSameVertex = [&](uint32_t lhs, uint32_t rhs) {
+		return positions[lhs] == positions[rhs]
+			&& (vertexBytes == 0 || memcmp(&attributes[(size_t) lhs * nAttributeFloats],
+										   &attributes[(size_t) rhs * nAttributeFloats], vertexBytes) == 0);
+	};
+
+	// Exact duplicates (same position and attributes) become one; then any position still shared by
+	//	several vertices is a seam, whose vertices must stay put for the attributes either side of it.
+	vector<uint32_t> welded(nVertices);
+	std::unordered_map<uint64_t, uint32_t> firstOfVertex, firstAtPosition;
+	isLocked.assign(nVertices, false);
+
+	for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+		uint64_t positionHash = hashBytes(&positions[iVertex], sizeof(vec3));
+		uint64_t vertexHash	  = vertexBytes ? hashBytes(&attributes[(size_t) iVertex * nAttributeFloats],
+														vertexBytes, positionHash) : positionHash;
+
+		auto [found, isNew] = firstOfVertex.try_emplace(vertexHash, iVertex);
+		welded[iVertex] = (! isNew && isSameVertex(found->second, iVertex)) ? found->second : iVertex;
+		if (welded[iVertex] != iVertex)
+			continue;
+
+		auto [atPosition, isFirst] = firstAtPosition.try_emplace(positionHash, iVertex);
+		if (! isFirst && positions[atPosition->second] == positions[iVertex])
+			isLocked[iVertex] = isLocked[atPosition->second] = true;
+	}
+
+	vertexTriangles.assign(nVertices, {});
+	quadrics.assign(nVertices, Quadric {});
+	versions.assign(nVertices, 0);
+	isCollapsed.assign(nVertices, false);
+	triangles.clear();
+
+	std::unordered_map<uint64_t, uint32_t> edgeUses;
+
+	for (size_t iIndex = 0; iIndex + 2 < indices.size(); iIndex += 3) {
+		std::array<uint32_t, 3> corners = { welded[indices[iIndex]], welded[indices[iIndex + 1]],
+											welded[indices[iIndex + 2]] };
+		if (corners[0] >= nVertices || corners[1] >= nVertices || corners[2] >= nVertices
+			|| corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+			continue;		// (degenerate, or out of range: drop)
+
+		uint32_t iTriangle = (uint32_t) triangles.size();
+		triangles.push_back(corners);
+
+		vec3 cross = glm::cross(positions[corners[1]] - positions[corners[0]],
+								positions[corners[2]] - positions[corners[0]]);
+		float length = glm::length(cross);
+		vec3 normal = length > 0.0f ? cross / length : vec3(0.0f);
+
+		for (int iCorner = 0; iCorner < 3; ++iCorner) {
+			vertexTriangles[corners[iCorner]].push_back(iTriangle);
+			if (length > 0.0f)
+				quadrics[corners[iCorner]].addPlane(normal, -glm::dot(normal, positions[corners[0]]), 0.5 * length);
+			++edgeUses[edgeKey(corners[iCorner], corners[(iCorner + 1) % 3])];
+		}
+	}
+	isTriangleAlive.assign(triangles.size(), true);
+	nTrianglesAlive = (uint32_t) triangles.size();
+
+	for (std::array<uint32_t, 3>& corners : triangles) {
+		vec3 triangleNormal = glm::cross(positions[corners[1]] - positions[corners[0]],
+										 positions[corners[2]] - positions[corners[0]]);
+		for (int iCorner = 0; iCorner < 3; ++iCorner) {
+			uint32_t from = corners[iCorner], to = corners[(iCorner + 1) % 3];
+			if (edgeUses[edgeKey(from, to)] != 1)
+				continue;
+
+			vec3 edge = positions[to] - positions[from];
+			vec3 outward = glm::cross(edge, triangleNormal);
+			float length = glm::length(outward);
+			if (length == 0.0f)
+				continue;
+			outward /= length;
+			double weight = BORDER_WEIGHT * glm::dot(edge, edge);
+			quadrics[from].addPlane(outward, -glm::dot(outward, positions[from]), weight);
+			quadrics[to].addPlane(outward, -glm::dot(outward, positions[from]), weight);
+		}
+	}
+}
+
+// Collapse the cheapest edges until each ratio's triangle count is reached, in turn from the
+//	finest, snapshotting each level's triangles.  Stops early if collapses run out.
+//
+void MeshSimplifier::simplify(const vector<float>& ratios, vector<uint32_t>& lodIndices, vector<MeshLOD>& lods)
+{
+	CollapseQueue queue;
+	for (uint32_t iVertex = 0; iVertex < positions.size(); ++iVertex)
+		pushCollapses(iVertex, queue);
+
+	vector<float> descending = ratios;
+	std::sort(descending.begin(), descending.end(), std::greater<float>());
+
+	uint32_t nFullDetail = nTrianglesAlive;
+	uint32_t nPrevious	 = nFullDetail;
+	double	 maxDistanceSquared = 0.0;
+
+	for (float ratio : descending) {
+		uint32_t target = (uint32_t) (std::clamp(ratio, 0.0f, 1.0f) * nFullDetail);
+
+		while (nTrianglesAlive > target && ! queue.empty()) {
+			Collapse next = queue.top();
+			queue.pop();
+			if (isCollapsed[next.from] || isCollapsed[next.to] || next.fromVersion != versions[next.from]
+				|| next.toVersion != versions[next.to] || ! isCollapseValid(next.from, next.to))
+				continue;
+
+			Quadric merged = quadrics[next.from];
+			merged += quadrics[next.to];
+			if (merged.weight > 0.0)
+				maxDistanceSquared = std::max(maxDistanceSquared, merged.evaluate(positions[next.to]) / merged.weight);
+
+			collapse(next.from, next.to);
+			pushCollapses(next.to, queue);
+		}
+
+		if (nTrianglesAlive >= nPrevious)	// (nothing more will collapse)
+			break;
+		nPrevious = nTrianglesAlive;
+
+		lods.push_back({ (uint32_t) lodIndices.size(), 3 * nTrianglesAlive, (float) std::sqrt(maxDistanceSquared) });
+		for (uint32_t iTriangle = 0; iTriangle < triangles.size(); ++iTriangle)
+			if (isTriangleAlive[iTriangle])
+				lodIndices.insert(lodIndices.end(), triangles[iTriangle].begin(), triangles[iTriangle].end());
+	}
+}
+
+// Move vertex "from" onto "to": triangles spanning both vanish, the rest of from's now use to.
+//
+void MeshSimplifier::collapse(uint32_t from, uint32_t to)
+{
+	for (uint32_t iTriangle : vertexTriangles[from]) {
+		if (! isTriangleAlive[iTriangle])
+			continue;
+		std::array<uint32_t, 3>& corners = triangles[iTriangle];
+		if (std::find(corners.begin(), corners.end(), to) != corners.end()) {
+			isTriangleAlive[iTriangle] = false;
+			--nTrianglesAlive;
+		} else {
+			*std::find(corners.begin(), corners.end(), from) = to;
+			vertexTriangles[to].push_back(iTriangle);
+		}
+	}
+	std::erase_if(vertexTriangles[to], [this](uint32_t iTriangle) { return ! isTriangleAlive[iTriangle]; });
+	vertexTriangles[from].clear();
+
+	quadrics[to] += quadrics[from];
+	isCollapsed[from] = true;
+	++versions[to];
+}
+
+// Refuse collapses that would flip or flatten a triangle, or pinch the surface into a
+//	non-manifold one: the edge's two ends may share no neighbors but the triangles spanning it.
+//
+bool MeshSimplifier::isCollapseValid(uint32_t from, uint32_t to)
+{
+	vector<uint32_t> spanningOpposites, fromNeighbors;
+
+	for (uint32_t iTriangle : vertexTriangles[from]) {
+		if (! isTriangleAlive[iTriangle])
+			continue;
+		std::array<uint32_t, 3>& corners = triangles[iTriangle];
+
+		bool spansEdge = std::find(corners.begin(), corners.end(), to) != corners.end();
+		for (uint32_t corner : corners)
+			if (corner != from && corner != to)
+				(spansEdge ? spanningOpposites : fromNeighbors).push_back(corner);
+		if (spansEdge)
+			continue;
+
+		vec3 moved[3];
+		for (int iCorner = 0; iCorner < 3; ++iCorner)
+			moved[iCorner] = positions[corners[iCorner] == from ? to : corners[iCorner]];
+		vec3 before = glm::cross(positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+		vec3 after	= glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+		if (glm::dot(before, after) <= 0.0f)
+			return false;
+	}
+	if (spanningOpposites.empty())
+		return false;		// (no longer an edge)
+
+	for (uint32_t iTriangle : vertexTriangles[to]) {
+		if (! isTriangleAlive[iTriangle])
+			continue;
+		for (uint32_t corner : triangles[iTriangle])
+			if (corner != to && corner != from
+				&& std::find(fromNeighbors.begin(), fromNeighbors.end(), corner) != fromNeighbors.end()
+				&& std::find(spanningOpposites.begin(), spanningOpposites.end(), corner) == spanningOpposites.end())
+				return false;
+	}
+	return true;
+}
+
+// Squared distance moved off the surface (normalized by the area the quadrics represent), plus the
+//	attribute difference charged as distance.
+//
+double MeshSimplifier::collapseCost(uint32_t from, uint32_t to)
+{
+	Quadric merged = quadrics[from];
+	merged += quadrics[to];
+	double cost = merged.weight > 0.0 ? merged.evaluate(positions[to]) / merged.weight : 0.0;
+
+	double difference = 0.0;
+	for (uint32_t iFloat = 0; iFloat < nAttributeFloats; ++iFloat) {
+		double delta = attributes[(size_t) from * nAttributeFloats + iFloat]
+					 - attributes[(size_t) to * nAttributeFloats + iFloat];
+		difference += delta * delta;
+	}
+	double attributeScale = attributeWeight * meshSize;
+	return cost + attributeScale * attributeScale * difference;
+}
+
+void MeshSimplifier::pushCollapses(uint32_t vertex, CollapseQueue& queue)
+{
+	vector<uint32_t> neighbors;
+	for (uint32_t iTriangle : vertexTriangles[vertex])
+		if (isTriangleAlive[iTriangle])
+			for (uint32_t corner : triangles[iTriangle])
+				if (corner != vertex && std::find(neighbors.begin(), neighbors.end(), corner) == neighbors.end())
+					neighbors.push_back(corner);
+
+	for (uint32_t neighbor : neighbors) {
+		if (! isLocked[vertex])
+			queue.push({ collapseCost(vertex, neighbor), vertex, neighbor, versions[vertex], versions[neighbor] });
+		if (! isLocked[neighbor])
+			queue.push({ collapseCost(neighbor, vertex), neighbor, vertex, versions[neighbor], versions[vertex] });
+	}
+}
+
+
+#pragma mark - Storage and Cache
+
+// Rebuild the index array as full detail's indices (as much of the original array as precedes and
+//	includes them) followed by each level's, and point the mesh at it.  Replaces any prior lods.
+//
+void MeshSimplifier::storeIndices(const vector<uint32_t>& lodIndices, const vector<MeshLOD>& lods)
+{
+	size_t indexSize = MeshIndexByteSizes[mesh.indexType];
+	uint32_t base = mesh.firstIndex + mesh.indexCount;
+
+	vector<uint8_t> combined((base + lodIndices.size()) * indexSize);
+	memcpy(combined.data(), mesh.indices, base * indexSize);
+
+	for (size_t iIndex = 0; iIndex < lodIndices.size(); ++iIndex) {
+		uint8_t* pIndex = &combined[(base + iIndex) * indexSize];
+		if (mesh.indexType == MESH_SMALL_INDEX) {
+			uint16_t index = (uint16_t) lodIndices[iIndex];
+			memcpy(pIndex, &index, sizeof(index));
+		} else
+			memcpy(pIndex, &lodIndices[iIndex], sizeof(uint32_t));
+	}
+	indexStorage.swap(combined);		// (mesh.indices may have pointed into the old one)
+
+	mesh.indices = indexStorage.data();
+	mesh.lods = lods;
+	for (MeshLOD& lod : mesh.lods)
+		lod.firstIndex += base;
+}
+
+// Identifies what the cache was generated from, so a changed model or request regenerates it.
+//
+uint64_t MeshSimplifier::sourceHash(const vector<float>& ratios)
+{
+	uint64_t hash = hashBytes(mesh.vertices, (size_t) mesh.vertexBufferSize());
+	hash = hashBytes((const uint8_t*) mesh.indices + mesh.firstIndex * MeshIndexByteSizes[mesh.indexType],
+					 mesh.indexCount * MeshIndexByteSizes[mesh.indexType], hash);
+	hash = hashBytes(ratios.data(), ratios.size() * sizeof(float), hash);
+	hash = hashBytes(&attributeWeight, sizeof(attributeWeight), hash);
+	hashCombine(hash, ((uint64_t) CacheVersion << 32) | mesh.indexType);
+	return hash;
+}
+
+// Layout: magic, version, hash, number of levels, MeshLOD per level (firstIndex relative to the
+//	first level's), number of indices, then the indices as uint32_t.  Counts that the file is too short
+//	for, or that the mesh couldn't have simplified to (each level fewer indices than it has), or indices
+//	past its vertices (relative to vertexOffset, as its own are), discard it.
+//
+bool MeshSimplifier::readCache(const string& cachePath, uint64_t hash, vector<uint32_t>& lodIndices,
+							   vector<MeshLOD>& lods)
+{
+	ifstream file(cachePath, std::ios::binary | std::ios::ate);
+	if (! file.is_open())
+		return false;
+	uint64_t fileSize = (uint64_t) file.tellg();
+	file.seekg(0);
+
+	char	 magic[4];
+	uint32_t version = 0, nLods = 0, nIndices = 0;
+	uint64_t cachedHash = 0;
+	file.read(magic, sizeof(magic));
+	file.read((char*) &version, sizeof(version));
+	file.read((char*) &cachedHash, sizeof(cachedHash));
+	file.read((char*) &nLods, sizeof(nLods));
+	if (! file || memcmp(magic, CacheMagic, sizeof(magic)) != 0 || version != CacheVersion || cachedHash != hash)
+		return false;
+
+	auto discard = [&cachePath](StrPtr reason) {
+		Log(WARN, "MeshSimplifier: discarding LOD cache %s (%s)", cachePath.c_str(), reason);
+		return false;
+	};
+	uint64_t headerSize = sizeof(magic) + sizeof(version) + sizeof(cachedHash) + sizeof(nLods);
+	if ((uint64_t) nLods * sizeof(MeshLOD) + sizeof(nIndices) > fileSize - headerSize)
+		return discard("truncated");
+
+	lods.resize(nLods);
+	file.read((char*) lods.data(), nLods * sizeof(MeshLOD));
+	file.read((char*) &nIndices, sizeof(nIndices));
+	if (! file)
+		return false;
+	if ((uint64_t) nIndices * sizeof(uint32_t) > fileSize - headerSize - nLods * sizeof(MeshLOD) - sizeof(nIndices))
+		return discard("truncated");
+	if ((uint64_t) nIndices > (uint64_t) nLods * mesh.indexCount)
+		return discard("more indices than the mesh has");
+
+	for (MeshLOD& lod : lods)
+		if ((size_t) lod.firstIndex + lod.indexCount > nIndices || lod.indexCount > mesh.indexCount)
+			return discard("level out of range");
+
+	lodIndices.resize(nIndices);
+	file.read((char*) lodIndices.data(), nIndices * sizeof(uint32_t));
+	if (! file)
+		return false;
+
+	uint32_t firstVertex = (uint32_t) std::max(mesh.vertexOffset, 0);
+	uint32_t nVertices	 = mesh.vertexCount > firstVertex ? mesh.vertexCount - firstVertex : 0;
+	for (uint32_t index : lodIndices)
+		if (index >= nVertices)
+			return discard("index out of range");
+
+	if (LogLimit(LOW))
+		Log(RAW, "Read: LOD cache - file: %s", cachePath.c_str());
+	return true;
+}
+
+void MeshSimplifier::writeCache(const string& cachePath, uint64_t hash, const vector<uint32_t>& lodIndices,
+								const vector<MeshLOD>& lods)
+{
+	ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+
+	uint32_t nLods = (uint32_t) lods.size(), nIndices = (uint32_t) lodIndices.size();
+	file.write(CacheMagic, sizeof(CacheMagic));
+	file.write((const char*) &CacheVersion, sizeof(CacheVersion));
+	file.write((const char*) &hash, sizeof(hash));
+	file.write((const char*) &nLods, sizeof(nLods));
+	file.write((const char*) lods.data(), nLods * sizeof(MeshLOD));
+	file.write((const char*) &nIndices, sizeof(nIndices));
+	file.write((const char*) lodIndices.data(), nIndices * sizeof(uint32_t));
+
+	if (! file)		// (e.g. read-only install: simply regenerate next time)
+		Log(WARN, "MeshSimplifier: could not write LOD cache %s", cachePath.c_str());
+}
@@ -0,0 +1,105 @@
+//
+// MeshSimplifier.h
+//	VulkanModule AddOns
+//
+// Generate a mesh's levels of detail (see MeshObject.lods) by simplifying it on the CPU, offline
+//	in the sense of at load time, and cached so that only the first load pays for it.
+//
+// Simplification repeatedly collapses the edge that least changes the surface, as measured by quadric
+//	error metrics (Garland & Heckbert): each vertex accumulates the planes of its triangles, so the
+//	squared distance from those planes of wherever it moves to is cheap to evaluate.  Collapses are
+//	"half-edge," moving one vertex onto a neighbor, so every level reuses the mesh's own vertices and
+//	only its index array grows.  Costs are attribute-aware: moving onto a neighbor whose normal, UV or
+//	color differs is charged as though it moved that much farther, scaled by attributeWeight.  Open
+//	borders are held in place by planes perpendicular to them, UV/normal seams (vertices sharing a
+//	position but not attributes) never move, and no collapse may flip a triangle over.
+//
+// Works with any vertex type whose first attribute is a vec3 position (as every Vertex3D type's is),
+//	treating each further float attribute generically.  Usage, before the mesh's renderable is created:
+//		MeshSimplifier simplifier(mesh);		// (must outlive the mesh's use: holds its new indices)
+//		simplifier.GenerateLODs({ 0.5f, 0.25f, 0.125f }, "teapot.obj");
+//	where ratios are of full detail's triangle count, and the model file name, if given, places the
+//	cache beside the model file (FileSystem::ModelFileFullPath) with suffix CACHE_EXTENSION.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef MeshSimplifier_h
+#define MeshSimplifier_h
+
+#include "VulkanPlatform.h"
+#include "MeshObject.h"
+#include <array>
+#include <queue>
+#include <functional>
+
+
+class MeshSimplifier
+{
+public:
+	MeshSimplifier(MeshObject& mesh) : mesh(mesh)	{ }
+
+	static constexpr const char* CACHE_EXTENSION = ".lod";
+
+	float	attributeWeight = 0.05f;	// Distance, as a fraction of the mesh's size, that an attribute
+										//	difference of 1 (e.g. normals 60° apart) is charged as.
+	static constexpr float BORDER_WEIGHT = 10.0f;	// (relative to triangle planes, holding open edges in place)
+
+		// MEMBERS
+private:
+	MeshObject&			mesh;
+	vector<uint8_t>		indexStorage;		// Full detail's indices, then each level's; mesh.indices points here.
+
+	// Working state of one simplification.
+	struct Quadric {
+		double	a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;		// symmetric 4x4, upper triangle
+		double	weight;										// (total area, to normalize error to distance)
+
+		void	addPlane(const vec3& normal, float distance, double area);
+		void	operator += (const Quadric& other);
+		double	evaluate(const vec3& point) const;
+	};
+	struct Collapse {
+		double		cost;
+		uint32_t	from, to;
+		uint32_t	fromVersion, toVersion;
+		bool operator > (const Collapse& other) const { return cost > other.cost; }
+	};
+
+	vector<vec3>				positions;		// (indexed as the mesh's indices are, i.e. after vertexOffset)
+	vector<float>				attributes;		// nAttributeFloats per vertex
+	uint32_t					nAttributeFloats = 0;
+	float						meshSize = 0.0f;
+
+	vector<std::array<uint32_t, 3>>	triangles;
+	vector<bool>				isTriangleAlive;
+	uint32_t					nTrianglesAlive = 0;
+	vector<vector<uint32_t>>	vertexTriangles;	// Triangles each vertex is a corner of.
+	vector<Quadric>				quadrics;
+	vector<uint32_t>			versions;			// Bumped whenever a vertex's quadric or neighborhood changes.
+	vector<bool>				isLocked;
+	vector<bool>				isCollapsed;
+
+		// METHODS
+public:
+	void	GenerateLODs(const vector<float>& ratios, const string& modelFileName = "");
+
+private:
+	bool	readVertices();
+	void	readIndices(vector<uint32_t>& indices);
+	void	buildTopology(const vector<uint32_t>& indices);
+	void	simplify(const vector<float>& ratios, vector<uint32_t>& lodIndices, vector<MeshLOD>& lods);
+	void	collapse(uint32_t from, uint32_t to);
+	bool	isCollapseValid(uint32_t from, uint32_t to);
+	double	collapseCost(uint32_t from, uint32_t to);
+	typedef std::priority_queue<Collapse, vector<Collapse>, std::greater<Collapse>>	CollapseQueue;
+	void	pushCollapses(uint32_t vertex, CollapseQueue& queue);
+
+	void	storeIndices(const vector<uint32_t>& lodIndices, const vector<MeshLOD>& lods);
+	uint64_t sourceHash(const vector<float>& ratios);
+	bool	readCache(const string& cachePath, uint64_t hash, vector<uint32_t>& lodIndices, vector<MeshLOD>& lods);
+	void	writeCache(const string& cachePath, uint64_t hash, const vector<uint32_t>& lodIndices,
+					   const vector<MeshLOD>& lods);
+};
+
+#endif	// MeshSimplifier_h
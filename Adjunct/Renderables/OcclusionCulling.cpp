@@ -0,0 +1,258 @@
+//
+// OcclusionCulling.cpp
+//	VulkanModule AddOns
+//
+// See header file comment for overview.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "OcclusionCulling.h"
+#include "CommandObjects.h"
+#include "VertexDescription.h"
+#include <algorithm>
+#include <cstring>
+
+
+// Unit cube, corners 0 to 1, which boxToClip stretches over a mesh's bounds.
+//	(winding is moot, as the proxy pipeline culls no faces)
+//
+static Vertex3D CubeCorners[] = {
+	{{ 0, 0, 0 }}, {{ 1, 0, 0 }}, {{ 1, 1, 0 }}, {{ 0, 1, 0 }},
+	{{ 0, 0, 1 }}, {{ 1, 0, 1 }}, {{ 1, 1, 1 }}, {{ 0, 1, 1 }}
+};
+static IndexBufferDefaultIndexType CubeIndices[] = {
+	0, 1, 2,  2, 3, 0,		// -Z
+	4, 6, 5,  6, 4, 7,		// +Z
+	0, 4, 5,  5, 1, 0,		// -Y
+	3, 2, 6,  6, 7, 3,		// +Y
+	0, 3, 7,  7, 4, 0,		// -X
+	1, 5, 6,  6, 2, 1		// +X
+};
+static VertexDescription<Vertex3D> CubeVertexType;
+
+static MeshObject CubeMesh = {
+	CubeVertexType,
+	CubeCorners, N_ELEMENTS_IN_ARRAY(CubeCorners)
+};
+
+// Depth-test only: LEQUAL so a box flush against an occluder counts as seen.
+const Customizer ProxyCustomize = AUTO_INSTANCE | SHOW_BACKFACES | DEPTH_LEQUAL
+								| DISABLE_DEPTH_WRITE | DISABLE_COLOR_WRITE;
+
+
+#pragma mark - OcclusionQueryPool
+
+OcclusionQueryPool::~OcclusionQueryPool()
+{
+	destroy();
+}
+
+void OcclusionQueryPool::destroy()
+{
+	if (vkQueryPool)
+		vkDestroyQueryPool(CommandControl::device().getLogical(), vkQueryPool, nullALLOC);
+	vkQueryPool = VK_NULL_HANDLE;
+}
+
+void OcclusionQueryPool::create()
+{
+	VkQueryPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.queryType			= VK_QUERY_TYPE_OCCLUSION,
+		.queryCount			= MAX_QUERIES * nRanges,
+		.pipelineStatistics	= 0
+	};
+
+	call = vkCreateQueryPool(CommandControl::device().getLogical(), &poolInfo, nullALLOC, &vkQueryPool);
+
+	if (call != VK_SUCCESS)
+		Fatal("Create Query Pool FAILURE" + ErrStr(call));
+}
+
+// Called before this frame re-records, so its prior submission is complete: results are available
+//	without VK_QUERY_RESULT_WAIT_BIT.  Any that aren't (e.g. recorded but never submitted) are skipped,
+//	unless another range saw it.  (The pool is recreated if the number of ranges changed.)
+//
+void OcclusionQueryPool::Harvest(OcclusionCulling* pCulling, uint32_t numRanges)
+{
+	uint32_t nQueries = (uint32_t) queried.size();
+
+	if (pCulling && nQueries > 0) {
+		results.resize(2 * nQueries * nRanges);
+		for (uint32_t iRange = 0; iRange < nRanges; ++iRange) {
+			uint64_t* pResults = &results[2 * nQueries * iRange];
+			call = vkGetQueryPoolResults(CommandControl::device().getLogical(), vkQueryPool,
+										 iRange * MAX_QUERIES, nQueries, 2 * nQueries * sizeof(uint64_t), pResults,
+										 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+			if (call != VK_SUCCESS && call != VK_NOT_READY) {	// (NOT_READY: only some are available)
+				Log(WARN, "Occlusion query results unreadable" + ErrStr(call));
+				memset(pResults, 0, 2 * nQueries * sizeof(uint64_t));
+			}
+		}
+
+		for (uint32_t iQuery = 0; iQuery < nQueries; ++iQuery) {
+			bool isSeen = false, isAllAvailable = true;
+			for (uint32_t iRange = 0; iRange < nRanges; ++iRange) {
+				const uint64_t* pResult = &results[2 * (nQueries * iRange + iQuery)];
+				if (pResult[1])
+					isSeen = isSeen || pResult[0] > 0;
+				else
+					isAllAvailable = false;
+			}
+			if (isSeen || isAllAvailable)
+				pCulling->Report(queried[iQuery], isSeen);
+		}
+	}
+	queried.clear();
+
+	numRanges = std::max(numRanges, 1u);
+	if (numRanges != nRanges) {
+		destroy();				// (recreated at next Allocate)
+		nRanges = numRanges;
+	}
+}
+
+uint32_t OcclusionQueryPool::Allocate(iRenderable* pRenderable)
+{
+	if (queried.size() >= MAX_QUERIES)
+		return NO_QUERY;
+
+	if (! vkQueryPool)
+		create();
+
+	queried.push_back(pRenderable);
+	return (uint32_t) queried.size() - 1;
+}
+
+void OcclusionQueryPool::CmdReset(VkCommandBuffer& commandBuffer, uint32_t iRange)
+{
+	if (! queried.empty())
+		vkCmdResetQueryPool(commandBuffer, vkQueryPool, iRange * MAX_QUERIES, (uint32_t) queried.size());
+}
+
+void OcclusionQueryPool::CmdBegin(VkCommandBuffer& commandBuffer, uint32_t query, uint32_t iRange)
+{
+	vkCmdBeginQuery(commandBuffer, vkQueryPool, iRange * MAX_QUERIES + query, 0);	// (not PRECISE: any sample passing will do)
+}
+
+void OcclusionQueryPool::CmdEnd(VkCommandBuffer& commandBuffer, uint32_t query, uint32_t iRange)
+{
+	vkCmdEndQuery(commandBuffer, vkQueryPool, iRange * MAX_QUERIES + query);
+}
+
+
+#pragma mark - OcclusionCulling
+
+OcclusionCulling::OcclusionCulling(ShaderModules& proxyShaders, VulkanSetup& vulkan)
+	:	shaderModules(proxyShaders)
+{
+	pPipeline = new GraphicsPipeline(shaderModules, vulkan.renderPass, vulkan.device,
+									 &CubeVertexType, nullptr, ProxyCustomize);
+	pPipeline->EnsureBuilt();		// (bound directly by RenderBatch, so can't be left compiling)
+
+	VkCommandPool& commandPool = CommandControl::vkPool();
+	pCubeVertices = new PrimitiveBuffer(CubeMesh, commandPool, vulkan.device);
+	pCubeIndices  = new PrimitiveBuffer(CubeIndices, N_ELEMENTS_IN_ARRAY(CubeIndices), commandPool, vulkan.device);
+}
+
+OcclusionCulling::~OcclusionCulling()
+{
+	delete pCubeIndices;
+	delete pCubeVertices;
+	delete pPipeline;
+
+	Log(DEAD, "Destroyed: OcclusionCulling");
+}
+
+void OcclusionCulling::BeginFrame()
+{
+	if (++frameCount % FORGET_AFTER_FRAMES == 0)
+		std::erase_if(visibility, [this](const auto& entry) {
+			return frameCount - entry.second.lastSeenFrame > FORGET_AFTER_FRAMES;
+		});
+}
+
+bool OcclusionCulling::BoxToClip(iRenderable* pRenderable, mat4& boxToClip)
+{
+	MeshObject& mesh = pRenderable->vertexObject;
+
+	if (! mesh.hasBounds || (pRenderable->customizer & (DYNAMIC_GEOMETRY | DISABLE_DEPTH_TEST)))
+		return false;
+
+	const mat4* pModel = pRenderable->modelMatrix();
+	const mat4* pView  = pRenderable->viewMatrix();
+	const mat4* pProj  = pRenderable->projectionMatrix();
+	if (! pModel || ! pView || ! pProj)
+		return false;
+
+	mat4 boxToModel = glm::scale(glm::translate(mat4(1.0f), mesh.boundsMin), mesh.boundsMax - mesh.boundsMin);
+	boxToClip = (*pProj) * (*pView) * (*pModel) * boxToModel;
+	return true;
+}
+
+// Also returns, for a candidate, the transform placing the unit cube over its bounds in clip space.
+//
+OcclusionCulling::Verdict OcclusionCulling::Classify(iRenderable* pRenderable, mat4& boxToClip)
+{
+	if (! BoxToClip(pRenderable, boxToClip))
+		return DRAW;
+
+	MeshObject& mesh = pRenderable->vertexObject;
+
+	Visibility& seen = visibility.try_emplace(pRenderable, Visibility{ &mesh, frameCount, 0 }).first->second;
+	if (seen.pMesh != &mesh)
+		seen = { &mesh, frameCount, 0 };
+	seen.lastSeenFrame = frameCount;
+
+	if (reachesNearPlane(boxToClip)) {
+		seen.nOccludedResults = 0;
+		return DRAW;
+	}
+	return seen.nOccludedResults >= OCCLUDED_RESULTS_TO_CULL ? QUERY_PROXY : DRAW_AND_QUERY;
+}
+
+// True if any box corner is behind the near plane (clip z < 0, given GLM_FORCE_DEPTH_ZERO_TO_ONE).
+//
+bool OcclusionCulling::reachesNearPlane(const mat4& boxToClip)
+{
+	for (int iCorner = 0; iCorner < 8; ++iCorner) {
+		vec4 corner = boxToClip * vec4(iCorner & 1, (iCorner >> 1) & 1, (iCorner >> 2) & 1, 1.0f);
+		if (corner.z < 0.0f || corner.w <= 0.0f)
+			return true;
+	}
+	return false;
+}
+
+void OcclusionCulling::Report(iRenderable* pRenderable, bool anySamplesPassed)
+{
+	auto found = visibility.find(pRenderable);		// (absent if forgotten since)
+	if (found == visibility.end())
+		return;
+
+	uint8_t& nOccluded = found->second.nOccludedResults;
+	if (anySamplesPassed)
+		nOccluded = 0;
+	else if (nOccluded < OCCLUDED_RESULTS_TO_CULL)
+		++nOccluded;
+}
+
+// Expects the instance buffer, holding each proxy's boxToClip from firstInstance on, bound at INSTANCE_BINDING.
+//
+void OcclusionCulling::CmdDrawProxies(VkCommandBuffer& commandBuffer, OcclusionQueryPool& queries, uint32_t iRange,
+									  const vector<OcclusionProxy>& proxies, uint32_t firstInstance)
+{
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->getVkPipeline());
+
+	VkDeviceSize offset = 0;
+	vkCmdBindVertexBuffers(commandBuffer, VERTEX_BINDING, 1, &pCubeVertices->getVk(), &offset);
+	vkCmdBindIndexBuffer(commandBuffer, pCubeIndices->getVk(), 0, VkIndexTypes[MeshDefaultIndexType]);
+
+	for (uint32_t iProxy = 0; iProxy < proxies.size(); ++iProxy) {
+		queries.CmdBegin(commandBuffer, proxies[iProxy].query, iRange);
+		vkCmdDrawIndexed(commandBuffer, N_ELEMENTS_IN_ARRAY(CubeIndices), 1, 0, 0, firstInstance + iProxy);
+		queries.CmdEnd(commandBuffer, proxies[iProxy].query, iRange);
+	}
+}
@@ -0,0 +1,137 @@
+//
+// OcclusionCulling.h
+//	VulkanModule AddOns
+//
+// Skip drawing renderables hidden behind others, via hardware occlusion queries.
+//	Each opaque renderable's draw is wrapped in a query.  Once none of its samples pass the depth test,
+//	rather than draw it, only its bounding box is drawn (depth-tested, writing neither depth nor color),
+//	also within a query, after all other opaque geometry.  When any sample of that box passes, the
+//	renderable draws again.
+//
+// Results are read back when the frame that issued them is next re-recorded; by then its previous
+//	submission has completed, so the CPU never waits on the GPU.  The price is that visibility lags by
+//	the number of frames in flight, so to hide that, it errs toward drawing:
+//	  - a result not yet available is ignored (so never culls),
+//	  - a renderable must be reported occluded OCCLUDED_RESULTS_TO_CULL times in a row to be culled,
+//	  - one whose box reaches the camera's near plane always draws, as its box can't be trusted then.
+//
+// Candidates are opaque-pass (pass == nullptr), individually drawn, static-geometry renderables that
+//	have model, view and projection matrices (e.g. UBO(UBO_MVP&), or a model UBO plus UBO(UBO_VP&)).
+//	As with ShadowPass, the app supplies the box shaders; a vertex shader like this one suffices:
+//		layout(location = 0) in vec3 inPosition;		// unit cube corner, 0 to 1
+//		layout(location = 1) in mat4 boxToClip;			//	(per-instance)
+//		void main() { gl_Position = boxToClip * vec4(inPosition, 1.0); }
+//	with an empty fragment shader.  Then enable it:  command.SetOcclusionCulling(&occlusionCulling);
+//	The app owns it, so deletes it along with its other device resources (e.g. upon TeardownForSleep).
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef OcclusionCulling_h
+#define OcclusionCulling_h
+
+#include "VulkanPlatform.h"
+#include "iRenderable.h"
+#include <unordered_map>
+
+class VulkanSetup;
+class OcclusionCulling;
+
+
+// A renderable culled last time: its bounding box is drawn instead, inside a query.
+//
+struct OcclusionProxy
+{
+	uint32_t	query;
+	mat4		boxToClip;		// (unit cube to clip space)
+};
+
+
+// One frame's queries: owned by that frame's RenderBatchManager, so reused only after that frame
+//	has completed, which is what lets Harvest read results without waiting.  Each command buffer it
+//	records (one per buffer set) gets a range of its own, so that none resets or overwrites another's;
+//	a renderable counts as seen if seen in any.
+//
+class OcclusionQueryPool
+{
+public:
+	OcclusionQueryPool() = default;
+	~OcclusionQueryPool();
+
+	static constexpr uint32_t MAX_QUERIES = 4096;		// per range (beyond which, renderables simply draw)
+	static constexpr uint32_t NO_QUERY	  = UINT32_MAX;
+
+		// MEMBERS
+private:
+	VkQueryPool				vkQueryPool = VK_NULL_HANDLE;
+	uint32_t				nRanges		= 1;	// (of MAX_QUERIES each)
+	vector<iRenderable*>	queried;		// Renderable whose draw (or box) each query measured.
+	vector<uint64_t>		results;		//	(sample count, availability) per query
+
+		// METHODS
+public:
+	// Report last use's results, then begin anew, for numRanges command buffers.
+	void	 Harvest(OcclusionCulling* pCulling, uint32_t numRanges);
+	uint32_t Allocate(iRenderable* pRenderable);	// Returns NO_QUERY if full.
+
+	// Into the command buffer of range iRange (its buffer set).
+	void	 CmdReset(VkCommandBuffer& commandBuffer, uint32_t iRange);		// (must precede the render pass)
+	void	 CmdBegin(VkCommandBuffer& commandBuffer, uint32_t query, uint32_t iRange);
+	void	 CmdEnd(VkCommandBuffer& commandBuffer, uint32_t query, uint32_t iRange);
+private:
+	void	 create();
+	void	 destroy();
+};
+
+
+class OcclusionCulling
+{
+public:
+	OcclusionCulling(ShaderModules& proxyShaders, VulkanSetup& vulkan);
+	~OcclusionCulling();
+
+	static constexpr uint8_t  OCCLUDED_RESULTS_TO_CULL = 2;
+	static constexpr uint32_t FORGET_AFTER_FRAMES	   = 256;	// Drop state of renderables not seen this long.
+
+	enum Verdict {
+		DRAW,				// not a candidate: draw, unqueried
+		DRAW_AND_QUERY,		// seen last time: draw, and query
+		QUERY_PROXY			// occluded last time: query its box instead
+	};
+
+		// MEMBERS
+private:
+	ShaderModules&		shaderModules;
+	GraphicsPipeline*	pPipeline;
+	PrimitiveBuffer*	pCubeVertices;
+	PrimitiveBuffer*	pCubeIndices;
+
+	struct Visibility {
+		const MeshObject*	pMesh;				// (to detect an address reused by a later renderable)
+		uint32_t			lastSeenFrame;
+		uint8_t				nOccludedResults;	// consecutive, up to OCCLUDED_RESULTS_TO_CULL
+	};
+	std::unordered_map<iRenderable*, Visibility>	visibility;
+	uint32_t	frameCount = 0;
+
+		// METHODS
+public:
+	void	BeginFrame();
+	Verdict	Classify(iRenderable* pRenderable, mat4& boxToClip);
+	void	Report(iRenderable* pRenderable, bool anySamplesPassed);
+
+	// Candidacy for occlusion testing, shared with HiZCulling: false if not a candidate, otherwise
+	//	also returns the transform placing the unit cube over its bounds in clip space.
+	static bool BoxToClip(iRenderable* pRenderable, mat4& boxToClip);
+
+	void	CmdDrawProxies(VkCommandBuffer& commandBuffer, OcclusionQueryPool& queries, uint32_t iRange,
+						   const vector<OcclusionProxy>& proxies, uint32_t firstInstance);
+private:
+	bool	reachesNearPlane(const mat4& boxToClip);
+
+		// getters
+public:
+	VkPipeline&	getVkPipeline()	{ return pPipeline->getVkPipeline(); }
+};
+
+#endif	// OcclusionCulling_h
@@ -9,10 +9,26 @@
 //
 #include "RenderBatch.h"
 #include "Renderable.h"
+#include "CommandObjects.h"
+#include <algorithm>
 
 
-vector<iRenderableBase*> RenderBatchManager::buildBatches(const vector<iRenderableBase*>& renderables)
+RenderBatchManager::~RenderBatchManager()
 {
+	delete pInstanceBuffer;
+}
+
+
+vector<iRenderableBase*> RenderBatchManager::buildBatches(const vector<iRenderableBase*>& renderables,
+														  float viewportHigh, uint32_t numBufferSets)
+{
+	// This frame's previous occlusion results are in by now (see OcclusionQueryPool::Harvest).
+	pHiZCulling		  = CommandControl::hiZCulling();
+	pOcclusionCulling = pHiZCulling ? nullptr : CommandControl::occlusionCulling();
+	occlusionQueries.Harvest(pOcclusionCulling, numBufferSets);
+	if (pOcclusionCulling)
+		pOcclusionCulling->BeginFrame();
+
 	clear();
 
 	vector<iRenderableBase*> selfManagedRenderables;
@@ -23,7 +39,12 @@ vector<iRenderableBase*> RenderBatchManager::buildBatches(const vector<iRenderab
 	// Group renderables by pass type AND pipeline using a map for efficient lookups;
 	//	preserves correct rendering order: opaque (nullptr) → transparent → lines
 	// Collect self-managed renderables separately (like ImGui) to render last.
-	std::map<PipelineKey, vector<iRenderableBase*>> pipelineGroups;
+	std::map<PipelineKey, RenderableBatch> pipelineGroups;
+
+	// Instanceable renderables join the instanced draw of the first one found like them, whose batch it's in.
+	std::map<InstanceKey, std::pair<PipelineKey, size_t>> instanceGroups;
+
+	const LODSelector& lodSelector = CommandControl::lodSelector();
 
 	for (auto* pRenderable : renderables) {
 		// Separate self-managed renderables - things like ImGui render last with their own state.
@@ -35,28 +56,237 @@ vector<iRenderableBase*> RenderBatchManager::buildBatches(const vector<iRenderab
 		// Cast to iRenderable to access pipeline and pass, available in all non-self-managed renderables.
 		iRenderable* renderable = static_cast<iRenderable*>(pRenderable);
 
+		if (! renderable->pipeline.IsDrawable())	// (pipeline still compiling, with no fallback)
+			continue;
+
+		if (! renderable->vertexObject.lods.empty())
+			renderable->lod = lodSelector.Select(*renderable, viewportHigh);
+
 		PipelineKey key = { renderable->pass, renderable->pipeline.getVkPipeline(), renderable->renderOrder };
-		pipelineGroups[key].push_back(pRenderable);
+
+		if (! isInstanceable(renderable)) {
+			pipelineGroups[key].renderables.push_back(pRenderable);
+			continue;
+		}
+		auto [found, isNew] = instanceGroups.try_emplace(instanceKey(renderable), key, 0);
+		if (isNew) {
+			vector<InstancedDraw>& instancedDraws = pipelineGroups[key].instancedDraws;
+			found->second.second = instancedDraws.size();
+			instancedDraws.push_back({ static_cast<Renderable*>(renderable), { renderable }, 0 });
+		} else {
+			auto& [leadKey, iDraw] = found->second;
+			pipelineGroups[leadKey].instancedDraws[iDraw].instances.push_back(renderable);
+		}
 	}
 
 	// Convert map to vector of batches:
 	batches.reserve(pipelineGroups.size());
-	for (auto& [key, renderableList] : pipelineGroups) {
-		RenderableBatch batch;
+	for (auto& [key, batch] : pipelineGroups) {
 		batch.key = key;
-		batch.renderables = std::move(renderableList);
+		sortBatchByDepth(batch);
+		if (pOcclusionCulling && key.pass == nullptr) {
+			cullOccluded(batch);
+			iLastOpaqueBatch = batches.size();
+		}
+		if (pHiZCulling && key.pass == nullptr)
+			cullOnGPU(batch);
 		batches.push_back(std::move(batch));
 	}
+
+	uploadInstanceTransforms();
+	if (pHiZCulling)
+		hiZCandidates.Upload(pHiZCulling);
+
 	return selfManagedRenderables;
 }
 
-void RenderBatchManager::recordBatches(VkCommandBuffer& commandBuffer, int bufferIndex,
+// Only renderables whose shaders take their model matrix per-instance can be merged, and of those, not
+//	secondary-command-buffer ones that record themselves, nor ones streaming their own instance data.
+//	A renderable "instanceable" but alone (like dynamic geometry, whose buffers are never shared) still
+//	draws as an instanced draw, of 1.
+//
+bool RenderBatchManager::isInstanceable(iRenderable* pRenderable)
+{
+	return (pRenderable->customizer & AUTO_INSTANCE) && ! pRenderable->IsSecondaryCommandBuffer()
+			&& ! pRenderable->addOns.pInstanceBuffer;
+}
+
+InstanceKey RenderBatchManager::instanceKey(iRenderable* pRenderable)
+{
+	AddOns&		addOns = pRenderable->addOns;
+	MeshObject&	mesh   = pRenderable->vertexObject;
+
+	bool isIndexed = addOns.pIndexBuffer != nullptr;
+	MeshLOD range  = mesh.lodRange(pRenderable->lod);
+
+	return {
+		.pass			= pRenderable->pass,
+		.renderOrder	= pRenderable->renderOrder,
+		.pShaders		= &pRenderable->shaderModules,
+		.customize		= pRenderable->customizer,
+		.pVertexType	= &mesh.vertexType,
+		.vertexBuffer	= addOns.pVertexBuffer ? addOns.pVertexBuffer->getVk() : VK_NULL_HANDLE,
+		.indexBuffer	= isIndexed ? addOns.pIndexBuffer->getVk() : VK_NULL_HANDLE,
+		.first			= isIndexed ? range.firstIndex : mesh.firstVertex,
+		.count			= isIndexed ? range.indexCount : mesh.vertexCount,
+		.vertexOffset	= mesh.vertexOffset,
+		.material		= pRenderable->materialKey()
+	};
+}
+
+// Assign occlusion queries to an opaque batch's renderables, removing those occluded last time to be
+//	represented by their boxes.  If out of queries, renderables just draw.
+//
+void RenderBatchManager::cullOccluded(RenderableBatch& batch)
+{
+	size_t nKept = 0;
+
+	for (iRenderableBase* pRenderable : batch.renderables) {
+		iRenderable* renderable = static_cast<iRenderable*>(pRenderable);
+
+		mat4 boxToClip;
+		OcclusionCulling::Verdict verdict = renderable->IsSecondaryCommandBuffer() ? OcclusionCulling::DRAW
+											: pOcclusionCulling->Classify(renderable, boxToClip);
+
+		uint32_t query = verdict == OcclusionCulling::DRAW ? OcclusionQueryPool::NO_QUERY
+														   : occlusionQueries.Allocate(renderable);
+
+		if (verdict == OcclusionCulling::QUERY_PROXY && query != OcclusionQueryPool::NO_QUERY) {
+			occlusionProxies.push_back({ query, boxToClip });
+			continue;
+		}
+		batch.renderables[nKept++] = pRenderable;
+		batch.queries.push_back(query);
+	}
+	batch.renderables.resize(nKept);
+}
+
+// Give each of an opaque batch's candidates a slot holding its box and draw command, for the cull
+//	shader to judge; it draws from that command.  The rest draw as usual.
+//
+void RenderBatchManager::cullOnGPU(RenderableBatch& batch)
+{
+	for (iRenderableBase* pRenderable : batch.renderables) {
+		iRenderable* renderable = static_cast<iRenderable*>(pRenderable);
+
+		mat4 boxToClip;
+		if (renderable->IsSecondaryCommandBuffer() || ! OcclusionCulling::BoxToClip(renderable, boxToClip)) {
+			batch.hiZSlots.push_back(HiZCandidates::NO_SLOT);
+			continue;
+		}
+		uint32_t drawCommand[5];
+		static_cast<Renderable*>(renderable)->DrawCommand(drawCommand);
+		batch.hiZSlots.push_back(hiZCandidates.Add(boxToClip, drawCommand));
+	}
+}
+
+// Stable, in that equal depths retain their relative order (by tie-breaking on prior position),
+//	yet with std::sort, which unlike std::stable_sort needs no temporary buffer.
+//
+template <typename T, typename DepthOf>
+void RenderBatchManager::sortByDepth(vector<T>& items, bool backToFront, vector<T>& scratch, DepthOf depthOf)
+{
+	if (items.size() < 2)
+		return;
+
+	depthKeys.clear();
+	for (uint32_t index = 0; index < items.size(); ++index) {
+		float depth = depthOf(items[index]);
+		if (backToFront && depth != iRenderable::UNKNOWN_DEPTH)		// (unknown: last, either way)
+			depth = -depth;
+		depthKeys.push_back({ depth, index });
+	}
+	std::sort(depthKeys.begin(), depthKeys.end(), [](const DepthKey& lhs, const DepthKey& rhs) {
+		return lhs.depth < rhs.depth || (lhs.depth == rhs.depth && lhs.index < rhs.index);
+	});
+
+	scratch.clear();
+	for (DepthKey& key : depthKeys)
+		scratch.push_back(std::move(items[key.index]));
+	items.swap(scratch);		// (both keep their capacity for next time)
+}
+
+// Opaque draws go front-to-back, blended ones back-to-front.  Instances within an instanced draw are
+//	likewise ordered, then the draw as a whole sorts by its foremost (or hindmost) instance.
+//
+void RenderBatchManager::sortBatchByDepth(RenderableBatch& batch)
+{
+	iRenderableBase* pFirst = ! batch.renderables.empty() ? batch.renderables.front()
+							: ! batch.instancedDraws.empty() ? batch.instancedDraws.front().pLead : nullptr;
+	if (! pFirst)
+		return;
+
+	Customizer customize = static_cast<iRenderable*>(pFirst)->customizer;
+	bool isBlended = (customize & (ALPHA_BLENDING | ALPHA_BLEND_DEPTH_WRITE | ADDITIVE_BLENDING))
+					|| (batch.key.pass && strcmp(batch.key.pass, "transparency") == 0);
+
+	sortByDepth(batch.renderables, isBlended, renderablesScratch, [](iRenderableBase* pRenderable) {
+		return pRenderable->isSelfManaged ? iRenderable::UNKNOWN_DEPTH
+										  : static_cast<iRenderable*>(pRenderable)->viewDepth();
+	});
+
+	for (InstancedDraw& draw : batch.instancedDraws) {
+		sortByDepth(draw.instances, isBlended, instancesScratch, [](iRenderable* pInstance) {
+			return pInstance->viewDepth();
+		});
+	}
+	sortByDepth(batch.instancedDraws, isBlended, drawsScratch, [](InstancedDraw& draw) {
+		return draw.instances.front()->viewDepth();
+	});
+}
+
+// Gather every instance's model matrix into one array, in draw order, and copy it all to the GPU at once;
+//	occlusion proxies' box transforms follow.  The buffer is host-visible; it only grows (by doubling)
+//	and is otherwise reused frame to frame.
+//
+void RenderBatchManager::uploadInstanceTransforms()
+{
+	instanceTransforms.clear();
+
+	for (RenderableBatch& batch : batches)
+		for (InstancedDraw& draw : batch.instancedDraws) {
+			draw.firstInstance = (uint32_t) instanceTransforms.size();
+			for (iRenderable* pInstance : draw.instances) {
+				const mat4* pModel = pInstance->modelMatrix();
+				instanceTransforms.push_back(pModel ? *pModel : mat4(1.0f));
+			}
+		}
+
+	firstProxyInstance = (uint32_t) instanceTransforms.size();
+	for (OcclusionProxy& proxy : occlusionProxies)
+		instanceTransforms.push_back(proxy.boxToClip);
+
+	if (instanceTransforms.empty())
+		return;
+
+	if (instanceTransforms.size() > instanceCapacity) {
+		delete pInstanceBuffer;
+		instanceCapacity = std::max(instanceTransforms.size(), instanceCapacity * 2);
+		pInstanceBuffer = new PrimitiveBuffer(CommandControl::vkPool(), CommandControl::device());
+		pInstanceBuffer->CreateVertexBuffer(nullptr, instanceCapacity * sizeof(mat4), true);	// hostVisible
+	}
+	pInstanceBuffer->UpdateVertexBufferMapped(instanceTransforms.data(), instanceTransforms.size() * sizeof(mat4));
+}
+
+void RenderBatchManager::recordBatches(VkCommandBuffer& commandBuffer, int bufferIndex, VkExtent2D extent,
 									   const vector<iRenderableBase*>& selfManagedRenderables)
 {
 	VkPipeline lastBoundPipeline = VK_NULL_HANDLE;
+	BoundDescriptorSets bound;		// (so that sets shared by successive draws bind only once)
+	bool isInstanceBufferBound = false;
+
+	auto bindInstanceBuffer = [&] {
+		if (! isInstanceBufferBound) {
+			VkDeviceSize offset = 0;
+			vkCmdBindVertexBuffers(commandBuffer, INSTANCE_BINDING, 1, &pInstanceBuffer->getVk(), &offset);
+			isInstanceBufferBound = true;
+		}
+	};
 
 	// First: Record all batched renderables (scene objects).
-	for (const auto& batch : batches) {
+	for (size_t iBatch = 0; iBatch < batches.size(); ++iBatch) {
+		const RenderableBatch& batch = batches[iBatch];
+
 		// Bind pipeline once per batch, not per renderable.
 		if (batch.key.pipeline != lastBoundPipeline) {
 			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, batch.key.pipeline);
@@ -64,7 +294,9 @@ void RenderBatchManager::recordBatches(VkCommandBuffer& commandBuffer, int buffe
 		}
 
 		// Draw all renderables in this batch.
-		for (auto* pRenderable : batch.renderables) {
+		for (size_t iDraw = 0; iDraw < batch.renderables.size(); ++iDraw) {
+			iRenderableBase* pRenderable = batch.renderables[iDraw];
+
 			// Self-managed renderables should not be in batches, but check just in case.
 			if (pRenderable->isSelfManaged) {
 				continue;  // Skip self-managed renderables in batched rendering.
@@ -73,15 +305,58 @@ void RenderBatchManager::recordBatches(VkCommandBuffer& commandBuffer, int buffe
 			// Safe to cast to iRenderable* now; we've confirmed it's not self-managed.
 			iRenderable* renderable = static_cast<iRenderable*>(pRenderable);
 
+			uint32_t query = batch.queries.empty() ? OcclusionQueryPool::NO_QUERY : batch.queries[iDraw];
+			if (query != OcclusionQueryPool::NO_QUERY)
+				occlusionQueries.CmdBegin(commandBuffer, query, bufferIndex);
+
 			// Check if this is a secondary command buffer renderable.
 			if (renderable->IsSecondaryCommandBuffer()) {	// If so, execute the pre-recorded command buffer.
 				VkCommandBuffer secondaryCmdBuf = renderable->GetSecondaryCommandBuffer(bufferIndex);
 				vkCmdExecuteCommands(commandBuffer, 1, &secondaryCmdBuf);
+
+				// Afterward the primary's bound state and dynamic state are undefined: restore both.
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, batch.key.pipeline);
+				GraphicsPipeline::CmdSetViewportAndScissor(commandBuffer, extent);
+				bound.Reset();
+				isInstanceBufferBound = false;
 			} else {	// Otherwise, cast to Renderable for normal batched rendering.
 				Renderable* concreteRenderable = static_cast<Renderable*>(renderable);
-				// Skip pipeline bind since we already bound it once for the entire batch.
-				concreteRenderable->IssueBindAndDrawCommands(commandBuffer, bufferIndex, true);
+				uint32_t slot = batch.hiZSlots.empty() ? HiZCandidates::NO_SLOT : batch.hiZSlots[iDraw];
+				if (slot != HiZCandidates::NO_SLOT) {		// Draw as the cull shader left its command.
+					if (concreteRenderable->IssueBindDescriptors(commandBuffer, bufferIndex, &bound)) {
+						concreteRenderable->IssuePushConstants(commandBuffer);
+						concreteRenderable->IssueBindGeometry(commandBuffer, true);
+						concreteRenderable->IssueDrawIndirect(commandBuffer, hiZCandidates.getVkBuffer(),
+															  HiZCandidates::DrawOffset(slot));
+					}
+				} else	// Skip pipeline bind since we already bound it once for the entire batch.
+					concreteRenderable->IssueBindAndDrawCommands(commandBuffer, bufferIndex, true, &bound);
+				if (renderable->addOns.pInstanceBuffer)		// (its own, now bound in place of ours)
+					isInstanceBufferBound = false;
 			}
+
+			if (query != OcclusionQueryPool::NO_QUERY)
+				occlusionQueries.CmdEnd(commandBuffer, query, bufferIndex);
+		}
+
+		// Then: Instanced draws, binding the instance buffer only once.
+		for (const InstancedDraw& draw : batch.instancedDraws) {
+			if (! draw.pLead->IssueBindDescriptors(commandBuffer, bufferIndex, &bound))
+				continue;
+
+			draw.pLead->IssuePushConstants(commandBuffer);
+			draw.pLead->IssueBindGeometry(commandBuffer);
+			bindInstanceBuffer();
+			draw.pLead->IssueDraw(commandBuffer, (uint32_t) draw.instances.size(), draw.firstInstance);
+		}
+
+		// Once all opaque geometry has filled the depth buffer: test the culled renderables' boxes.
+		if (iBatch == iLastOpaqueBatch && ! occlusionProxies.empty()) {
+			bindInstanceBuffer();
+			pOcclusionCulling->CmdDrawProxies(commandBuffer, occlusionQueries, bufferIndex,
+											  occlusionProxies, firstProxyInstance);
+			lastBoundPipeline = pOcclusionCulling->getVkPipeline();
+			bound.Reset();
 		}
 	}
 
@@ -92,7 +367,23 @@ void RenderBatchManager::recordBatches(VkCommandBuffer& commandBuffer, int buffe
 	}
 }
 
+void RenderBatchManager::recordPreRenderPass(VkCommandBuffer& commandBuffer, int bufferIndex)
+{
+	occlusionQueries.CmdReset(commandBuffer, bufferIndex);
+	if (pHiZCulling)
+		pHiZCulling->CmdCull(commandBuffer, hiZCandidates);
+}
+
+void RenderBatchManager::recordPostRenderPass(VkCommandBuffer& commandBuffer)
+{
+	if (pHiZCulling)
+		pHiZCulling->CmdBuildPyramid(commandBuffer);
+}
+
 void RenderBatchManager::clear()
 {
 	batches.clear();
+	occlusionProxies.clear();
+	iLastOpaqueBatch = 0;
+	hiZCandidates.Clear();
 }
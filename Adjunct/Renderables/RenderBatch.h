@@ -12,6 +12,27 @@
 // This reduces pipeline binds from O(N renderables) to O(M unique pipelines), where M << N.
 // For a scene with 100 objects using 5 different shaders, this reduces from 100 binds to 5.
 //
+// Going further, renderables customized AUTO_INSTANCE that draw the same geometry, with
+//	equivalent pipelines and the same material (all but their model matrix), merge into a
+//	single instanced draw: their model matrices are gathered into a per-instance buffer,
+//	bound as INSTANCE_BINDING, so a forest of 1000 identical trees costs one draw call.
+//
+// Meshes having levels of detail draw the one LODSelector picks for them this frame (which also
+//	keeps renderables at different levels from merging into one instanced draw).
+//
+// Within each batch, draws are ordered by view-space depth every frame: front-to-back when
+//	opaque, to maximize early depth rejection, or back-to-front when blended, so that the
+//	app need not order its own transparent renderables.  Equal depths keep insertion order, and
+//	those of unknown depth (having no model or view matrix) follow the rest, either way.
+//
+// Descriptor sets, too, bind only when they change from one draw to the next (see BoundDescriptorSets):
+//	renderables customized SETS_BY_FREQUENCY, sharing per-frame and per-material sets, bind just their
+//	per-object set per draw.
+//
+// With OcclusionCulling enabled, opaque renderables occluded last time are left out, their bounding
+//	boxes tested instead after the last opaque batch (see OcclusionCulling.h).  With HiZCulling enabled
+//	instead, those same candidates draw indirectly, from commands a compute pass may have zeroed.
+//
 // Tadd Jensen 9 Nov 2023
 //	© 0000 (uncopyrighted; use at will)
 //
@@ -20,9 +41,15 @@
 
 #include "VulkanPlatform.h"
 #include "iRenderable.h"
+#include "OcclusionCulling.h"
+#include "HiZCulling.h"
+#include "LevelOfDetail.h"
 #include <map>
+#include <tuple>
 #include <cstring>
 
+struct Renderable;
+
 
 // Key for grouping renderables by shared pipeline state AND render pass,
 //	ensures correct depth ordering: opaque → transparent → lines
@@ -68,12 +95,51 @@ private:
 };
 
 
+// Identifies renderables that can be drawn as instances of one another: same pass and order,
+//	equivalent pipeline (shaders, customization, vertex type), same geometry and same material.
+//
+struct InstanceKey
+{
+	const char*		pass;
+	int				renderOrder;
+	ShaderModules*	pShaders;
+	int				customize;
+	VertexAbstract*	pVertexType;
+	VkBuffer		vertexBuffer;
+	VkBuffer		indexBuffer;
+	uint32_t		first;			// firstIndex or firstVertex,
+	uint32_t		count;			//	indexCount or vertexCount.
+	int32_t			vertexOffset;
+	uint64_t		material;
+
+	bool operator<(const InstanceKey& other) const {
+		return std::tie(pass, renderOrder, pShaders, customize, pVertexType, vertexBuffer, indexBuffer,
+						first, count, vertexOffset, material)
+			 < std::tie(other.pass, other.renderOrder, other.pShaders, other.customize, other.pVertexType,
+						other.vertexBuffer, other.indexBuffer, other.first, other.count, other.vertexOffset,
+						other.material);
+	}
+};
+
+// One instanced draw standing in for several renderables: the lead's descriptors, geometry and
+//	pipeline are bound, then each instance's model matrix is streamed in from the instance buffer.
+//
+struct InstancedDraw
+{
+	Renderable*				pLead;
+	vector<iRenderable*>	instances;		// (lead first)
+	uint32_t				firstInstance;	// ...its index into instance buffer.
+};
+
 // A batch of renderables that share the same pipeline.
 //
 struct RenderableBatch
 {
 	PipelineKey key;
 	vector<iRenderableBase*> renderables;
+	vector<InstancedDraw>	 instancedDraws;	// (of AUTO_INSTANCE renderables, drawn after the above)
+	vector<uint32_t>		 queries;			// Per renderable, if occlusion culling: its query or NO_QUERY.
+	vector<uint32_t>		 hiZSlots;			//	...or if Hi-Z culling: its candidate slot or NO_SLOT.
 };
 
 
@@ -83,17 +149,26 @@ class RenderBatchManager
 {
 public:
 	RenderBatchManager() = default;
+	~RenderBatchManager();
 
-	// Build batches from a list of renderables;
-	//	maintains relative order within each batch for correct transparency rendering.
+	// Build batches from a list of renderables, then depth-sort each one's draws (see above).
+	//	viewportHigh: in pixels, for level-of-detail selection.
+	//	numBufferSets: how many command buffers will record them (each with its own occlusion queries).
 	// Returns self-managed renderables (like ImGui) that should be rendered last.
-	vector<iRenderableBase*> buildBatches(const vector<iRenderableBase*>& renderables);
+	vector<iRenderableBase*> buildBatches(const vector<iRenderableBase*>& renderables, float viewportHigh,
+										  uint32_t numBufferSets = 1);
 
 	// Record all batches into command buffer with optimized pipeline binding.
+	//	extent: of the render pass, to restore viewport and scissor after executing a secondary.
 	//	selfManagedRenderables: Renderables that manage their own state record last.
-	void recordBatches(VkCommandBuffer& commandBuffer, int bufferIndex,
+	void recordBatches(VkCommandBuffer& commandBuffer, int bufferIndex, VkExtent2D extent,
 					   const vector<iRenderableBase*>& selfManagedRenderables = {});
 
+	// Record what must precede the render pass, namely resetting occlusion queries about to be reused
+	//	or culling Hi-Z candidates, and what must follow it: building the next frame's depth pyramid.
+	void recordPreRenderPass(VkCommandBuffer& commandBuffer, int bufferIndex);
+	void recordPostRenderPass(VkCommandBuffer& commandBuffer);
+
 	void clear();			// Clear all batches - call before rebuilding.
 
 	// Get number of batches - useful for performance monitoring.
@@ -101,6 +176,39 @@ public:
 
 private:
 	vector<RenderableBatch> batches;
+
+	vector<mat4>		instanceTransforms;		// Model matrices of all instanced draws, in draw order,
+	PrimitiveBuffer*	pInstanceBuffer = nullptr;	//	uploaded here (one per frame, as is this manager).
+	size_t				instanceCapacity = 0;
+
+	OcclusionCulling*		pOcclusionCulling = nullptr;	// (if enabled, as of buildBatches)
+	OcclusionQueryPool		occlusionQueries;
+	vector<OcclusionProxy>	occlusionProxies;		// Boxes standing in for culled renderables, whose transforms
+	uint32_t				firstProxyInstance = 0;	//	follow the instanced draws' in the instance buffer,
+	size_t					iLastOpaqueBatch   = 0;	//	drawn after this batch.
+
+	HiZCulling*				pHiZCulling = nullptr;		// (if enabled, as of buildBatches; supersedes the above)
+	HiZCandidates			hiZCandidates;
+
+	bool isInstanceable(iRenderable* pRenderable);
+	InstanceKey instanceKey(iRenderable* pRenderable);
+	void cullOccluded(RenderableBatch& batch);
+	void cullOnGPU(RenderableBatch& batch);
+	void uploadInstanceTransforms();
+
+	// Depth sorting reuses these each frame, so allocates nothing once they've grown to scene size.
+	struct DepthKey {
+		float		depth;
+		uint32_t	index;		// (prior position, to keep sort stable)
+	};
+	vector<DepthKey>			depthKeys;
+	vector<iRenderableBase*>	renderablesScratch;
+	vector<iRenderable*>		instancesScratch;
+	vector<InstancedDraw>		drawsScratch;
+
+	void sortBatchByDepth(RenderableBatch& batch);
+	template <typename T, typename DepthOf>
+	void sortByDepth(vector<T>& items, bool backToFront, vector<T>& scratch, DepthOf depthOf);
 };
 
 #endif	// RenderBatch_h
@@ -17,8 +17,8 @@ Renderable::Renderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatfo
 { }
 
 Renderable::Renderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform,
-					   iRenderPass* pCustomRenderPass, VkExtent2D customExtent)
-	:	iRenderable(drawable, vulkan, platform, pCustomRenderPass, customExtent)
+					   iRenderPass* pCustomRenderPass)
+	:	iRenderable(drawable, vulkan, platform, pCustomRenderPass)
 { }
 
 
@@ -27,51 +27,111 @@ void Renderable::IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bu
 	IssueBindAndDrawCommands(commandBuffer, bufferIndex, false);
 }
 
-void Renderable::IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex, bool skipPipelineBind)
+void Renderable::IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex, bool skipPipelineBind,
+										  BoundDescriptorSets* pBound)
 {
+	if (! pipeline.IsDrawable())	// (still compiling, with no fallback to stand in)
+		return;
+
 	// Bind graphics pipeline, unless using batched rendering where pipeline already bound.
 	if (! skipPipelineBind)
 		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getVkPipeline());
 
-	if (descriptors.exist()) {		// Bind descriptor sets.
-		// DIAGNOSTIC: Check for out-of-bounds or null descriptor set access.
-		auto& sets = descriptors.getSets();
-		if (bufferIndex < 0 || bufferIndex >= (int)sets.size()) {
-			Log(ERROR, "DESCRIPTOR OOB: '%s' bufferIndex=%d sets.size()=%zu", name.c_str(), bufferIndex, sets.size());
-			return;		// Skip draw to avoid crash.
-		}
-		if (sets[bufferIndex] == VK_NULL_HANDLE) {
-			Log(ERROR, "DESCRIPTOR NULL: '%s' bufferIndex=%d", name.c_str(), bufferIndex);
-			return;		// Skip draw to avoid crash.
-		}
-		if (hasDynamicOffset) {
-					// Bind descriptor with dynamic offset for per-object transforms via Dynamic UBO.
-			uint32_t dynamicOffsets[] = { dynamicOffset };
-			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-									pipeline.getPipelineLayout(), 0, 1,
-									&sets[bufferIndex], 1, dynamicOffsets);
-		} else {	// Standard descriptor binding without dynamic offset.
-			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-									pipeline.getPipelineLayout(), 0, 1,
-									&sets[bufferIndex], 0, nullptr);
-		}
+	if (! IssueBindDescriptors(commandBuffer, bufferIndex, pBound))
+		return;
+
+	IssuePushConstants(commandBuffer);
+	IssueBindGeometry(commandBuffer);
+	IssueDraw(commandBuffer, vertexObject.instanceCount, vertexObject.firstInstance);
+}
+
+// Bind each descriptor set (see Descriptors), but with pBound, only those not already bound by the
+//	previous draw in this command buffer (e.g. per-frame and per-material sets, if SETS_BY_FREQUENCY).
+//
+bool Renderable::IssueBindDescriptors(VkCommandBuffer& commandBuffer, int bufferIndex, BoundDescriptorSets* pBound)
+{
+	if (! descriptors.CmdBind(commandBuffer, pipeline.getPipelineLayout(), bufferIndex,
+							  hasDynamicOffset ? dynamicOffset : 0, pBound)) {
+		Log(ERROR, "DESCRIPTORS UNBOUND: '%s' bufferIndex=%d", name.c_str(), bufferIndex);
+		return false;	// Skip draw to avoid crash.
 	}
+	return true;
+}
 
+// All pipeline layouts share the push constant range (see DrawPushConstants.h), so this may follow
+//	whichever pipeline is bound, and need not be repeated after another is.
+//
+void Renderable::IssuePushConstants(VkCommandBuffer& commandBuffer)
+{
+	if (addOns.isBindless)
+		pushConstants.materialIndex = addOns.materialIndex();
+	if (customizer & (PUSH_CONSTANTS | BINDLESS))
+		vkCmdPushConstants(commandBuffer, pipeline.getPipelineLayout(), DrawPushConstants::STAGES,
+						   0, sizeof(DrawPushConstants), &pushConstants);
+}
+
+void Renderable::IssueBindGeometry(VkCommandBuffer& commandBuffer, bool forDrawIndirect)
+{
 	if (addOns.pVertexBuffer) {		// Bind vertex buffer.
 		VkBuffer vertexBuffers[] = { addOns.pVertexBuffer->getVk() };
 		VkDeviceSize offsets[]	 = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		vkCmdBindVertexBuffers(commandBuffer, VERTEX_BINDING, 1, vertexBuffers, offsets);
 	}
 
-	if (addOns.pIndexBuffer) {		// Draw indexed or non-indexed.
-				// Indexed draw: use index buffer.
+	if (addOns.pInstanceBuffer) {	// Bind per-instance attributes.
+		VkDeviceSize offset = 0;
+		if (forDrawIndirect && ! addOns.vulkan.device.drawsIndirectFirstInstance())	// (see DrawCommand)
+			offset = vertexObject.firstInstance * vertexObject.vertexType.instanceByteSize();
+		vkCmdBindVertexBuffers(commandBuffer, INSTANCE_BINDING, 1, &addOns.pInstanceBuffer->getVk(), &offset);
+	}
+
+	if (addOns.pIndexBuffer)		// Bind index buffer (if there is one, draw will be indexed).
 		vkCmdBindIndexBuffer(commandBuffer, addOns.pIndexBuffer->getVk(),
 							 0, VkIndexTypes[vertexObject.indexType]);
-		vkCmdDrawIndexed(commandBuffer, vertexObject.indexCount, vertexObject.instanceCount,
-										vertexObject.firstIndex, vertexObject.vertexOffset,
-										vertexObject.firstInstance);
+}
+
+void Renderable::IssueDraw(VkCommandBuffer& commandBuffer, uint32_t instanceCount, uint32_t firstInstance)
+{
+	if (addOns.pIndexBuffer) {		// Draw indexed or non-indexed.
+				// Indexed draw: use index buffer, at the selected level of detail.
+		MeshLOD range = vertexObject.lodRange(lod);
+		vkCmdDrawIndexed(commandBuffer, range.indexCount, instanceCount,
+										range.firstIndex, vertexObject.vertexOffset,
+										firstInstance);
 	} else {	// Non-indexed draw: use vertex buffer directly.
-		vkCmdDraw(commandBuffer, vertexObject.vertexCount, vertexObject.instanceCount,
-								 vertexObject.firstVertex, vertexObject.firstInstance);
+		vkCmdDraw(commandBuffer, vertexObject.vertexCount, instanceCount,
+								 vertexObject.firstVertex, firstInstance);
+	}
+}
+
+// (A nonzero firstInstance, unless the device has drawIndirectFirstInstance, is instead bound as an
+//	offset into the instance buffer, see IssueBindGeometry.)
+//
+void Renderable::DrawCommand(uint32_t command[5])
+{
+	uint32_t firstInstance = addOns.vulkan.device.drawsIndirectFirstInstance() ? vertexObject.firstInstance : 0;
+
+	if (addOns.pIndexBuffer) {		// VkDrawIndexedIndirectCommand
+		MeshLOD range = vertexObject.lodRange(lod);
+		command[0] = range.indexCount;
+		command[1] = vertexObject.instanceCount;
+		command[2] = range.firstIndex;
+		command[3] = (uint32_t) vertexObject.vertexOffset;		// (int32_t in the struct)
+		command[4] = firstInstance;
+	} else {						// VkDrawIndirectCommand
+		command[0] = vertexObject.vertexCount;
+		command[1] = vertexObject.instanceCount;
+		command[2] = vertexObject.firstVertex;
+		command[3] = firstInstance;
+		command[4] = 0;
 	}
 }
+
+void Renderable::IssueDrawIndirect(VkCommandBuffer& commandBuffer, VkBuffer& buffer, VkDeviceSize offset)
+{
+	const uint32_t drawCount = 1;
+	if (addOns.pIndexBuffer)
+		vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, 0);
+	else
+		vkCmdDrawIndirect(commandBuffer, buffer, offset, drawCount, 0);
+}
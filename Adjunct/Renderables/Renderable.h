@@ -28,9 +28,9 @@ public:
 	// Standard constructor - uses default render pass and extent.
 	Renderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform);
 
-	// Custom constructor - allows custom render pass and extent (e.g., for shadow mapping).
+	// Custom constructor - allows custom render pass (e.g., for shadow mapping; its extent is set as it begins).
 	Renderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform,
-			   iRenderPass* pCustomRenderPass, VkExtent2D customExtent);
+			   iRenderPass* pCustomRenderPass);
 
 	// Returns command recording mode - defaults to UPON_EACH_FRAME for flexibility.
 	iRenderable* newConcretion(CommandRecording* pRecordingMode) const override
@@ -41,8 +41,25 @@ public:
 
 	// Record Vulkan draw commands into the command buffer.
 	//	skipPipelineBind: Set to true when using batched rendering (pipeline already bound by batch manager).
+	//	pBound: Descriptor sets the batch manager has bound so far, to skip rebinding (see Descriptors.h).
 	void IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex) override;
-	void IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex, bool skipPipelineBind);
+	void IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex, bool skipPipelineBind,
+								  BoundDescriptorSets* pBound = nullptr);
+
+	// The above, in its separate steps, for RenderBatchManager to share binds across renderables,
+	//	or draw one renderable's geometry as several instances.
+	bool IssueBindDescriptors(VkCommandBuffer& commandBuffer, int bufferIndex,		// false: skip drawing!
+							  BoundDescriptorSets* pBound = nullptr);
+	void IssuePushConstants(VkCommandBuffer& commandBuffer);
+	void IssueBindGeometry(VkCommandBuffer& commandBuffer, bool forDrawIndirect = false);
+	void IssueDraw(VkCommandBuffer& commandBuffer, uint32_t instanceCount, uint32_t firstInstance);
+
+	// Or draw from a command in a buffer (e.g. one HiZCulling may zero), first written by DrawCommand:
+	//	a VkDrawIndexedIndirectCommand if indexed, else a VkDrawIndirectCommand (padded to 5 words).  Its
+	//	geometry bound forDrawIndirect, since without the device's drawIndirectFirstInstance feature, the
+	//	command's firstInstance is 0, the instance buffer bound that many instances in instead.
+	void DrawCommand(uint32_t command[5]);
+	void IssueDrawIndirect(VkCommandBuffer& commandBuffer, VkBuffer& buffer, VkDeviceSize offset);
 };
 
 #endif	// Renderable_h
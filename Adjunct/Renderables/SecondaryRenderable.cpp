@@ -18,8 +18,8 @@ SecondaryRenderable::SecondaryRenderable(DrawableSpecifier& drawable, VulkanSetu
 { }
 
 SecondaryRenderable::SecondaryRenderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform,
-										 iRenderPass* pCustomRenderPass, VkExtent2D customExtent)
-	: iRenderable(drawable, vulkan, platform, pCustomRenderPass, customExtent), pVulkan(&vulkan)
+										 iRenderPass* pCustomRenderPass)
+	: iRenderable(drawable, vulkan, platform, pCustomRenderPass), pVulkan(&vulkan)
 { }
 
 SecondaryRenderable::~SecondaryRenderable()
@@ -52,8 +52,20 @@ void SecondaryRenderable::AllocateSecondaryCommandBuffers(VulkanSetup& vulkan)
 	if (result != VK_SUCCESS)
 		Fatal("Failed to allocate secondary command buffers" + ErrStr(result));
 
-	// Record commands into each secondary command buffer.
-	for (uint32_t i = 0; i < numFrames; ++i)
+	recordSecondaryCommandBuffers(vulkan);
+	Log(LOW, "SecondaryRenderable: Allocated and recorded %u secondary command buffers for %s", numFrames, name.c_str());
+}
+
+// Record commands into each secondary command buffer.  Dynamic state isn't inherited from the primary
+//	command buffer, so each sets its own viewport and scissor, and must be re-recorded when those change.
+//	(Beginning one implicitly resets it, the command pool being RESET_COMMAND_BUFFER.)
+//
+void SecondaryRenderable::recordSecondaryCommandBuffers(VulkanSetup& vulkan)
+{
+	pipeline.EnsureBuilt();
+	vulkan.device.getDescriptorWriter().Flush();	// (sets bound below must be written first)
+
+	for (uint32_t i = 0; i < secondaryCommandBuffers.size(); ++i)
 	{
 		// Set up inheritance info - inherits render pass state from primary command buffer.
 		VkCommandBufferInheritanceInfo inheritanceInfo = {
@@ -74,17 +86,27 @@ void SecondaryRenderable::AllocateSecondaryCommandBuffers(VulkanSetup& vulkan)
 			.pInheritanceInfo = &inheritanceInfo
 		};
 
-		result = vkBeginCommandBuffer(secondaryCommandBuffers[i], &beginInfo);
+		VkResult result = vkBeginCommandBuffer(secondaryCommandBuffers[i], &beginInfo);
 		if (result != VK_SUCCESS)
 			Fatal("Failed to begin secondary command buffer" + ErrStr(result));
 
+		GraphicsPipeline::CmdSetViewportAndScissor(secondaryCommandBuffers[i], vulkan.swapchain.getExtent());
 		IssueBindAndDrawCommands(secondaryCommandBuffers[i], i);		// Record draw commands.
 
 		result = vkEndCommandBuffer(secondaryCommandBuffers[i]);
 		if (result != VK_SUCCESS)
 			Fatal("Failed to end secondary command buffer" + ErrStr(result));
 	}
-	Log(LOW, "SecondaryRenderable: Allocated and recorded %u secondary command buffers for %s", numFrames, name.c_str());
+}
+
+// Re-record for the new extent (after the pipeline, if reloading the mesh, so as to bind the new one).
+//
+void SecondaryRenderable::Recreate(VulkanSetup& vulkan, bool reloadMesh)
+{
+	iRenderable::Recreate(vulkan, reloadMesh);
+
+	if (! secondaryCommandBuffers.empty())
+		recordSecondaryCommandBuffers(vulkan);
 }
 
 // Record Vulkan draw commands into the secondary command buffer.
@@ -95,30 +117,20 @@ void SecondaryRenderable::IssueBindAndDrawCommands(VkCommandBuffer& commandBuffe
 	// Bind graphics pipeline:
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getVkPipeline());
 
-	if (descriptors.exist()) {		// Bind descriptor sets:
-		// DIAGNOSTIC: Check for out-of-bounds or null descriptor set access.
-		auto& sets = descriptors.getSets();
-		if (bufferIndex < 0 || bufferIndex >= (int)sets.size()) {
-			Log(ERROR, "2NDARY DESCRIPTOR OOB: '%s' bufferIndex=%d sets.size()=%zu", name.c_str(), bufferIndex, sets.size());
-			return;
-		}
-		if (sets[bufferIndex] == VK_NULL_HANDLE) {
-			Log(ERROR, "2NDARY DESCRIPTOR NULL: '%s' bufferIndex=%d", name.c_str(), bufferIndex);
-			return;
-		}
-		if (hasDynamicOffset) {
-			// Bind descriptor with dynamic offset for per-object transforms via Dynamic UBO.
-			uint32_t dynamicOffsets[] = { dynamicOffset };
-			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-									pipeline.getPipelineLayout(), 0, 1,
-									&sets[bufferIndex], 1, dynamicOffsets);
-		} else {	// Standard descriptor binding without dynamic offset.
-			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-									pipeline.getPipelineLayout(), 0, 1,
-									&sets[bufferIndex], 0, nullptr);
-		}
+	// Bind descriptor sets (including, if BINDLESS, the device-wide texture array):
+	if (! descriptors.CmdBind(commandBuffer, pipeline.getPipelineLayout(), bufferIndex,
+							  hasDynamicOffset ? dynamicOffset : 0)) {
+		Log(ERROR, "2NDARY DESCRIPTORS UNBOUND: '%s' bufferIndex=%d", name.c_str(), bufferIndex);
+		return;
 	}
 
+	if (addOns.isBindless)
+		pushConstants.materialIndex = addOns.materialIndex();
+
+	if (customizer & (PUSH_CONSTANTS | BINDLESS))	// (as recorded: changes to them take effect when re-recorded)
+		vkCmdPushConstants(commandBuffer, pipeline.getPipelineLayout(), DrawPushConstants::STAGES,
+						   0, sizeof(DrawPushConstants), &pushConstants);
+
 	if (addOns.pVertexBuffer) {		// Bind vertex buffer:
 		VkBuffer vertexBuffers[] = { addOns.pVertexBuffer->getVk() };
 		VkDeviceSize offsets[] = { 0 };
@@ -34,9 +34,9 @@ public:
 	// Standard constructor - uses default render pass and extent.
 	SecondaryRenderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform);
 
-	// Custom constructor - allows custom render pass and extent (e.g., for shadow mapping).
+	// Custom constructor - allows custom render pass (e.g., for shadow mapping; its extent is set as it begins).
 	SecondaryRenderable(DrawableSpecifier& drawable, VulkanSetup& vulkan, iPlatform& platform,
-						iRenderPass* pCustomRenderPass, VkExtent2D customExtent);
+						iRenderPass* pCustomRenderPass);
 
 	~SecondaryRenderable();
 
@@ -54,6 +54,9 @@ public:
 	// Allocate and record secondary command buffers (one per frame).
 	void AllocateSecondaryCommandBuffers(VulkanSetup& vulkan);
 
+	// Re-record them, e.g. upon window resize, as they set their own viewport.
+	void Recreate(VulkanSetup& vulkan, bool reloadMesh = false) override;
+
 	// Get secondary command buffer for a specific frame.
 	VkCommandBuffer GetSecondaryCommandBuffer(int frameIndex) const override
 	{
@@ -64,6 +67,8 @@ public:
 	bool IsSecondaryCommandBuffer() const override { return useSecondaryCommandBuffers; }
 
 private:
+	void recordSecondaryCommandBuffers(VulkanSetup& vulkan);
+
 	// Secondary command buffer state
 	std::vector<VkCommandBuffer> secondaryCommandBuffers;	// One per frame
 	bool useSecondaryCommandBuffers = true;
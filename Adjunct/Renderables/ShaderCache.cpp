@@ -9,6 +9,8 @@
 //
 #include "ShaderCache.h"
 #include "Logging.h"
+#include "Helpers.h"
+#include <cstring>
 
 ShaderCache::ShaderCache(GraphicsDevice& device)
 	:	graphicsDevice(device)
@@ -17,42 +19,82 @@ ShaderCache::ShaderCache(GraphicsDevice& device)
 ShaderCache::~ShaderCache()
 {
 	// Clean up any remaining cached shaders
-	for (auto& pair : shaderCache) {
-		Log(DEAD, "ShaderCache: Deleting unreleased shader set: %s", pair.first.c_str());
-		delete pair.second;
+	for (auto& pair : entries) {
+		Log(DEAD, "ShaderCache: Deleting unreleased shader set: %016llx",
+				  (unsigned long long) pair.first->Identity());
+		delete pair.first;
 	}
-	shaderCache.clear();
-	refCounts.clear();
+	byNames.clear();
+	byIdentity.clear();
+	entries.clear();
 }
 
-std::string ShaderCache::createKey(const Shaders& shaders) const
+uint64_t ShaderCache::Key(const Shaders& shaders)
 {
-	std::string key;
+	uint64_t key = 0;
 	for (const auto& shader : shaders) {
-		if (!key.empty())
-			key += "|";
-		key += std::to_string(shader.fileType) + ":" + shader.nameShaderFile;
+		StrPtr entrypoint = shader.nameEntrypointFunction ? shader.nameEntrypointFunction : "";
+		hashCombine(key, shader.fileType);
+		hashCombine(key, hashBytes(shader.nameShaderFile, strlen(shader.nameShaderFile)));
+		hashCombine(key, hashBytes(entrypoint, strlen(entrypoint)));
 	}
 	return key;
 }
 
+// Whether these are the very names the entry was made from (not merely of equal key).
+//
+bool ShaderCache::Named::Matches(const Shaders& shaders) const
+{
+	if (names.size() != shaders.size())
+		return false;
+	for (size_t iShader = 0; iShader < names.size(); ++iShader) {
+		const Shader& shader = shaders[iShader];
+		StrPtr entrypoint = shader.nameEntrypointFunction ? shader.nameEntrypointFunction : "";
+		if (names[iShader].fileType != shader.fileType
+			|| names[iShader].nameShaderFile != shader.nameShaderFile
+			|| names[iShader].nameEntrypointFunction != entrypoint)
+			return false;
+	}
+	return true;
+}
+
 ShaderModules* ShaderCache::getOrCreate(const Shaders& shaders)
 {
-	std::string key = createKey(shaders);
+	return getOrCreate(shaders, Key(shaders));
+}
 
-	// Check if already cached.
-	auto it = shaderCache.find(key);
-	if (it != shaderCache.end()) {
-		Log(RAW, " \t(reuse cache shaders ↪ %s)", key.c_str());
-		return it->second;
-	}
+ShaderModules* ShaderCache::getOrCreate(const Shaders& shaders, uint64_t key)
+{
+	// Check if already cached (under these same names, not merely this key).
+	auto [first, last] = byNames.equal_range(key);
+	for (auto it = first; it != last; ++it)
+		if (it->second.Matches(shaders)) {
+			Log(RAW, " \t(reuse cache shaders ↪ %s ...)", shaders.empty() ? "" : shaders[0].nameShaderFile);
+			return it->second.pShaderModules;
+		}
 
-	// Create new ShaderModules.
-	Log(RAW, " \t(load new shader set → %s)", key.c_str());
+	// Create new ShaderModules (whose VkShaderModules are themselves shared by content).
 	ShaderModules* pShaderModules = new ShaderModules(const_cast<Shaders&>(shaders), graphicsDevice);
 
-	shaderCache[key] = pShaderModules;
-	refCounts[pShaderModules] = 0;  // Will be incremented by addRef().
+	// Identical code already cached under other names?  Alias it.  (Identical indeed, not merely of
+	//	equal hash: the same shared VkShaderModules, stages and entry points.)
+	auto same = byIdentity.find(pShaderModules->Identity());
+	if (same != byIdentity.end() && same->second->Definition() == pShaderModules->Definition()) {
+		Log(RAW, " \t(reuse cache shaders ↪ %s ...)", shaders.empty() ? "" : shaders[0].nameShaderFile);
+		delete pShaderModules;
+		pShaderModules = same->second;
+	} else {
+		Log(RAW, " \t(load new shader set → %s ...)", shaders.empty() ? "" : shaders[0].nameShaderFile);
+		if (same == byIdentity.end())
+			byIdentity[pShaderModules->Identity()] = pShaderModules;
+		entries[pShaderModules].refCount = 0;  // Will be incremented by addRef().
+	}
+	Named named = { .pShaderModules = pShaderModules };
+	for (const auto& shader : shaders)
+		named.names.push_back({ shader.fileType, shader.nameShaderFile,
+								shader.nameEntrypointFunction ? shader.nameEntrypointFunction : "" });
+	byNames.insert({ key, std::move(named) });
+	entries[pShaderModules].nameKeys.push_back(key);
 
 	return pShaderModules;
 }
@@ -62,10 +104,10 @@ void ShaderCache::addRef(ShaderModules* pShaderModules)
 	if (pShaderModules == nullptr)
 		return;
 
-	auto it = refCounts.find(pShaderModules);
-	if (it != refCounts.end()) {
-		it->second++;
-		Log(LOW, "ShaderCache: AddRef -> refcount = %d", it->second);
+	auto it = entries.find(pShaderModules);
+	if (it != entries.end()) {
+		it->second.refCount++;
+		Log(LOW, "ShaderCache: AddRef -> refcount = %d", it->second.refCount);
 	} else {
 		Log(WARN, "ShaderCache: AddRef called on untracked ShaderModules!");
 	}
@@ -76,25 +118,30 @@ void ShaderCache::release(ShaderModules* pShaderModules)
 	if (pShaderModules == nullptr)
 		return;
 
-	auto it = refCounts.find(pShaderModules);
-	if (it == refCounts.end()) {
+	auto it = entries.find(pShaderModules);
+	if (it == entries.end()) {
 		Log(WARN, "ShaderCache: Release called on untracked ShaderModules!");
 		return;
 	}
 
-	it->second--;
-	Log(LOW, "ShaderCache: Release -> refcount = %d", it->second);
+	it->second.refCount--;
+	Log(LOW, "ShaderCache: Release -> refcount = %d", it->second.refCount);
 
-	if (it->second <= 0) {
-		// Find and remove from cache.
-		for (auto cacheIt = shaderCache.begin(); cacheIt != shaderCache.end(); ++cacheIt) {
-			if (cacheIt->second == pShaderModules) {
-				Log(DEAD, "ShaderCache: Deleting shader set: %s", cacheIt->first.c_str());
-				delete pShaderModules;
-				shaderCache.erase(cacheIt);
-				break;
-			}
+	if (it->second.refCount <= 0) {
+		// Remove from cache, under every name.
+		Log(DEAD, "ShaderCache: Deleting shader set: %016llx", (unsigned long long) pShaderModules->Identity());
+		for (uint64_t nameKey : it->second.nameKeys) {
+			auto [first, last] = byNames.equal_range(nameKey);
+			for (auto named = first; named != last; ++named)
+				if (named->second.pShaderModules == pShaderModules) {
+					byNames.erase(named);
+					break;
+				}
 		}
-		refCounts.erase(it);
+		auto same = byIdentity.find(pShaderModules->Identity());
+		if (same != byIdentity.end() && same->second == pShaderModules)
+			byIdentity.erase(same);
+		entries.erase(it);
+		delete pShaderModules;
 	}
 }
@@ -3,8 +3,14 @@
 //	VulkanModule Adjunct
 //
 // Manages shared ShaderModules to avoid redundant shader loading.
-// Shaders are cached by their shader file names, and reference counted
-// for proper cleanup.
+// Shader sets are cached by a 64-bit key of their stages' file names and
+// entry points (see Key, which callers may precompute), so a repeat lookup
+// neither builds a string nor touches a file; the names are kept with each
+// entry and compared on a key match, so a collision is never mistaken for a
+// hit.  A set first loaded under new names is then matched by its SPIR-V
+// contents (ShaderModules::Identity), so identical shaders under different
+// file names share one ShaderModules.
+// Reference counted for proper cleanup.
 //
 // Created by Tadd Jensen
 //	© 0000 (uncopyrighted; use at will)
@@ -14,8 +20,7 @@
 
 #include "ShaderModules.h"
 #include "GraphicsDevice.h"
-#include <map>
-#include <string>
+#include <unordered_map>
 
 class ShaderCache
 {
@@ -23,9 +28,13 @@ public:
 	ShaderCache(GraphicsDevice& device);
 	~ShaderCache();
 
-	// Get or create ShaderModules for the given shader set
+	// Key of the given shader set by file names, stages and entry points
+	static uint64_t Key(const Shaders& shaders);
+
+	// Get or create ShaderModules for the given shader set (of precomputed key)
 	// Returns pointer to shared ShaderModules (do not delete directly!)
 	ShaderModules* getOrCreate(const Shaders& shaders);
+	ShaderModules* getOrCreate(const Shaders& shaders, uint64_t key);
 
 	// Increment reference count (called when a renderable uses these shaders)
 	void addRef(ShaderModules* pShaderModules);
@@ -37,14 +46,27 @@ public:
 private:
 	GraphicsDevice& graphicsDevice;
 
-	// Map shader names to ShaderModules instance
-	std::map<std::string, ShaderModules*> shaderCache;
+	// Map name keys (with the names they were made from), and content identities, to ShaderModules instance
+	struct ShaderName {
+		ShaderType	fileType;
+		string		nameShaderFile;
+		string		nameEntrypointFunction;
+	};
+	struct Named {
+		vector<ShaderName>	names;
+		ShaderModules*		pShaderModules;
 
-	// Reference counts for each ShaderModules instance
-	std::map<ShaderModules*, int> refCounts;
+		bool Matches(const Shaders& shaders) const;
+	};
+	std::unordered_multimap<uint64_t, Named>	 byNames;
+	std::unordered_map<uint64_t, ShaderModules*> byIdentity;
 
-	// Create a unique key from shader file names
-	std::string createKey(const Shaders& shaders) const;
+	// Reference count, and every name key aliasing it, for each ShaderModules instance
+	struct Entry {
+		int					refCount;
+		vector<uint64_t>	nameKeys;
+	};
+	std::unordered_map<ShaderModules*, Entry> entries;
 };
 
 #endif // ShaderCache_h
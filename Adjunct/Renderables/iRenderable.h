@@ -28,6 +28,9 @@
 #include "AddOns.h"
 #include "DrawableSpecifier.h"
 #include "PrimitiveBuffer.h"	// for updateVertexData() inline method
+#include "DynamicUniformBuffer.h"
+#include "Helpers.h"
+#include <limits>
 
 
 // A CommandBuffer object needs an array of Renderables that go into recording its VkCommandBuffer, with
@@ -64,22 +67,25 @@ struct iRenderableBase
 struct iRenderable : iRenderableBase
 {
 	iRenderable(DrawableSpecifier& specified, VulkanSetup& vulkan, iPlatform& platform,
-				iRenderPass* pCustomRenderPass = nullptr, VkExtent2D customExtent = { 0, 0 })
+				iRenderPass* pCustomRenderPass = nullptr)
 		:	shaderModules(	specified.pSharedShaderModules ? *specified.pSharedShaderModules
 													: * new ShaderModules(specified.shaders, vulkan.device)),
 			addOns(			* new AddOns(specified, vulkan, platform)),
-			descriptors(	* new Descriptors(addOns.described, vulkan.swapchain, vulkan.device)),
+			descriptors(	* new Descriptors(addOns.described, vulkan.swapchain, vulkan.device,
+											  specified.customize, &vulkan.frameConstants)),
 			pipeline(		* new GraphicsPipeline(shaderModules,
 												   (pCustomRenderPass != nullptr) ? *pCustomRenderPass : vulkan.renderPass,
-												   vulkan.swapchain, vulkan.device, &specified.mesh.vertexType,
-												   &descriptors, specified.customize, customExtent)),
+												   vulkan.device, &specified.mesh.vertexType,
+												   &descriptors, specified.customize, &specified.specialization)),
 			vertexObject(	specified.mesh),
 			customizer(		specified.customize),
 			name(			specified.name),
 			updateMethod(	specified.updateMethod),
 			ownsShaderModules(!specified.pSharedShaderModules),
 			pass(			specified.pass),
-			renderOrder(	specified.renderOrder)
+			renderOrder(	specified.renderOrder),
+			pushConstants(	specified.pushConstants),
+			specialization(	specified.specialization)
 	{
 		isSelfManaged = false;
 	}
@@ -109,11 +115,15 @@ struct iRenderable : iRenderableBase
 	bool				ownsShaderModules;	// true if we created it, false if shared
 	const char*			pass;				// Render pass type (nullptr for primary, or "transparency"/"lines"/"shadow")
 	int					renderOrder;		// Stable sort order within same pass (lower = rendered first)
+	DrawPushConstants	pushConstants;		// Pushed before each draw if customized PUSH_CONSTANTS; may change per frame.
+	SpecializationConstants	specialization;	// (retain for Recreate)
 
 	// Dynamic UBO support for efficient per-object transforms.
 	uint32_t			dynamicOffset = 0;
 	bool				hasDynamicOffset = false;
 
+	uint32_t			lod = 0;			// Level of detail drawn (see MeshObject.lods), as last selected.
+
 
 	virtual iRenderable* newConcretion(CommandRecording* pRecordingMode) const = 0;
 	virtual void IssueBindAndDrawCommands(VkCommandBuffer& commandBuffer, int bufferIndex = 0) = 0;
@@ -153,6 +163,21 @@ struct iRenderable : iRenderableBase
 		}
 	}
 
+	// Update per-instance data (see MeshObject.instances), e.g. as instances move, appear or disappear.
+	//	CRITICAL: Number of instances must not exceed the original instanceCount, no reallocation.
+	//	Uses direct CPU memory mapping, same as updateVertexData().
+	//	IMPORTANT: Also updates vertexObject.instanceCount for correct draw calls.
+	void updateInstanceData(void* pNewInstanceData, uint32_t numInstances)
+	{
+		if (addOns.pInstanceBuffer) {
+			VkDeviceSize size = numInstances * vertexObject.vertexType.instanceByteSize();
+			if (size > 0)
+				addOns.pInstanceBuffer->UpdateVertexBufferMapped(pNewInstanceData, size);
+
+			vertexObject.instanceCount = numInstances;
+		}
+	}
+
 	// Get secondary command buffer for a specific frame (only valid if IsSecondaryCommandBuffer() == true).
 	virtual VkCommandBuffer GetSecondaryCommandBuffer(int frameIndex) const { return VK_NULL_HANDLE; }
 
@@ -170,6 +195,93 @@ struct iRenderable : iRenderableBase
 		}
 	}
 
+	// Model matrix that places this renderable, wherever its UBOs carry one: its slot in a Dynamic UBO, or a
+	//	UBO(mat4&) / UBO(UBO_MVP&).  CPU-side, as last written by the app.  nullptr if there isn't one.
+	const mat4* modelMatrix()
+	{
+		for (UBO& ubo : addOns.ubos) {
+			if (ubo.isDynamic && hasDynamicOffset)
+				return &ubo.pDynamicUBO->getObjectTransform(ubo.pDynamicUBO->getObjectIndex(dynamicOffset));
+			if (ubo.pModel)
+				return ubo.pModel;
+		}
+		return nullptr;
+	}
+
+	// View matrix this renderable is seen through, i.e. from its UBO(UBO_VP&) / UBO(UBO_MVP&), or else
+	//	if SETS_BY_FREQUENCY, the shared FrameConstants'; or nullptr.
+	const mat4* viewMatrix()
+	{
+		for (UBO& ubo : addOns.ubos)
+			if (ubo.pView)
+				return ubo.pView;
+		if (customizer & SETS_BY_FREQUENCY)
+			return &addOns.vulkan.frameConstants.frame.camera.view;
+		return nullptr;
+	}
+
+	// Projection matrix likewise, from the same UBO as the view matrix, or nullptr.
+	const mat4* projectionMatrix()
+	{
+		for (UBO& ubo : addOns.ubos)
+			if (ubo.pProj)
+				return ubo.pProj;
+		if (customizer & SETS_BY_FREQUENCY)
+			return &addOns.vulkan.frameConstants.frame.camera.proj;
+		return nullptr;
+	}
+
+	// Distance in front of the camera, along its view direction, of this renderable's origin;
+	//	UNKNOWN_DEPTH if unknown (no model or view matrix to go by).
+	static constexpr float UNKNOWN_DEPTH = std::numeric_limits<float>::infinity();
+
+	float viewDepth()
+	{
+		const mat4* pModel = modelMatrix();
+		const mat4* pView  = viewMatrix();
+		if (! pModel || ! pView)
+			return UNKNOWN_DEPTH;
+		float z = ((*pView) * (*pModel)[3]).z;
+		return INVERT_Z ? z : -z;		// (right-handed view looks down -Z)
+	}
+
+	// Identify what this renderable's descriptor set binds, EXCEPT its model matrix: two renderables
+	//	with equal keys may draw as instances of one another.  UBOs are compared by the app-side data
+	//	they source from; textures by the file/image they load (not the per-renderable TextureImage).
+	//	Push constants count too, if pushed, as one instanced draw can push only one set of them.
+	//	(Except a bindless materialIndex: that is per TextureImage, where the textures' sources count.)
+	uint64_t materialKey()
+	{
+		uint64_t key = 0;
+		if (customizer & (PUSH_CONSTANTS | BINDLESS)) {
+			DrawPushConstants pushed = pushConstants;
+			pushed.materialIndex = 0;
+			key = hashBytes(&pushed, sizeof(pushed));
+		}
+
+		for (UBO& ubo : addOns.ubos)
+			if (! ubo.pModel)
+				hashCombine(key, ubo.isDynamic ? (uint64_t) ubo.pDynamicUBO : (uint64_t) ubo.pBytes);
+
+		for (TextureSpec& texspec : addOns.texspecs) {
+			if (texspec.wantMutable)		// (may be written per-renderable, so never equivalent)
+				hashCombine(key, (uint64_t) &texspec);
+			else if (texspec.fileName)
+				hashCombine(key, std::hash<string>()(texspec.fileName));
+			else
+				hashCombine(key, (uint64_t) texspec.pImageInfo);
+			hashCombine(key, (texspec.filterMode << 8) | texspec.wrapMode);
+		}
+
+		vector<DescribEd>& described = addOns.described;		// Runtime textures follow those (described, if not bindless).
+		size_t nTexturesDescribed = addOns.isBindless ? 0 : addOns.texspecs.size();
+		for (size_t iRuntime = addOns.ubos.size() + nTexturesDescribed; iRuntime < described.size(); ++iRuntime) {
+			hashCombine(key, (uint64_t) described[iRuntime].imageInfo.imageView);
+			hashCombine(key, (uint64_t) described[iRuntime].imageInfo.sampler);
+		}
+		return key;
+	}
+
 	virtual bool Update(GameClock& time)
 	{
 		if (updateMethod)
@@ -177,6 +289,8 @@ struct iRenderable : iRenderableBase
 		return false;
 	}
 
+	// Upon resize, nothing need be: the pipeline's viewport and scissor are dynamic state.
+	//
 	virtual void Recreate(VulkanSetup& vulkan, bool reloadMesh = false)
 	{
 		// also reload shaderModules if different shader(s) specified?
@@ -186,9 +300,10 @@ struct iRenderable : iRenderableBase
 			addOns.Recreate(vertexObject);
 			addOns.RecreateDescribables();
 			descriptors.Recreate(addOns.reDescribe(), vulkan.swapchain);
-		}
 
-		pipeline.Recreate(shaderModules, vulkan.renderPass, vulkan.swapchain, &vertexObject.vertexType, &descriptors, customizer);
+			pipeline.Recreate(shaderModules, vulkan.renderPass, &vertexObject.vertexType, &descriptors, customizer,
+							  &specialization);
+		}
 	}
 };
 
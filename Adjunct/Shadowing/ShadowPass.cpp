@@ -99,6 +99,7 @@ void ShadowPass::recordShadowPass(std::vector<iRenderable*>& shadowRenderables,
 	};
 
 	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	GraphicsPipeline::CmdSetViewportAndScissor(commandBuffer, renderPassInfo.renderArea.extent);
 
 	// Record shadow renderables (render geometry from light's perspective for depth)
 	for (iRenderable* pRenderable : shadowRenderables) {
@@ -0,0 +1,499 @@
+//
+// TextureContainer.cpp
+//	Vulkan Add-ons
+//
+// See matched header file for definitive main comment.
+//
+// File layouts per the Khronos KTX 2.0 specification and Microsoft's DDS documentation; both
+//	little-endian, as are all platforms this runs on.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "TextureContainer.h"
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+
+
+// Block dimensions, and bytes per block, of the formats whose level sizes are known (uncompressed:
+//	1 x 1 blocks).  A KTX2 of some other format is still loaded, trusting its level index.
+//
+struct FormatBlock {
+	VkFormat	format;
+	uint8_t		wide, high, nBytes;
+};
+
+#define ASTC(w, h)	{ VK_FORMAT_ASTC_##w##x##h##_UNORM_BLOCK, w, h, 16 }, \
+					{ VK_FORMAT_ASTC_##w##x##h##_SRGB_BLOCK,  w, h, 16 }
+
+static const FormatBlock FORMAT_BLOCKS[] = {
+	{ VK_FORMAT_BC1_RGB_UNORM_BLOCK,		4, 4,  8 },	{ VK_FORMAT_BC1_RGB_SRGB_BLOCK,		4, 4,  8 },
+	{ VK_FORMAT_BC1_RGBA_UNORM_BLOCK,		4, 4,  8 },	{ VK_FORMAT_BC1_RGBA_SRGB_BLOCK,	4, 4,  8 },
+	{ VK_FORMAT_BC2_UNORM_BLOCK,			4, 4, 16 },	{ VK_FORMAT_BC2_SRGB_BLOCK,			4, 4, 16 },
+	{ VK_FORMAT_BC3_UNORM_BLOCK,			4, 4, 16 },	{ VK_FORMAT_BC3_SRGB_BLOCK,			4, 4, 16 },
+	{ VK_FORMAT_BC4_UNORM_BLOCK,			4, 4,  8 },	{ VK_FORMAT_BC4_SNORM_BLOCK,		4, 4,  8 },
+	{ VK_FORMAT_BC5_UNORM_BLOCK,			4, 4, 16 },	{ VK_FORMAT_BC5_SNORM_BLOCK,		4, 4, 16 },
+	{ VK_FORMAT_BC6H_UFLOAT_BLOCK,			4, 4, 16 },	{ VK_FORMAT_BC6H_SFLOAT_BLOCK,		4, 4, 16 },
+	{ VK_FORMAT_BC7_UNORM_BLOCK,			4, 4, 16 },	{ VK_FORMAT_BC7_SRGB_BLOCK,			4, 4, 16 },
+	{ VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK,	4, 4,  8 },	{ VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK,		4, 4,  8 },
+	{ VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK,	4, 4,  8 },	{ VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK,	4, 4,  8 },
+	{ VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK,	4, 4, 16 },	{ VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,	4, 4, 16 },
+	{ VK_FORMAT_EAC_R11_UNORM_BLOCK,		4, 4,  8 },	{ VK_FORMAT_EAC_R11_SNORM_BLOCK,		4, 4,  8 },
+	{ VK_FORMAT_EAC_R11G11_UNORM_BLOCK,		4, 4, 16 },	{ VK_FORMAT_EAC_R11G11_SNORM_BLOCK,		4, 4, 16 },
+	ASTC(4, 4),  ASTC(5, 4),  ASTC(5, 5),  ASTC(6, 5),  ASTC(6, 6),  ASTC(8, 5),  ASTC(8, 6),
+	ASTC(8, 8),  ASTC(10, 5), ASTC(10, 6), ASTC(10, 8), ASTC(10, 10), ASTC(12, 10), ASTC(12, 12),
+	{ VK_FORMAT_R8G8B8A8_UNORM,	1, 1, 4 },	{ VK_FORMAT_R8G8B8A8_SRGB,	1, 1, 4 },
+	{ VK_FORMAT_B8G8R8A8_UNORM,	1, 1, 4 },	{ VK_FORMAT_B8G8R8A8_SRGB,	1, 1, 4 }
+};
+
+#undef ASTC
+
+static const FormatBlock* findBlock(VkFormat format)
+{
+	for (const FormatBlock& block : FORMAT_BLOCKS)
+		if (block.format == format)
+			return &block;
+	return nullptr;
+}
+
+// (0 if not known)
+static size_t levelSize(VkFormat format, int32_t wide, int32_t high)
+{
+	const FormatBlock* pBlock = findBlock(format);
+	if (! pBlock)
+		return 0;
+	size_t blocksWide = (wide + pBlock->wide - 1) / pBlock->wide;
+	size_t blocksHigh = (high + pBlock->high - 1) / pBlock->high;
+	return blocksWide * blocksHigh * pBlock->nBytes;
+}
+
+
+TextureContainer::TextureContainer(const string& path)
+	:	pathName(path),
+		file(path)
+{
+	Log(RAW, "Load: texture container - file: %s", pathName.c_str());
+
+	if (file.size() >= 4 && memcmp(file.data(), "DDS ", 4) == 0)
+		parseDDS();
+	else
+		parseKTX2();
+
+	Log(RAW, "      %s, %d x %d, %d mip levels", AltVkFormatString(format),
+				levels[0].wide, levels[0].high, (int) levels.size());
+}
+
+bool TextureContainer::IsContainerFile(StrPtr fileName)
+{
+	StrPtr pDot = fileName ? strrchr(fileName, '.') : nullptr;
+	if (! pDot)
+		return false;
+
+	string extension(pDot + 1);
+	for (char& ch : extension)
+		ch = (char) tolower((unsigned char) ch);
+	return extension == "ktx2" || extension == "dds";
+}
+
+bool TextureContainer::IsBlockCompressed(VkFormat format)
+{
+	const FormatBlock* pBlock = findBlock(format);
+	return pBlock && pBlock->wide > 1;
+}
+
+uint32_t TextureContainer::TexelBlockBytes(VkFormat format)
+{
+	const FormatBlock* pBlock = findBlock(format);
+	return pBlock ? pBlock->nBytes : 0;
+}
+
+void TextureContainer::fail(const string& reason)
+{
+	Fatal("Texture container \"" + pathName + "\": " + reason);
+}
+
+// Neither dimension zero nor past what int32_t holds, and no more mip levels than halving the larger
+//	of them down to 1 makes: floor(log2(max(wide, high))) + 1.
+//
+void TextureContainer::vetSize(uint32_t baseWide, uint32_t baseHigh, uint32_t numLevels)
+{
+	if (baseWide == 0 || baseHigh == 0)
+		fail("zero width or height");
+	if (baseWide > INT32_MAX || baseHigh > INT32_MAX)
+		fail("implausible width or height");
+
+	uint32_t maxLevels = 1;
+	for (uint32_t size = std::max(baseWide, baseHigh); size > 1; size >>= 1)
+		++maxLevels;
+	if (numLevels > maxLevels)
+		fail(to_string(numLevels) + " mip levels, but " + to_string(baseWide) + " x " + to_string(baseHigh)
+			 + " has only " + to_string(maxLevels));
+}
+
+// Mip level iLevel, at `offset` in the file, of the size its format requires (if known).
+//
+void TextureContainer::addLevel(size_t offset, size_t nBytes, uint32_t iLevel, int32_t baseWide, int32_t baseHigh)
+{
+	int32_t wide = std::max(baseWide >> iLevel, 1);
+	int32_t high = std::max(baseHigh >> iLevel, 1);
+
+	if (offset > file.size() || nBytes > file.size() - offset)
+		fail("mip level " + to_string(iLevel) + " extends past end of file");
+	if (nBytes == 0 || nBytes < levelSize(format, wide, high))
+		fail("mip level " + to_string(iLevel) + " is short");
+
+	levels.push_back({
+		.pBytes	= file.data() + offset,
+		.nBytes	= nBytes,
+		.wide	= wide,
+		.high	= high
+	});
+}
+
+
+#pragma mark - KTX2
+
+struct KTX2Header {
+	uint8_t		identifier[12];
+	uint32_t	vkFormat;
+	uint32_t	typeSize;
+	uint32_t	pixelWidth,	pixelHeight, pixelDepth;
+	uint32_t	layerCount, faceCount, levelCount;
+	uint32_t	supercompressionScheme;
+	uint32_t	dfdByteOffset, dfdByteLength;	// (data format descriptor,
+	uint32_t	kvdByteOffset, kvdByteLength;	//	key/value data,
+	uint64_t	sgdByteOffset, sgdByteLength;	//	supercompression global data: all unused)
+};
+static_assert(sizeof(KTX2Header) == 80);
+
+struct KTX2LevelIndex {			// (one per level, following the header, level 0 first)
+	uint64_t	byteOffset, byteLength, uncompressedByteLength;
+};
+
+static const uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+void TextureContainer::parseKTX2()
+{
+	KTX2Header header;
+	if (file.size() < sizeof(header))
+		fail("neither KTX2 nor DDS (too short)");
+	memcpy(&header, file.data(), sizeof(header));
+
+	if (memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+		fail("neither KTX2 nor DDS");
+	if (header.supercompressionScheme != 0 || header.vkFormat == VK_FORMAT_UNDEFINED)
+		fail("supercompressed (Basis Universal, Zstandard...) KTX2 not supported; re-export without");
+	if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount > 1)
+		fail("only 2D textures supported, not arrays, cubemaps or volumes");
+
+	format = (VkFormat) header.vkFormat;
+
+	uint32_t numLevels = std::max(header.levelCount, 1u);	// (0: "generate them," but here just 1)
+	vetSize(header.pixelWidth, std::max(header.pixelHeight, 1u), numLevels);
+	if (file.size() < sizeof(header) + numLevels * sizeof(KTX2LevelIndex))
+		fail("truncated level index");
+
+	const char* pIndex = file.data() + sizeof(header);
+	for (uint32_t iLevel = 0; iLevel < numLevels; ++iLevel) {
+		KTX2LevelIndex index;
+		memcpy(&index, pIndex + iLevel * sizeof(index), sizeof(index));
+		addLevel((size_t) index.byteOffset, (size_t) index.byteLength, iLevel,
+				 (int32_t) header.pixelWidth, (int32_t) std::max(header.pixelHeight, 1u));
+	}
+}
+
+
+#pragma mark - DDS
+
+struct DDSPixelFormat {
+	uint32_t	size, flags, fourCC;
+	uint32_t	rgbBitCount, rBitMask, gBitMask, bBitMask, aBitMask;
+};
+
+struct DDSHeader {
+	uint32_t	magic;			// "DDS "
+	uint32_t	size;			// 124 (not counting magic)
+	uint32_t	flags, height, width, pitchOrLinearSize, depth, mipMapCount;
+	uint32_t	reserved1[11];
+	DDSPixelFormat	pixelFormat;
+	uint32_t	caps, caps2, caps3, caps4, reserved2;
+};
+static_assert(sizeof(DDSHeader) == 128);
+
+struct DDSHeaderDX10 {			// (following the header, if pixelFormat.fourCC is "DX10")
+	uint32_t	dxgiFormat, resourceDimension, miscFlag, arraySize, miscFlags2;
+};
+
+const uint32_t DDPF_FOURCC		  = 0x4,
+			   DDPF_RGB			  = 0x40,
+			   DDSCAPS2_CUBEMAP	  = 0x200,
+			   DDSCAPS2_VOLUME	  = 0x200000,
+			   DDS_MISC_TEXTURECUBE = 0x4,
+			   DDS_DIMENSION_TEXTURE2D = 3;
+
+constexpr uint32_t FourCC(const char (&code)[5])
+{
+	return (uint32_t) code[0] | (uint32_t) code[1] << 8 | (uint32_t) code[2] << 16 | (uint32_t) code[3] << 24;
+}
+
+static VkFormat formatFromFourCC(uint32_t fourCC)
+{
+	switch (fourCC) {
+		case FourCC("DXT1"):	return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case FourCC("DXT2"):
+		case FourCC("DXT3"):	return VK_FORMAT_BC2_UNORM_BLOCK;
+		case FourCC("DXT4"):
+		case FourCC("DXT5"):	return VK_FORMAT_BC3_UNORM_BLOCK;
+		case FourCC("ATI1"):
+		case FourCC("BC4U"):	return VK_FORMAT_BC4_UNORM_BLOCK;
+		case FourCC("BC4S"):	return VK_FORMAT_BC4_SNORM_BLOCK;
+		case FourCC("ATI2"):
+		case FourCC("BC5U"):	return VK_FORMAT_BC5_UNORM_BLOCK;
+		case FourCC("BC5S"):	return VK_FORMAT_BC5_SNORM_BLOCK;
+		default:				return VK_FORMAT_UNDEFINED;
+	}
+}
+
+static VkFormat formatFromDXGI(uint32_t dxgiFormat)
+{
+	switch (dxgiFormat) {
+		case 28:	return VK_FORMAT_R8G8B8A8_UNORM;		// DXGI_FORMAT_R8G8B8A8_UNORM
+		case 29:	return VK_FORMAT_R8G8B8A8_SRGB;			//	 "	 R8G8B8A8_UNORM_SRGB
+		case 71:	return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;	//	 "	 BC1_UNORM
+		case 72:	return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;	//	 "	 BC1_UNORM_SRGB
+		case 74:	return VK_FORMAT_BC2_UNORM_BLOCK;
+		case 75:	return VK_FORMAT_BC2_SRGB_BLOCK;
+		case 77:	return VK_FORMAT_BC3_UNORM_BLOCK;
+		case 78:	return VK_FORMAT_BC3_SRGB_BLOCK;
+		case 80:	return VK_FORMAT_BC4_UNORM_BLOCK;
+		case 81:	return VK_FORMAT_BC4_SNORM_BLOCK;
+		case 83:	return VK_FORMAT_BC5_UNORM_BLOCK;
+		case 84:	return VK_FORMAT_BC5_SNORM_BLOCK;
+		case 87:	return VK_FORMAT_B8G8R8A8_UNORM;
+		case 91:	return VK_FORMAT_B8G8R8A8_SRGB;
+		case 95:	return VK_FORMAT_BC6H_UFLOAT_BLOCK;		// DXGI_FORMAT_BC6H_UF16
+		case 96:	return VK_FORMAT_BC6H_SFLOAT_BLOCK;		//	 "	 BC6H_SF16
+		case 98:	return VK_FORMAT_BC7_UNORM_BLOCK;
+		case 99:	return VK_FORMAT_BC7_SRGB_BLOCK;
+		default:	return VK_FORMAT_UNDEFINED;
+	}
+}
+
+// Levels follow the header(s), largest first, each of the size its format requires.
+//
+void TextureContainer::parseDDS()
+{
+	DDSHeader header;
+	if (file.size() < sizeof(header))
+		fail("truncated DDS header");
+	memcpy(&header, file.data(), sizeof(header));
+
+	if (header.size != sizeof(header) - sizeof(header.magic))
+		fail("unrecognized DDS header");
+	if (header.caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+		fail("only 2D textures supported, not cubemaps or volumes");
+
+	size_t offset = sizeof(header);
+	DDSPixelFormat& pixelFormat = header.pixelFormat;
+
+	if ((pixelFormat.flags & DDPF_FOURCC) && pixelFormat.fourCC == FourCC("DX10")) {
+		DDSHeaderDX10 extended;
+		if (file.size() < offset + sizeof(extended))
+			fail("truncated DX10 header");
+		memcpy(&extended, file.data() + offset, sizeof(extended));
+		offset += sizeof(extended);
+
+		if (extended.resourceDimension != DDS_DIMENSION_TEXTURE2D || extended.arraySize > 1
+		 || (extended.miscFlag & DDS_MISC_TEXTURECUBE))
+			fail("only 2D textures supported, not arrays, cubemaps or volumes");
+		format = formatFromDXGI(extended.dxgiFormat);
+	}
+	else if (pixelFormat.flags & DDPF_FOURCC)
+		format = formatFromFourCC(pixelFormat.fourCC);
+	else if ((pixelFormat.flags & DDPF_RGB) && pixelFormat.rgbBitCount == 32) {
+		if (pixelFormat.rBitMask == 0x000000FF && pixelFormat.gBitMask == 0x0000FF00 && pixelFormat.bBitMask == 0x00FF0000)
+			format = VK_FORMAT_R8G8B8A8_UNORM;
+		else if (pixelFormat.rBitMask == 0x00FF0000 && pixelFormat.gBitMask == 0x0000FF00 && pixelFormat.bBitMask == 0x000000FF)
+			format = VK_FORMAT_B8G8R8A8_UNORM;
+	}
+	if (format == VK_FORMAT_UNDEFINED)
+		fail("DDS pixel format not supported");
+
+	uint32_t numLevels = std::max(header.mipMapCount, 1u);
+	vetSize(header.width, header.height, numLevels);
+
+	for (uint32_t iLevel = 0; iLevel < numLevels; ++iLevel) {
+		int32_t wide = std::max((int32_t) header.width  >> iLevel, 1);
+		int32_t high = std::max((int32_t) header.height >> iLevel, 1);
+		size_t nBytes = levelSize(format, wide, high);
+		addLevel(offset, nBytes, iLevel, (int32_t) header.width, (int32_t) header.height);
+		offset += nBytes;
+	}
+}
+
+
+#pragma mark - Transcoding
+
+// BC1 through BC5, as specified by Khronos Data Format (section "S3TC" and "RGTC"), each 4 x 4 block
+//	decoded to 16 texels of R8G8B8A8.  (Not BC6H or BC7, nor ETC2, EAC or ASTC: far larger decoders,
+//	and devices lacking one of those usually have the others.)
+//
+bool TextureContainer::CanTranscode(VkFormat format)
+{
+	switch (format) {
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:	 case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC2_UNORM_BLOCK:		 case VK_FORMAT_BC2_SRGB_BLOCK:
+		case VK_FORMAT_BC3_UNORM_BLOCK:		 case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+			return true;
+		default:
+			return false;
+	}
+}
+
+VkFormat TextureContainer::TranscodedFormat(VkFormat format)
+{
+	switch (format) {
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC2_SRGB_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+			return VK_FORMAT_R8G8B8A8_SRGB;
+		default:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+typedef uint8_t	Texels[16][4];		// (a block's, row by row)
+
+static void expand565(uint16_t color, uint8_t* pRGBA)
+{
+	uint8_t red	  = (color >> 11) & 0x1F,
+			green = (color >> 5)  & 0x3F,
+			blue  =  color		  & 0x1F;
+	pRGBA[0] = (red	  << 3) | (red	 >> 2);
+	pRGBA[1] = (green << 2) | (green >> 4);
+	pRGBA[2] = (blue  << 3) | (blue	 >> 2);
+	pRGBA[3] = 255;
+}
+
+// Two RGB565 endpoints and two interpolated between, chosen per texel by 2-bit index.  BC1 alone
+//	may instead interpolate one, the fourth being transparent black (if color0 <= color1).
+//
+static void decodeColorBlock(const uint8_t* pBlock, Texels& texels, bool isBC1)
+{
+	uint16_t color0 = pBlock[0] | pBlock[1] << 8,
+			 color1 = pBlock[2] | pBlock[3] << 8;
+
+	uint8_t colors[4][4];
+	expand565(color0, colors[0]);
+	expand565(color1, colors[1]);
+
+	if (color0 > color1 || ! isBC1)
+		for (int ch = 0; ch < 3; ++ch) {
+			colors[2][ch] = (2 * colors[0][ch] + colors[1][ch]) / 3;
+			colors[3][ch] = (colors[0][ch] + 2 * colors[1][ch]) / 3;
+		}
+	else
+		for (int ch = 0; ch < 3; ++ch) {
+			colors[2][ch] = (colors[0][ch] + colors[1][ch]) / 2;
+			colors[3][ch] = 0;
+		}
+	colors[2][3] = 255;
+	colors[3][3] = (color0 > color1 || ! isBC1) ? 255 : 0;
+
+	uint32_t indices = pBlock[4] | pBlock[5] << 8 | pBlock[6] << 16 | (uint32_t) pBlock[7] << 24;
+	for (int iTexel = 0; iTexel < 16; ++iTexel)
+		memcpy(texels[iTexel], colors[(indices >> (2 * iTexel)) & 0x3], 4);
+}
+
+// BC2 alpha: 4 bits per texel, as is.
+//
+static void decodeExplicitAlpha(const uint8_t* pBlock, Texels& texels)
+{
+	for (int iTexel = 0; iTexel < 16; ++iTexel)
+		texels[iTexel][3] = ((pBlock[iTexel / 2] >> (4 * (iTexel & 1))) & 0xF) * 17;
+}
+
+// BC4 (and BC3 alpha, BC5 red/green): two 8-bit endpoints and six values interpolated between (or
+//	four, plus 0 and 255, if value0 <= value1), chosen per texel by 3-bit index.
+//
+static void decodeChannelBlock(const uint8_t* pBlock, Texels& texels, int channel)
+{
+	uint8_t values[8] = { pBlock[0], pBlock[1] };
+
+	if (values[0] > values[1])
+		for (int i = 1; i <= 6; ++i)
+			values[1 + i] = ((7 - i) * values[0] + i * values[1]) / 7;
+	else {
+		for (int i = 1; i <= 4; ++i)
+			values[1 + i] = ((5 - i) * values[0] + i * values[1]) / 5;
+		values[6] = 0;
+		values[7] = 255;
+	}
+
+	uint64_t indices = 0;
+	for (int iByte = 0; iByte < 6; ++iByte)
+		indices |= (uint64_t) pBlock[2 + iByte] << (8 * iByte);
+	for (int iTexel = 0; iTexel < 16; ++iTexel)
+		texels[iTexel][channel] = values[(indices >> (3 * iTexel)) & 0x7];
+}
+
+// Into pRGBA, TranscodedSize(level) bytes, R8G8B8A8 (of TranscodedFormat) texels; if CanTranscode.
+//
+void TextureContainer::Transcode(VkFormat format, const Level& level, uint8_t* pRGBA)
+{
+	const FormatBlock* pBlock = findBlock(format);
+	if (! CanTranscode(format) || ! pBlock)
+		return;
+
+	const uint8_t* pSource = (const uint8_t*) level.pBytes;
+	int32_t blocksWide = (level.wide + 3) / 4,
+			blocksHigh = (level.high + 3) / 4;
+
+	for (int32_t yBlock = 0; yBlock < blocksHigh; ++yBlock)
+		for (int32_t xBlock = 0; xBlock < blocksWide; ++xBlock, pSource += pBlock->nBytes) {
+			Texels texels;
+			switch (format) {
+				case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+				case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+					decodeColorBlock(pSource, texels, true);
+					for (int iTexel = 0; iTexel < 16; ++iTexel)
+						texels[iTexel][3] = 255;		// (no alpha: "transparent" black is just black)
+					break;
+				case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+				case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+					decodeColorBlock(pSource, texels, true);
+					break;
+				case VK_FORMAT_BC2_UNORM_BLOCK:
+				case VK_FORMAT_BC2_SRGB_BLOCK:
+					decodeColorBlock(pSource + 8, texels, false);
+					decodeExplicitAlpha(pSource, texels);
+					break;
+				case VK_FORMAT_BC3_UNORM_BLOCK:
+				case VK_FORMAT_BC3_SRGB_BLOCK:
+					decodeColorBlock(pSource + 8, texels, false);
+					decodeChannelBlock(pSource, texels, 3);
+					break;
+				default:								// BC4, BC5
+					for (int iTexel = 0; iTexel < 16; ++iTexel) {
+						texels[iTexel][1] = texels[iTexel][2] = 0;
+						texels[iTexel][3] = 255;
+					}
+					decodeChannelBlock(pSource, texels, 0);
+					if (format == VK_FORMAT_BC5_UNORM_BLOCK)
+						decodeChannelBlock(pSource + 8, texels, 1);
+			}
+
+			for (int32_t y = 0; y < 4; ++y)				// (edge blocks overhang a level not a multiple of 4)
+				for (int32_t x = 0; x < 4; ++x) {
+					int32_t xTexel = xBlock * 4 + x,
+							yTexel = yBlock * 4 + y;
+					if (xTexel < level.wide && yTexel < level.high)
+						memcpy(pRGBA + ((size_t) yTexel * level.wide + xTexel) * 4, texels[y * 4 + x], 4);
+				}
+		}
+}
@@ -0,0 +1,68 @@
+//
+// TextureContainer.h
+//	Vulkan Add-ons
+//
+// Read a GPU-ready texture file, KTX2 (.ktx2) or DDS (.dds), whose pixels are already in a VkFormat a
+//	device samples directly (typically block-compressed: BCn, ETC2, ASTC) along with all its pre-baked
+//	mip levels, so that they need only be copied, not decoded, nor mipmaps generated.  Versus a PNG or
+//	JPEG, decoded to 32 bits per texel: 4 to 8 times less memory, for both VRAM and sampling bandwidth.
+//
+// The file is memory-mapped; each Level points into it.  Only 2D textures: no arrays, cubemaps or
+//	volumes, nor supercompressed KTX2 (Basis Universal, Zstandard).  Where the device doesn't support
+//	a file's format (see GraphicsDevice::IsImageFormatSupported) it may be transcoded to R8G8B8A8 on
+//	the CPU, as BC1 through BC5 (unsigned) can; losing the savings, but still drawn.
+//
+// Loaded by TextureLoader (see its decode), chosen by file extension.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef TextureContainer_h
+#define TextureContainer_h
+
+#include "VulkanPlatform.h"
+#include "FileSystem.h"
+
+
+class TextureContainer
+{
+public:
+	TextureContainer(const string& pathName);		// (Fatal if not a KTX2 or DDS that can be read)
+
+	struct Level {
+		const char*	pBytes;
+		size_t		nBytes;
+		int32_t		wide, high;
+	};
+
+		// MEMBERS
+private:
+	string			pathName;
+	MappedFile		file;
+	VkFormat		format = VK_FORMAT_UNDEFINED;
+	vector<Level>	levels;			// [0] full size, then each mip level smaller
+
+		// METHODS
+public:
+	static bool		IsContainerFile(StrPtr fileName);		// (by extension)
+	static bool		IsBlockCompressed(VkFormat format);
+	static uint32_t	TexelBlockBytes(VkFormat format);		// (of a texel, or block if compressed; 0 if not known)
+
+	static bool		CanTranscode(VkFormat format);
+	static VkFormat	TranscodedFormat(VkFormat format);		// (R8G8B8A8, sRGB if `format` is)
+	static VkDeviceSize TranscodedSize(const Level& level)	{ return (VkDeviceSize) level.wide * level.high * 4; }
+	static void		Transcode(VkFormat format, const Level& level, uint8_t* pRGBA);
+private:
+	void	parseKTX2();
+	void	parseDDS();
+	void	vetSize(uint32_t baseWide, uint32_t baseHigh, uint32_t numLevels);
+	void	addLevel(size_t offset, size_t nBytes, uint32_t iLevel, int32_t baseWide, int32_t baseHigh);
+	void	fail(const string& reason);
+
+		// getters
+public:
+	VkFormat				getFormat()	{ return format; }
+	const vector<Level>&	getLevels()	{ return levels; }
+};
+
+#endif	// TextureContainer_h
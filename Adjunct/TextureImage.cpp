@@ -8,6 +8,7 @@
 //	© 0000 (uncopyrighted; use at will)
 //
 #include "TextureImage.h"
+#include "TextureContainer.h"
 #include "FileSystem.h"
 
 #include "iPlatform.h"
@@ -17,13 +18,19 @@
 
 
 TextureImage::TextureImage(TextureSpec& texSpec, VkCommandPool& pool, GraphicsDevice& device,
-						   iPlatform& platform, VkSampler injectedSampler)
+						   iPlatform& platform, VkSampler injectedSampler, TextureLoader* pLoader, bool wantBindless)
 	:	ImageResource(device, &mipmaps),
 		CommandBufferBase(pool, device),
 		mipmaps(pool, device),
-		specified(texSpec)
+		specified(texSpec),
+		bindless(device.getBindless())
 {
-	if (texSpec.fileName)
+	if (pLoader)
+		pMipmapGenerator = &pLoader->getMipmapGenerator();
+
+	if (texSpec.fileName && pLoader && ! texSpec.wantMutable)
+		createLoaded(texSpec, *pLoader);
+	else if (texSpec.fileName)
 		create(texSpec, device, platform);
 	else if (texSpec.pImageInfo)// && texSpec.pImageInfo->numBytes)
 		createBlank(*texSpec.pImageInfo, device, platform);
@@ -38,10 +45,15 @@ TextureImage::TextureImage(TextureSpec& texSpec, VkCommandPool& pool, GraphicsDe
 	} else {
 		createSampler(texSpec);
 	}
+	if (wantBindless && bindless.IsEnabled())
+		bindlessIndex = bindless.RegisterImage(getDescriptorImageInfo());
 }
 
 TextureImage::~TextureImage()
 {
+	upload.Wait();		// (its image mustn't go before the loader's done with it)
+	if (bindlessIndex != BindlessDescriptors::NO_SLOT)
+		bindless.UnregisterImage(bindlessIndex);
 	if (! wasSamplerInjected)
 		vkDestroySampler(device, sampler, nullptr);
 	if (pStagingBuffer) {
@@ -56,8 +68,51 @@ void TextureImage::ReGenerateMipmaps()
 {
 	if (pStagingBuffer)	// i.e. wantMutable && texSpec.filterMode == MIPMAP)
 	{
-		mipmaps.Generate(image, imageInfo.format, imageInfo.wide, imageInfo.high);
+		generateMipmaps(imageInfo.format, imageInfo.wide, imageInfo.high);
+	}
+}
+
+// Whether mipmaps can be generated for this format, adding to image usage what that needs (STORAGE,
+//	if by compute).  If not, it's warned of, for the image to be created with just its one level.
+//
+bool TextureImage::planMipmaps(VkFormat format, VkImageUsageFlags& usage)
+{
+	MipmapGenerator::Method method = MipmapGenerator::BLIT;
+	if (pMipmapGenerator)
+		method = pMipmapGenerator->MethodFor(format);
+	else {
+		VkFormatProperties formatProperties;	// (as Mipmaps::Generate requires)
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+		if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+			method = MipmapGenerator::UNSUPPORTED;
 	}
+
+	if (method == MipmapGenerator::COMPUTE)
+		usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+	else if (method == MipmapGenerator::UNSUPPORTED) {
+		Log(WARN, "Texture %s format %s can't have mipmaps generated; created without.",
+				  specified.fileName ? specified.fileName : "(blank)", AltVkFormatString(format));
+		return false;
+	}
+	return true;
+}
+
+// Every level but 0 (which is TRANSFER_DST_OPTIMAL, as are they) from the level above it, by the
+//	loader's MipmapGenerator if there is one (blit, else compute), else Mipmaps (blit only).
+//
+void TextureImage::generateMipmaps(VkFormat format, int32_t wide, int32_t high)
+{
+	if (! pMipmapGenerator) {
+		mipmaps.Generate(image, format, wide, high);
+		return;
+	}
+	VkCommandBuffer commands = beginSingleSubmitCommands();
+
+	MipmapGenerator::Scratch scratch;
+	pMipmapGenerator->Record(commands, { { image, format, wide, high, mipmaps.NumLevels() } }, scratch);
+
+	endAndSubmitCommands(commands);
+	pMipmapGenerator->Release(scratch);
 }
 
 
@@ -65,6 +120,9 @@ void TextureImage::create(TextureSpec& texSpec, GraphicsDevice& graphicsDevice,
 {
 	VkImageTiling tiling = /*texSpec.wantMutable ? VK_IMAGE_TILING_LINEAR :*/ VK_IMAGE_TILING_OPTIMAL;	//TODO: uncomment when handled better:
 														   //TODO: ^this^ presumed necessary, but MoltenVK error: VK_ERROR_FEATURE_NOT_PRESENT
+	if (TextureContainer::IsContainerFile(texSpec.fileName))
+		Fatal("Texture " + string(texSpec.fileName) + " must load by TextureLoader (nor be wantMutable).");
+
 	string fileFullPath = FileSystem::TextureFileFullPath(texSpec.fileName);
 
 	imageInfo = platform.ImageSource().Load(fileFullPath.c_str());
@@ -83,17 +141,22 @@ void TextureImage::create(TextureSpec& texSpec, GraphicsDevice& graphicsDevice,
 
 	pStagingBuffer->CopyInImageData(texSpec);
 
-	createImage(width, height, format, tiling,
-				VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+							| VK_IMAGE_USAGE_SAMPLED_BIT;
+	bool mipmap = texSpec.filterMode == MIPMAP || texSpec.filterMode == MIPMAP_SHARP;
+	if (mipmap)
+		mipmap = planMipmaps(format, usage);
+
+	createImage(width, height, format, tiling, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				mipmap ? 0 : 1);
 
 	transitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED,					// from
 						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);					// <- to
 
 	pStagingBuffer->CopyOutToTextureImage();
 
-	if (texSpec.filterMode == MIPMAP || texSpec.filterMode == MIPMAP_SHARP)
-		mipmaps.Generate(image, format, width, height);
+	if (mipmap)
+		generateMipmaps(format, width, height);
 	else
 		transitionImageLayout(image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,	// from
 							  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);			// <- to
@@ -104,6 +167,40 @@ void TextureImage::create(TextureSpec& texSpec, GraphicsDevice& graphicsDevice,
 	}
 }
 
+// Decoded by the loader (already, if prefetched), then its transition, copy and mipmaps recorded along
+//	with other textures' at the loader's next Submit.
+// Pre-baked mip levels, or a block-compressed format (which can't be blitted), mean the image gets
+//	only the levels staged, none generated.  A format neither blittable nor downsampled by compute
+//	(see MipmapGenerator::MethodFor) gets just its one level, with a warning.
+//
+void TextureImage::createLoaded(TextureSpec& texSpec, TextureLoader& loader)
+{
+	TextureLoader::Staged staged = loader.Take(texSpec.fileName, texSpec.flipVertical);
+
+	imageInfo = staged.info;
+	imageInfo.pPixels = nullptr;	// (staging memory, reused once uploaded)
+
+	uint32_t numStaged	= (uint32_t) staged.regions.size();
+	bool	 isPrebaked	= numStaged > 1 || TextureContainer::IsBlockCompressed(imageInfo.format);
+
+	bool isMipmapped	 = texSpec.filterMode == MIPMAP || texSpec.filterMode == MIPMAP_SHARP;
+	bool generateMipmaps = isMipmapped && ! isPrebaked;
+
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+							| VK_IMAGE_USAGE_SAMPLED_BIT;
+	uint32_t numLevels = isPrebaked ? numStaged : 0;
+
+	if (generateMipmaps && ! planMipmaps(imageInfo.format, usage)) {
+		generateMipmaps = false;
+		numLevels = 1;
+	}
+
+	createImage(imageInfo.wide, imageInfo.high, imageInfo.format, VK_IMAGE_TILING_OPTIMAL,
+				usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, numLevels);
+
+	upload = loader.Upload(image, staged, mipmaps.NumLevels(), generateMipmaps);
+}
+
 void TextureImage::createBlank(ImageInfo& params, GraphicsDevice& graphicsDevice, iPlatform& platform, bool mipmap)
 {
 	imageInfo = params;
@@ -119,9 +216,13 @@ void TextureImage::createBlank(ImageInfo& params, GraphicsDevice& graphicsDevice
 		pStagingBuffer->Clear();
 	}
 
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+							| VK_IMAGE_USAGE_SAMPLED_BIT;
+	if (mipmap)
+		mipmap = planMipmaps(params.format, usage);
+
 	createImage(params.wide, params.high, params.format, VK_IMAGE_TILING_OPTIMAL,
-				VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+				usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipmap ? 0 : 1);
 
 	transitionImageLayout(image, params.format, VK_IMAGE_LAYOUT_UNDEFINED,					// from
 						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);							// <- to
@@ -129,7 +230,7 @@ void TextureImage::createBlank(ImageInfo& params, GraphicsDevice& graphicsDevice
 	pStagingBuffer->CopyOutToTextureImage();
 
 	if (mipmap)
-		mipmaps.Generate(image, params.format, params.wide, params.high);
+		generateMipmaps(params.format, params.wide, params.high);
 	else
 		transitionImageLayout(image, params.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,	// from
 							  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);					// <- to
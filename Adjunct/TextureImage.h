@@ -10,6 +10,16 @@
 //	Exclude file name and wantMutable TRUE to create an empty texture that's writable,
 //	providing size/format via ImageInfo.
 //
+// Given a TextureLoader, an image file is instead decoded on its worker threads (Prefetch it to begin
+//	sooner) and uploaded with every other texture loaded before the loader next Submits; IsLoaded polls
+//	that, WaitUntilLoaded waits.  (Blank and wantMutable textures load as before, immediately, though
+//	their mipmaps too are generated by the loader's MipmapGenerator, so by compute if not blittable.)
+//	A KTX2 or DDS file (see TextureContainer) loads only this way, with the mip levels it has, none
+//	generated.
+//
+// A texture of a renderable customized BINDLESS (wantBindless) also registers, if the device has
+//	BindlessDescriptors enabled, into a slot there that its shaders index it by (see getBindlessIndex).
+//
 // For the Sampler, which dictates the appearance of this image, there are two options:
 //	- Let this class create one automatically based on the TextureSpec parameters, or,
 //	- Pass-in a pre-existing Sampler (thus ignoring those related TextureSpec values).
@@ -23,6 +33,7 @@
 #include "ImageResource.h"
 #include "CommandBufferBase.h"
 #include "Mipmaps.h"
+#include "TextureLoader.h"
 
 
 enum FilterMode {
@@ -56,7 +67,8 @@ class TextureImage : public ImageResource, CommandBufferBase
 {
 public:
 	TextureImage(TextureSpec& texSpec, VkCommandPool& pool, GraphicsDevice& graphicsDevice,
-				 iPlatform& platform, VkSampler sampler = VK_NULL_HANDLE);
+				 iPlatform& platform, VkSampler sampler = VK_NULL_HANDLE, TextureLoader* pLoader = nullptr,
+				 bool wantBindless = false);
 	~TextureImage();
 
 		// MEMBERS
@@ -67,17 +79,28 @@ protected:
 
 	bool		wasSamplerInjected = false;
 
+	BindlessDescriptors&	bindless;
+	uint32_t	bindlessIndex = BindlessDescriptors::NO_SLOT;
+
+	TextureLoader::Handle	upload;		// (if loaded by a TextureLoader)
+	MipmapGenerator*		pMipmapGenerator = nullptr;		// (the TextureLoader's, if given one)
+
 		// METHODS
 protected:
 	void create(TextureSpec& texSpec, GraphicsDevice& graphicsDevice, iPlatform& platform);
+	void createLoaded(TextureSpec& texSpec, TextureLoader& loader);
 	void createBlank(ImageInfo& parameters, GraphicsDevice& graphicsDevice, iPlatform& platform, bool mipmap = true);
 	void destroy();
 	void createSampler(TextureSpec& texSpec);
+	bool planMipmaps(VkFormat format, VkImageUsageFlags& usage);
+	void generateMipmaps(VkFormat format, int32_t wide, int32_t high);
 	void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout,
 							   VkImageLayout newLayout);
 	void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
 public:
 	void ReGenerateMipmaps();
+	bool IsLoaded()			{ return upload.IsDone(); }	// (always, unless by a TextureLoader)
+	void WaitUntilLoaded()	{ upload.Wait(); }
 
 		// getters
 	VkDescriptorImageInfo getDescriptorImageInfo() {
@@ -88,6 +111,7 @@ public:
 		};
 	}
 	StrPtr	getName()	{ return specified.fileName; }
+	uint32_t getBindlessIndex()	{ return bindlessIndex; }	// (NO_SLOT if not registered)
 
 
 	class StagingBuffer
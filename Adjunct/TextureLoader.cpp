@@ -0,0 +1,614 @@
+//
+// TextureLoader.cpp
+//	Vulkan Add-ons
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "TextureLoader.h"
+#include "TextureContainer.h"
+#include "FileSystem.h"
+#include <cstring>
+#include <numeric>
+
+
+// Copy of mip level iLevel (wide x high) from `offset` in a staging buffer.
+//
+static VkBufferImageCopy levelRegion(VkDeviceSize offset, uint32_t iLevel, int32_t wide, int32_t high)
+{
+	return {
+		.bufferOffset		= offset,
+		.bufferRowLength	= 0,		// (tightly packed)
+		.bufferImageHeight	= 0,
+		.imageSubresource = {
+			.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+			.mipLevel		= iLevel,
+			.baseArrayLayer	= 0,
+			.layerCount		= 1
+		},
+		.imageOffset = { 0, 0, 0 },
+		.imageExtent = { (uint32_t) wide, (uint32_t) high, 1 }
+	};
+}
+
+// Where a copy of texels this size (or blocks, if compressed) may begin in a staging buffer: at a
+//	multiple of both that size and 4.  (If the size isn't known, of them all.)
+//
+static VkDeviceSize stagingAlignment(VkDeviceSize texelBytes)
+{
+	return texelBytes ? std::lcm(texelBytes, (VkDeviceSize) 4) : TextureLoader::ANY_TEXEL_ALIGNMENT;
+}
+
+
+TextureLoader::TextureLoader(GraphicsDevice& graphics, iPlatform& platformAbstraction)
+	:	BufferBase(graphics),
+		graphicsDevice(graphics),
+		platform(platformAbstraction),
+		queue(graphics.Queues.getCurrent()),
+		mipmapGenerator(graphics)
+{
+	createCommandPool();
+
+	unsigned nCores	  = std::thread::hardware_concurrency();
+	unsigned nThreads = nCores > 2 ? nCores - 1 : 1;			// (leave one for the main thread)
+	if (iImageSource* pTrial = platform.NewImageSource()) {
+		delete pTrial;
+		for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+			workers.emplace_back(&TextureLoader::work, this);
+	}
+	Log(NOTE, "TextureLoader: %d decoding threads", (int) workers.size());
+}
+
+TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		isStopping = true;
+	}
+	jobQueued.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+	workers.clear();
+
+	destroy();
+}
+
+// Waits for decoding under way (its staging memory is about to go), then for the GPU to finish with
+//	what was submitted.  Prefetched images not yet taken are dropped.
+//
+void TextureLoader::destroy()
+{
+	{
+		std::unique_lock<std::mutex> lock(jobMutex);
+		queued.clear();
+		jobDone.wait(lock, [this] { return nDecoding == 0; });
+		jobs.clear();
+	}
+
+	if (! uploads.empty())
+		Log(WARN, "TextureLoader: %d uploads discarded unsubmitted.", (int) uploads.size());
+	uploads.clear();
+	if (pCurrent)
+		pCurrent->isComplete = true;	// (discarded: nothing for its Handles to wait for)
+	pCurrent.reset();
+	for (std::shared_ptr<Batch>& pBatch : inFlight) {
+		vkWaitForFences(device, 1, &pBatch->fence, VK_TRUE, UINT64_MAX);
+		complete(*pBatch);
+	}
+	inFlight.clear();
+
+	mipmapGenerator.destroy();
+
+	for (Chunk& chunk : chunks) {
+		vkUnmapMemory(device, chunk.memory);
+		vkDestroyBuffer(device, chunk.buffer, nullALLOC);
+		vkFreeMemory(device, chunk.memory, nullALLOC);
+	}
+	chunks.clear();
+	iCurrentChunk = 0;
+
+	if (commandPool != VK_NULL_HANDLE)
+		vkDestroyCommandPool(device, commandPool, nullALLOC);
+	commandPool = VK_NULL_HANDLE;
+}
+
+void TextureLoader::Recreate()
+{
+	destroy();
+	createCommandPool();
+	mipmapGenerator.Recreate();
+}
+
+void TextureLoader::createCommandPool()
+{
+	VkCommandPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+		.queueFamilyIndex  = graphicsDevice.Queues.getFamilyIndex()
+	};
+
+	call = vkCreateCommandPool(device, &poolInfo, nullALLOC, &commandPool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Texture Loader Command Pool FAILURE" + ErrStr(call));
+}
+
+
+#pragma mark - Decoding
+
+void TextureLoader::Prefetch(StrPtr fileName, bool flipVertical)
+{
+	if (! workers.empty())
+		obtainJob(FileSystem::TextureFileFullPath(fileName), flipVertical, true);
+}
+
+TextureLoader::Staged TextureLoader::Take(StrPtr fileName, bool flipVertical)
+{
+	string path = FileSystem::TextureFileFullPath(fileName);
+	std::shared_ptr<Job> pJob = obtainJob(path, flipVertical, ! workers.empty());
+
+	if (workers.empty())
+		decode(*pJob, platform.ImageSource());
+	else {
+		std::unique_lock<std::mutex> lock(jobMutex);
+		jobDone.wait(lock, [&pJob] { return pJob->isDone; });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		auto found = jobs.find(path + (flipVertical ? "|flip" : ""));
+		if (found != jobs.end() && found->second == pJob)
+			jobs.erase(found);
+	}
+	if (pJob->error)
+		std::rethrow_exception(pJob->error);
+	return pJob->staged;
+}
+
+// The one already prefetched, else a new one (queued for a worker, if `enqueue`).
+//
+std::shared_ptr<TextureLoader::Job> TextureLoader::obtainJob(const string& path, bool flipVertical, bool enqueue)
+{
+	string key = path + (flipVertical ? "|flip" : "");
+
+	std::lock_guard<std::mutex> lock(jobMutex);
+
+	auto found = jobs.find(key);
+	if (found != jobs.end())
+		return found->second;
+
+	std::shared_ptr<Job> pJob = std::make_shared<Job>();
+	pJob->path		   = path;
+	pJob->flipVertical = flipVertical;
+	jobs[key] = pJob;
+	if (enqueue) {
+		queued.push_back(pJob);
+		jobQueued.notify_one();
+	}
+	return pJob;
+}
+
+// Each worker decodes with its own image source, as those hold their last image.  A decode that fails
+//	(Fatal) is kept on its Job: thrown from here it would terminate, so Take rethrows it instead.
+//
+void TextureLoader::work()
+{
+	std::unique_ptr<iImageSource> pImageSource(platform.NewImageSource());
+
+	for (;;) {
+		std::shared_ptr<Job> pJob;
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobQueued.wait(lock, [this] { return isStopping || ! queued.empty(); });
+			if (isStopping)
+				return;
+			pJob = queued.front();
+			queued.pop_front();
+			++nDecoding;
+		}
+
+		try {
+			decode(*pJob, *pImageSource);
+		} catch (...) {
+			pJob->error = std::current_exception();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			pJob->isDone = true;
+			--nDecoding;
+		}
+		jobDone.notify_all();
+	}
+}
+
+// As TextureImage::create and StagingBuffer::CopyInImageData do, but into pooled staging memory.
+//
+void TextureLoader::decode(Job& job, iImageSource& imageSource)
+{
+	if (TextureContainer::IsContainerFile(job.path.c_str())) {
+		decodeContainer(job);
+		return;
+	}
+
+	ImageInfo info = imageSource.Load(job.path.c_str());
+
+	if (! graphicsDevice.IsImageFormatSupported(info.format, VK_IMAGE_TILING_OPTIMAL)) {
+		VkFormat BEST_FORMAT = VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+		Log(WARN, "Vulkan says selected device does not support: %s", AltVkFormatString(info.format));
+		Log(WARN, "    Converting to: %s", AltVkFormatString(BEST_FORMAT));
+		info = imageSource.ConvertTo(BEST_FORMAT);
+	}
+
+	VkDeviceSize nTexels	= (VkDeviceSize) info.wide * info.high;
+	VkDeviceSize texelBytes = nTexels && info.numBytes % nTexels == 0 ? info.numBytes / nTexels : 0;
+	Staged staged = reserve(info.numBytes, stagingAlignment(texelBytes));
+	char* pSource	   = (char*) info.pPixels;
+	char* pDestination = (char*) staged.info.pPixels;
+
+	if (! job.flipVertical)
+		memcpy(pDestination, pSource, static_cast<size_t>(info.numBytes));
+	else {
+		size_t bytesPerRow = info.numBytes / info.high;
+		pDestination += info.numBytes;
+		for (int iRow = info.high; iRow > 0; --iRow) {
+			pDestination -= bytesPerRow;
+			memcpy(pDestination, pSource, bytesPerRow);
+			pSource += bytesPerRow;
+		}
+	}
+
+	info.pPixels = staged.info.pPixels;
+	staged.info	 = info;
+	staged.regions.push_back(levelRegion(staged.offset, 0, info.wide, info.high));
+	job.staged	 = staged;
+}
+
+// All the container's mip levels, as they are (each aligned as its blocks require), unless the device
+//	can't sample its format, then transcoded.  (Not flipped: flipVertical doesn't apply.)
+//
+void TextureLoader::decodeContainer(Job& job)
+{
+	TextureContainer container(job.path);
+	const vector<TextureContainer::Level>& levels = container.getLevels();
+
+	VkFormat format	   = container.getFormat();
+	bool	 transcode = ! graphicsDevice.IsImageFormatSupported(format, VK_IMAGE_TILING_OPTIMAL);
+	if (transcode) {
+		if (! TextureContainer::CanTranscode(format))
+			Fatal("Vulkan says selected device does not support: " + string(AltVkFormatString(format))
+				  + ", nor can it be transcoded, for texture: " + job.path);
+		Log(WARN, "Vulkan says selected device does not support: %s", AltVkFormatString(format));
+		Log(WARN, "    Transcoding to: %s", AltVkFormatString(TextureContainer::TranscodedFormat(format)));
+	}
+
+	VkDeviceSize alignment = stagingAlignment(transcode ? 4 : TextureContainer::TexelBlockBytes(format));
+	auto alignedSize = [transcode, alignment](const TextureContainer::Level& level) {
+		VkDeviceSize nBytes = transcode ? TextureContainer::TranscodedSize(level) : level.nBytes;
+		return (nBytes + alignment - 1) / alignment * alignment;
+	};
+	VkDeviceSize numBytes = 0;
+	for (const TextureContainer::Level& level : levels)
+		numBytes += alignedSize(level);
+
+	Staged staged = reserve(numBytes, alignment);
+	char* pStaged = (char*) staged.info.pPixels;
+
+	VkDeviceSize offset = 0;
+	for (uint32_t iLevel = 0; iLevel < (uint32_t) levels.size(); ++iLevel) {
+		const TextureContainer::Level& level = levels[iLevel];
+		if (transcode)
+			TextureContainer::Transcode(format, level, (uint8_t*) pStaged + offset);
+		else
+			memcpy(pStaged + offset, level.pBytes, level.nBytes);
+		staged.regions.push_back(levelRegion(staged.offset + offset, iLevel, level.wide, level.high));
+		offset += alignedSize(level);
+	}
+
+	staged.info = {
+		.pPixels  = pStaged,
+		.numBytes = numBytes,
+		.format	  = transcode ? TextureContainer::TranscodedFormat(format) : format,
+		.wide	  = levels[0].wide,
+		.high	  = levels[0].high
+	};
+	job.staged = staged;
+}
+
+
+#pragma mark - Staging
+
+// Suballocate from the current chunk, else one idle (all its images uploaded), else a new one.
+//	Its offset is a multiple of `alignment` (see stagingAlignment).  (Called from worker threads.)
+//
+TextureLoader::Staged TextureLoader::reserve(VkDeviceSize nBytes, VkDeviceSize alignment)
+{
+	auto alignedUp = [alignment](VkDeviceSize offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+	std::lock_guard<std::mutex> lock(stagingMutex);
+
+	if (chunks.empty() || alignedUp(chunks[iCurrentChunk].used) + nBytes > chunks[iCurrentChunk].size) {
+		uint32_t iChunk = 0;
+		while (iChunk < chunks.size() && (chunks[iChunk].nLive > 0 || chunks[iChunk].size < nBytes))
+			++iChunk;
+		if (iChunk == chunks.size())
+			chunks.push_back(createChunk(std::max(nBytes, STAGING_CHUNK_SIZE)));
+		iCurrentChunk = iChunk;
+	}
+
+	Chunk& chunk = chunks[iCurrentChunk];
+	Staged staged = {
+		.iChunk	= iCurrentChunk,
+		.offset	= alignedUp(chunk.used)		// (idle chunks, used 0, are aligned to anything)
+	};
+	staged.info.pPixels = chunk.pMapped + staged.offset;
+	chunk.used = staged.offset + nBytes;
+	++chunk.nLive;
+	return staged;
+}
+
+void TextureLoader::release(uint32_t iChunk)
+{
+	std::lock_guard<std::mutex> lock(stagingMutex);
+
+	if (iChunk < chunks.size() && --chunks[iChunk].nLive == 0)
+		chunks[iChunk].used = 0;
+}
+
+// As BufferBase::createGeneralBuffer, but safe off the main thread (not setting the shared `call`).
+//
+TextureLoader::Chunk TextureLoader::createChunk(VkDeviceSize size)
+{
+	Chunk chunk = { .size = size, .used = 0, .nLive = 0 };
+
+	VkBufferCreateInfo bufferInfo = {
+		.sType	= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.size		 = size,
+		.usage		 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+		.queueFamilyIndexCount	= 0,
+		.pQueueFamilyIndices	= nullptr
+	};
+
+	VkResult result = vkCreateBuffer(device, &bufferInfo, nullALLOC, &chunk.buffer);
+	if (result != VK_SUCCESS)
+		Fatal("Create Texture Staging Buffer FAILURE" + ErrStr(result));
+
+	VkMemoryRequirements memReqs;
+	vkGetBufferMemoryRequirements(device, chunk.buffer, &memReqs);
+
+	VkMemoryAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.allocationSize	 = memReqs.size,
+		.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+																| VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+	};
+
+	result = vkAllocateMemory(device, &allocInfo, nullALLOC, &chunk.memory);
+	if (result != VK_SUCCESS)
+		Fatal("Allocate Texture Staging Memory FAILURE" + ErrStr(result));
+
+	vkBindBufferMemory(device, chunk.buffer, chunk.memory, 0);
+
+	result = vkMapMemory(device, chunk.memory, 0, size, 0, (void**) &chunk.pMapped);
+	if (result != VK_SUCCESS)
+		Fatal("Texture Staging Map Memory FAILURE" + ErrStr(result));
+
+	Log(LOW, "TextureLoader: staging chunk of %d MB", (int) (size / (1024 * 1024)));
+	return chunk;
+}
+
+
+#pragma mark - Uploading
+
+TextureLoader::Handle TextureLoader::Upload(VkImage image, const Staged& staged, uint32_t numLevels,
+											bool generateMipmaps)
+{
+	if (! pCurrent)
+		pCurrent = std::make_shared<Batch>();
+
+	VkBuffer buffer;
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex);
+		buffer = chunks[staged.iChunk].buffer;
+	}
+	uploads.push_back({
+		.image		= image,
+		.format		= staged.info.format,
+		.wide		= staged.info.wide,
+		.high		= staged.info.high,
+		.numLevels	= numLevels,
+		.buffer		= buffer,
+		.regions	= staged.regions,
+		.generateMipmaps = generateMipmaps
+	});
+	pCurrent->iChunks.push_back(staged.iChunk);
+
+	Handle handle;
+	handle.pLoader = this;
+	handle.pBatch  = pCurrent;
+	return handle;
+}
+
+// Record and submit all uploads since last time, in one command buffer.  (Also reclaims those done.)
+//
+void TextureLoader::Submit()
+{
+	reclaim();
+	if (uploads.empty())
+		return;
+
+	Batch& batch = *pCurrent;
+
+	VkCommandBufferAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.commandPool		= commandPool,
+		.level				= VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+		.commandBufferCount	= 1
+	};
+	call = vkAllocateCommandBuffers(device, &allocInfo, &batch.commandBuffer);
+	if (call != VK_SUCCESS)
+		Fatal("Allocate Texture Upload Command Buffer FAILURE" + ErrStr(call));
+
+	VkCommandBufferBeginInfo beginInfo = {
+		.sType	= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.pNext	= nullptr,
+		.flags	= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+		.pInheritanceInfo = nullptr
+	};
+	vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+
+	record(batch);
+
+	vkEndCommandBuffer(batch.commandBuffer);
+
+	VkFenceCreateInfo fenceInfo = {
+		.sType	= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0
+	};
+	call = vkCreateFence(device, &fenceInfo, nullALLOC, &batch.fence);
+	if (call != VK_SUCCESS)
+		Fatal("Create Texture Upload Fence FAILURE" + ErrStr(call));
+
+	VkSubmitInfo submitInfo = {
+		.sType	= VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.pNext	= nullptr,
+		.waitSemaphoreCount	= 0,
+		.pWaitSemaphores	= nullptr,
+		.pWaitDstStageMask	= nullptr,
+		.commandBufferCount		= 1,
+		.pCommandBuffers		= &batch.commandBuffer,
+		.signalSemaphoreCount = 0,
+		.pSignalSemaphores	  = nullptr
+	};
+	call = vkQueueSubmit(queue, 1, &submitInfo, batch.fence);
+	if (call != VK_SUCCESS)
+		Fatal("Texture Upload Queue Submit FAILURE" + ErrStr(call));
+
+	Log(LOW, "TextureLoader: submitted %d uploads", (int) uploads.size());
+
+	batch.isSubmitted = true;
+	inFlight.push_back(pCurrent);
+	pCurrent.reset();
+	uploads.clear();
+}
+
+// Every image's transition to TRANSFER_DST in one barrier, all the copies (of each level staged), then
+//	every image not mipmapped made shader-readable in one more barrier, and those mipmapped all generated
+//	together by MipmapGenerator.
+//
+void TextureLoader::record(Batch& batch)
+{
+	VkCommandBuffer commandBuffer = batch.commandBuffer;
+
+	vector<VkImageMemoryBarrier> barriers;
+	barriers.reserve(uploads.size());
+
+	auto barrierFor = [](Upload& upload, VkImageLayout oldLayout, VkImageLayout newLayout,
+						 VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask) {
+		return VkImageMemoryBarrier {
+			.sType	= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.pNext	= nullptr,
+			.srcAccessMask	= srcAccessMask,
+			.dstAccessMask	= dstAccessMask,
+			.oldLayout	= oldLayout,
+			.newLayout	= newLayout,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image	= upload.image,
+			.subresourceRange = {
+				.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel	= 0,
+				.levelCount		= upload.numLevels,
+				.baseArrayLayer	= 0,
+				.layerCount		= 1
+			}
+		};
+	};
+
+	for (Upload& upload : uploads)
+		barriers.push_back(barrierFor(upload, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+									  0, VK_ACCESS_TRANSFER_WRITE_BIT));
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+						 0, nullptr, 0, nullptr, (uint32_t) barriers.size(), barriers.data());
+
+	for (Upload& upload : uploads)
+		vkCmdCopyBufferToImage(commandBuffer, upload.buffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+							   (uint32_t) upload.regions.size(), upload.regions.data());
+
+	barriers.clear();
+	vector<MipmapGenerator::Target> targets;
+	for (Upload& upload : uploads)
+		if (upload.generateMipmaps)
+			targets.push_back({ upload.image, upload.format, upload.wide, upload.high, upload.numLevels });
+		else
+			barriers.push_back(barrierFor(upload, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+										  VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT));
+
+	if (! barriers.empty())
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+							 0, nullptr, 0, nullptr, (uint32_t) barriers.size(), barriers.data());
+
+	if (! targets.empty())
+		mipmapGenerator.Record(commandBuffer, targets, batch.scratch);
+}
+
+void TextureLoader::reclaim()
+{
+	std::erase_if(inFlight, [this](std::shared_ptr<Batch>& pBatch) {
+		if (vkGetFenceStatus(device, pBatch->fence) != VK_SUCCESS)
+			return false;
+		complete(*pBatch);
+		return true;
+	});
+}
+
+void TextureLoader::complete(Batch& batch)
+{
+	for (uint32_t iChunk : batch.iChunks)
+		release(iChunk);
+	batch.iChunks.clear();
+	mipmapGenerator.Release(batch.scratch);
+
+	vkFreeCommandBuffers(device, commandPool, 1, &batch.commandBuffer);
+	vkDestroyFence(device, batch.fence, nullALLOC);
+	batch.commandBuffer = VK_NULL_HANDLE;
+	batch.fence			= VK_NULL_HANDLE;
+	batch.isComplete	= true;
+}
+
+
+#pragma mark - Handle
+
+bool TextureLoader::Handle::IsDone()
+{
+	if (! pBatch || pBatch->isComplete)
+		return true;
+	if (! pBatch->isSubmitted)
+		return false;
+
+	pLoader->reclaim();
+	return pBatch->isComplete;
+}
+
+void TextureLoader::Handle::Wait()
+{
+	if (! pBatch || pBatch->isComplete)
+		return;
+	if (! pBatch->isSubmitted)
+		pLoader->Submit();
+	if (pBatch->fence == VK_NULL_HANDLE)	// (never submitted after all, e.g. loader discarded its uploads)
+		return;
+
+	vkWaitForFences(pLoader->device, 1, &pBatch->fence, VK_TRUE, UINT64_MAX);
+	pLoader->reclaim();
+}
@@ -0,0 +1,160 @@
+//
+// TextureLoader.h
+//	Vulkan Add-ons
+//
+// Load many textures at once, rather than one after another: image files decode on a pool of worker
+//	threads (each with its own iImageSource, see iPlatform::NewImageSource) straight into pooled,
+//	persistently mapped staging memory, and the GPU side of every texture uploaded since the last Submit
+//	(layout transitions, buffer-to-image copies, mipmap generation) is recorded into one command buffer,
+//	submitted once, with one fence; the mipmaps of all its textures generate together (see
+//	MipmapGenerator).  Versus TextureImage loading on its own: decoding on the calling thread, into a
+//	staging buffer of its own, then three single-submit command buffers, each waited idle.
+//
+// Prefetch starts decoding a texture at once (e.g. every one a renderable, or a scene, will need);
+//	TextureImage then Takes it (waiting only if not yet decoded) and queues its Upload, whose Handle it
+//	may poll (IsDone) or Wait on.  CommandControl Submits before command buffers record, on the same
+//	queue ahead of any draw sampling them, so that drawing needn't wait.  Prefetch only what will be
+//	Taken, as its staging memory is held until then.
+//
+// A KTX2 or DDS file (see TextureContainer) is instead copied as is, all its pre-baked mip levels,
+//	already in the format to be sampled (typically block-compressed) unless the device lacks it, when
+//	transcoded if it can be.
+//
+// Owned by VulkanSetup.  Not for mutable textures (TextureSpec.wantMutable), which keep their own
+//	staging buffer.  Decoded on the calling thread instead, if the platform offers no NewImageSource.
+//	Use from the main thread.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef TextureLoader_h
+#define TextureLoader_h
+
+#include "BufferBase.h"
+#include "MipmapGenerator.h"
+#include "iPlatform.h"
+#include <unordered_map>
+#include <deque>
+#include <memory>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+
+class TextureLoader : BufferBase
+{
+public:
+	TextureLoader(GraphicsDevice& graphics, iPlatform& platform);
+	~TextureLoader();
+
+	static constexpr VkDeviceSize	STAGING_CHUNK_SIZE	= 32 * 1024 * 1024;	// (larger images get their own)
+	static constexpr VkDeviceSize	ANY_TEXEL_ALIGNMENT	= 96;	// (lcm of every texel/block size: 1-4, 6, 8, 12, 16, 24, 32)
+
+	struct Staged {						// A decoded image, in staging memory:
+		ImageInfo		info;			//	(pPixels: its staged bytes)
+		uint32_t		iChunk;
+		VkDeviceSize	offset;
+		vector<VkBufferImageCopy> regions;	// one per mip level staged (more than one if pre-baked)
+	};
+
+private:
+	struct Batch {						// Uploads recorded and submitted together.
+		VkCommandBuffer		commandBuffer = VK_NULL_HANDLE;
+		VkFence				fence		  = VK_NULL_HANDLE;
+		bool				isSubmitted	  = false;
+		bool				isComplete	  = false;
+		vector<uint32_t>	iChunks;	// (one per staged image, released on completion)
+		MipmapGenerator::Scratch scratch;	// (also released on completion)
+	};
+
+public:
+	class Handle {						// An Upload's completion.
+		friend class TextureLoader;
+		TextureLoader*			pLoader = nullptr;
+		std::shared_ptr<Batch>	pBatch;
+	public:
+		bool	IsDone();				// Poll, without blocking.  (True if never uploaded.)
+		void	Wait();					// Submitting first, if not yet.
+	};
+
+		// MEMBERS
+private:
+	GraphicsDevice&	graphicsDevice;
+	iPlatform&		platform;
+	VkQueue&		queue;
+	VkCommandPool	commandPool = VK_NULL_HANDLE;
+
+	struct Job {
+		string		path;
+		bool		flipVertical;
+		Staged		staged;
+		bool		isDone = false;
+		std::exception_ptr	error;	// (a worker's Fatal, for Take to rethrow)
+	};
+	std::unordered_map<string, std::shared_ptr<Job>>	jobs;		// by path (and flip)
+	std::deque<std::shared_ptr<Job>>	queued;
+	uint32_t					nDecoding = 0;
+	bool						isStopping = false;
+	std::mutex					jobMutex;
+	std::condition_variable		jobQueued, jobDone;
+	vector<std::thread>			workers;
+
+	struct Chunk {
+		VkBuffer		buffer;
+		VkDeviceMemory	memory;
+		char*			pMapped;		// (persistently)
+		VkDeviceSize	size, used;
+		uint32_t		nLive;			// staged images not yet uploaded (when 0, reusable)
+	};
+	vector<Chunk>	chunks;
+	uint32_t		iCurrentChunk = 0;
+	std::mutex		stagingMutex;
+
+	struct Upload {
+		VkImage			image;
+		VkFormat		format;
+		int32_t			wide, high;
+		uint32_t		numLevels;
+		VkBuffer		buffer;
+		vector<VkBufferImageCopy> regions;
+		bool			generateMipmaps;
+	};
+	vector<Upload>					uploads;	// into:
+	std::shared_ptr<Batch>			pCurrent;
+	vector<std::shared_ptr<Batch>>	inFlight;
+
+	MipmapGenerator		mipmapGenerator;
+
+		// METHODS
+public:
+	void	Prefetch(StrPtr fileName, bool flipVertical = false);
+	Staged	Take(StrPtr fileName, bool flipVertical = false);		// Once decoded (waiting if need be), else rethrows.
+
+	// Copy `staged` into `image` (of numLevels, its first staged.regions.size() being staged), then
+	//	generate its mipmaps (if generateMipmaps, see MipmapGenerator::MethodFor) or make it shader-readable,
+	//	at the next Submit.  The image must outlive that: Wait on the Handle before destroying it.
+	Handle	Upload(VkImage image, const Staged& staged, uint32_t numLevels, bool generateMipmaps);
+	void	Submit();
+
+	void	destroy();			// Public for device-loss teardown (old device); idempotent.
+	void	Recreate();
+private:
+	void	createCommandPool();
+	void	work();
+	void	decode(Job& job, iImageSource& imageSource);
+	void	decodeContainer(Job& job);
+	std::shared_ptr<Job>	obtainJob(const string& path, bool flipVertical, bool enqueue);
+	Staged	reserve(VkDeviceSize nBytes, VkDeviceSize alignment);
+	void	release(uint32_t iChunk);
+	Chunk	createChunk(VkDeviceSize size);
+	void	record(Batch& batch);
+	void	reclaim();
+	void	complete(Batch& batch);
+
+		// getters
+public:
+	MipmapGenerator&	getMipmapGenerator()	{ return mipmapGenerator; }		// (e.g. to SetComputeDownsampler)
+};
+
+#endif	// TextureLoader_h
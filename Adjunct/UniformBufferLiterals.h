@@ -79,6 +79,18 @@ struct UBO_Shadow {
 	alignas(16)		mat4 lightSpaceMatrix;	// Combined light view * projection matrix
 };
 
+// This UBO gathers all of the above that is the same for every renderable in a frame, for the one
+//	shared FrameConstants buffer (see FrameConstants.h), rather than each renderable's own copies.
+//	Matches, in std140:
+//		struct Light { vec4 position; vec4 color; float ambientStrength; };
+//		layout(set = 0, binding = 0) uniform Frame { mat4 view; mat4 proj; Light light; mat4 lightSpaceMatrix; } frame;
+//
+struct UBO_Frame {
+	alignas(16)		UBO_VP		camera;
+	alignas(16)		UBO_Light	light;
+	alignas(16)		UBO_Shadow	shadow;
+};
+
 //----------------------------------------------------------------------------
 
 // Forward declaration
@@ -91,14 +103,20 @@ struct UBO {
 	DestinationStage	destinationStage;
 	bool				isDynamic;					// for Dynamic Uniform Buffers
 	DynamicUniformBuffer* pDynamicUBO;				// Pointer to Dynamic UBO
+	const mat4*			pModel = nullptr;			// Model matrix within pBytes, if any (for batching/instancing)
+	const mat4*			pView  = nullptr;			// View matrix within pBytes, if any (for depth sorting)
+	const mat4*			pProj  = nullptr;			// Projection matrix within pBytes, if any (for occlusion culling)
 
 	UBO(UBO_MVP& mvp, DestinationStage dstage = DESTINATION_VERTEX_STAGE)
-		:	byteSize(sizeof(UBO_MVP)), pBytes(&mvp), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr)	{ }
+		:	byteSize(sizeof(UBO_MVP)), pBytes(&mvp), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr),
+			pModel(&mvp.model), pView(&mvp.view), pProj(&mvp.proj)	{ }
 
 	UBO(mat4& model, DestinationStage dstage = DESTINATION_VERTEX_STAGE)
-		:	byteSize(sizeof(mat4)), pBytes(&model), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr)	{ }
+		:	byteSize(sizeof(mat4)), pBytes(&model), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr),
+			pModel(&model)	{ }
 	UBO(UBO_VP& vp, DestinationStage dstage = DESTINATION_VERTEX_STAGE)
-		:	byteSize(sizeof(UBO_VP)), pBytes(&vp), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr)		{ }
+		:	byteSize(sizeof(UBO_VP)), pBytes(&vp), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr),
+			pView(&vp.view), pProj(&vp.proj)	{ }
 
 	UBO(UBO_rtm& rtm, DestinationStage dstage = DESTINATION_FRAGMENT_STAGE)
 		:	byteSize(sizeof(UBO_rtm)), pBytes(&rtm), destinationStage(dstage), isDynamic(false), pDynamicUBO(nullptr)	{ }
@@ -0,0 +1,62 @@
+//
+// InstanceTypes.h
+//	Vulkan Vertex-based Add-ons
+//
+// Encapsulate per-Instance data, which streams alongside a Vertex (see
+//	InstancedVertexDescription) at one element per drawn instance:
+//		transform	 color
+//		---------	 -----
+//	 #1		mat4		N		// placed only
+//	 #2		mat4		Y		// placed and tinted
+//	 #3		rows		Y		// as #2, affine transform packed as 3 rows
+//
+// Same conventions as Vertex3DTypes.h: a layout[] of enums declares the members, in order.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef InstanceTypes_h
+#define InstanceTypes_h
+
+#include "VulkanMath.h"			// for vecN, mat4
+#include "VertexAttribute.h"
+
+
+struct InstanceTransform 				// #1
+{
+	mat4 model;
+			   // ↖ these must match, obviously ↘
+	static constexpr InstanceAttribute layout[] = { INSTANCE_TRANSFORM };
+};
+
+struct InstanceTransformColor			// #2
+{
+	mat4 model;
+	vec4 color;
+
+	static constexpr InstanceAttribute layout[] = {
+		INSTANCE_TRANSFORM,
+		INSTANCE_COLOR
+	};
+};
+
+struct InstanceRowsColor				// #3
+{
+	vec4 rows[3];		// == transpose(model) minus its last row (0, 0, 0, 1);
+	vec4 color;			//	shader rebuilds: worldPos = vec3(dot(rows[0], p), dot(rows[1], p), dot(rows[2], p))
+
+	static constexpr InstanceAttribute layout[] = {
+		INSTANCE_TRANSFORM_ROWS,
+		INSTANCE_COLOR
+	};
+
+	void setTransform(const mat4& model) {
+		mat4 transposed = glm::transpose(model);
+		rows[0] = transposed[0];
+		rows[1] = transposed[1];
+		rows[2] = transposed[2];
+	}
+};
+
+
+#endif	// InstanceTypes_h
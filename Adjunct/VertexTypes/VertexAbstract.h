@@ -16,10 +16,12 @@
 #include "VertexAttribute.h"
 
 
+
 struct VertexAbstract
 {
 public:
 	virtual size_t	 byteSize() = 0;
+	virtual size_t	 instanceByteSize()	{ return 0; }	// (per-instance stride, if INSTANCE_BINDING is described)
 
 	virtual uint32_t nBindingDescriptions()	  = 0;
 	virtual uint32_t nAttributeDescriptions() = 0;
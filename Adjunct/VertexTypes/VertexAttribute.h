@@ -70,4 +70,62 @@ inline int numBytesGivenAttributes(AttributeBits attribits) {
 }*/
 
 
+
+// Per-vertex attributes stream from binding 0.  Optionally, per-instance attributes stream
+//	from binding 1 (VK_VERTEX_INPUT_RATE_INSTANCE), their shader locations following those of
+//	the vertex.  Matrices take one location per vec4, so the whole set is uniformly vec4s.
+//
+const uint32_t VERTEX_BINDING	= 0;
+const uint32_t INSTANCE_BINDING	= 1;
+
+enum InstanceAttribute {
+	INSTANCE_TRANSFORM		= 0,	// mat4 model matrix, as 4 columns
+	INSTANCE_TRANSFORM_ROWS	= 1,	// affine model matrix, transposed into 3 rows (saves a vec4)
+	INSTANCE_COLOR			= 2,
+	INSTANCE_PARAMS			= 3		// app-defined vec4
+};	// ↑ ≡ ↓
+constexpr int InstanceAttributeLocations[] {
+	4,								// INSTANCE_TRANSFORM
+	3,								// INSTANCE_TRANSFORM_ROWS
+	1,								// INSTANCE_COLOR
+	1								// INSTANCE_PARAMS
+};
+const VkFormat InstanceAttributeFormat = VK_FORMAT_R32G32B32A32_SFLOAT;		// (each location)
+
+
+inline int numLocationsGivenInstanceAttributes(const InstanceAttribute* layout, int nAttrs) {
+	int nLocations = 0;
+	for (int iAttr = 0; iAttr < nAttrs; ++iAttr)
+		nLocations += InstanceAttributeLocations[layout[iAttr]];
+	return nLocations;
+}
+
+// Fill one VkVertexInputAttributeDescription per location (see above), starting at firstLocation.
+//	Returns byte size of the whole per-instance structure, i.e. binding's stride.
+//
+inline uint32_t describeInstanceAttributes(const InstanceAttribute* layout, int nAttrs, uint32_t firstLocation,
+										   VkVertexInputAttributeDescription* pDescriptions) {
+	uint32_t location = firstLocation, byteCount = 0;
+	for (int iAttr = 0; iAttr < nAttrs; ++iAttr)
+		for (int iVec = 0; iVec < InstanceAttributeLocations[layout[iAttr]]; ++iVec) {
+			*pDescriptions++ = {
+				.location	= location++,
+				.binding	= INSTANCE_BINDING,
+				.format		= InstanceAttributeFormat,
+				.offset		= byteCount
+			};
+			byteCount += sizeof(vec4);
+		}
+	return byteCount;
+}
+
+inline VkVertexInputBindingDescription describeInstanceBinding(uint32_t numBytesPerInstance) {
+	return {
+		.binding	= INSTANCE_BINDING,
+		.stride		= numBytesPerInstance,
+		.inputRate	= VK_VERTEX_INPUT_RATE_INSTANCE
+	};
+}
+
+
 #endif	// VertexAttribute_h
@@ -15,6 +15,7 @@
 #include "vulkan/vulkan.h"	// for VkFormat (see vulkan_core.h)
 #include "Universal.h"		// for N_ELEMENTS_IN_ARRAY
 #include "VertexAbstract.h"
+#include "InstanceTypes.h"
 #include "Logging.h"
 #include <bitset>			// (to build on Linux side)
 
@@ -34,20 +35,24 @@ struct VertexDescriptionDynamic : VertexAbstract
 	AttributeBits	attribits = 0;
 	VertexAttribute*	pLayout = nullptr;
 
-	VkVertexInputBindingDescription		bindingDescription;
+	int		numInstanceLocations = 0;	// (optional per-instance attributes, see initialize() below)
+	int		numBytesPerInstance = 0;
+
+	VkVertexInputBindingDescription		bindingDescriptions[2];		// [VERTEX_BINDING], [INSTANCE_BINDING]
 	VkVertexInputAttributeDescription*	attributeDescriptions = nullptr;
 
 public:
 	size_t	 byteSize()				  override	{ return numBytesPerVertex; }
+	size_t	 instanceByteSize()		  override	{ return numBytesPerInstance; }
 
-	uint32_t nBindingDescriptions()	  override	{ return 1; }
-	uint32_t nAttributeDescriptions() override	{ return numAttributes; }
+	uint32_t nBindingDescriptions()	  override	{ return numBytesPerInstance ? 2 : 1; }
+	uint32_t nAttributeDescriptions() override	{ return numAttributes + numInstanceLocations; }
 
 	const VkVertexInputAttributeDescription* pAttributeDescriptions() override {
 		return attributeDescriptions;
 	}
 	const VkVertexInputBindingDescription* pBindingDescriptions() override {
-		return &bindingDescription;
+		return bindingDescriptions;
 	}
 
 	VertexDescriptionDynamic() { }
@@ -56,7 +61,7 @@ public:
 		pLayout = pAttrs;
 		numAttributes = nAttrs;
 		numBytesPerVertex = nBytesVertex;
-		attributeDescriptions = new VkVertexInputAttributeDescription[numAttributes];
+		allocateAttributeDescriptions();
 
 		createAttributeDescriptions(pLayout);
 		createBindingDescription();
@@ -66,15 +71,30 @@ public:
 		std::bitset<8 * sizeof(AttributeBits)> onebits(bits);
 		numAttributes = (int) onebits.count();
 		numBytesPerVertex = numBytesGivenAttributes(bits);
-		attributeDescriptions = new VkVertexInputAttributeDescription[numAttributes];
+		allocateAttributeDescriptions();
 
 		createAttributeDescriptions(bits);
 		createBindingDescription();
 	}
+	// As above, plus a second binding streaming per-instance attributes (e.g. INSTANCE_TRANSFORM).
+	void initialize(AttributeBits bits, const InstanceAttribute* pInstanceLayout, int nInstanceAttrs) {
+		numInstanceLocations = numLocationsGivenInstanceAttributes(pInstanceLayout, nInstanceAttrs);
+		initialize(bits);
+
+		numBytesPerInstance = describeInstanceAttributes(pInstanceLayout, nInstanceAttrs, numAttributes,
+														 &attributeDescriptions[numAttributes]);
+		bindingDescriptions[INSTANCE_BINDING] = describeInstanceBinding(numBytesPerInstance);
+	}
 
 	~VertexDescriptionDynamic() {
 		if (attributeDescriptions)
-			delete attributeDescriptions;
+			delete[] attributeDescriptions;
+	}
+
+	void allocateAttributeDescriptions() {		// (freeing those of any prior initialize)
+		if (attributeDescriptions)
+			delete[] attributeDescriptions;
+		attributeDescriptions = new VkVertexInputAttributeDescription[numAttributes + numInstanceLocations];
 	}
 
 
@@ -107,9 +127,9 @@ public:
 	}
 
 	void createBindingDescription() {
-		bindingDescription.binding =	0;
-		bindingDescription.stride =		numBytesPerVertex;
-		bindingDescription.inputRate =	VK_VERTEX_INPUT_RATE_VERTEX;
+		bindingDescriptions[VERTEX_BINDING].binding =	VERTEX_BINDING;
+		bindingDescriptions[VERTEX_BINDING].stride =	numBytesPerVertex;
+		bindingDescriptions[VERTEX_BINDING].inputRate =	VK_VERTEX_INPUT_RATE_VERTEX;
 	}
 
 	bool vetIsValid() override {
@@ -170,6 +190,54 @@ public:
 };
 
 
+// Create procedurally via template, for a Vertex type T (binding 0) accompanied by an
+//	Instance type I (binding 1, see InstanceTypes.h).  Instance attribute locations follow
+//	the vertex ones, e.g. for VertexDescription<Vertex3DNormal, InstanceTransformColor>:
+//		layout(location = 0) in vec3 inPosition;
+//		layout(location = 1) in vec3 inNormal;
+//		layout(location = 2) in mat4 instanceModel;		// (consumes 2, 3, 4, 5)
+//		layout(location = 6) in vec4 instanceColor;
+//
+template <typename T, typename I>
+struct InstancedVertexDescription : VertexDescription<T>
+{
+	static constexpr int nVertexAttributes = N_ELEMENTS_IN_ARRAY(T::layout);
+	static constexpr int nInstanceLocations = [] {
+		int nLocations = 0;
+		for (InstanceAttribute attribute : I::layout)
+			nLocations += InstanceAttributeLocations[attribute];
+		return nLocations;
+	}();
+
+	VkVertexInputAttributeDescription	allAttributeDescriptions[nVertexAttributes + nInstanceLocations];
+	VkVertexInputBindingDescription		bindingDescriptions[2];
+
+public:
+	size_t	 instanceByteSize()		  { return sizeof(I); }
+
+	uint32_t nBindingDescriptions()	  { return 2; }
+	uint32_t nAttributeDescriptions() { return nVertexAttributes + nInstanceLocations; }
+
+	const VkVertexInputAttributeDescription* pAttributeDescriptions() {
+		return allAttributeDescriptions;
+	}
+	const VkVertexInputBindingDescription* pBindingDescriptions() {
+		return bindingDescriptions;
+	}
+
+	InstancedVertexDescription() {
+		for (int iAttr = 0; iAttr < nVertexAttributes; ++iAttr)
+			allAttributeDescriptions[iAttr] = VertexDescription<T>::attributeDescriptions[iAttr];
+		bindingDescriptions[VERTEX_BINDING] = VertexDescription<T>::bindingDescription;
+
+		uint32_t byteCount = describeInstanceAttributes(I::layout, N_ELEMENTS_IN_ARRAY(I::layout), nVertexAttributes,
+														&allAttributeDescriptions[nVertexAttributes]);
+		ASSERT_EQUAL(byteCount, sizeof(I))
+		bindingDescriptions[INSTANCE_BINDING] = describeInstanceBinding(sizeof(I));
+	}
+};
+
+
 // ACADEMIC/INSTRUCTIONAL EXAMPLES
 
 // Here are a couple of example vertex descriptions, done "long-hand," to demonstrate
@@ -26,4 +26,21 @@ inline void clamp(uint32_t& value, const uint32_t min, const uint32_t max)
 		value = max;
 }
 
+// 64-bit FNV-1a over a block of bytes, e.g. to recognize identical data loaded more than once.
+//
+inline uint64_t hashBytes(const void* pBytes, size_t numBytes, uint64_t hash = 0xcbf29ce484222325ull)
+{
+	const uint8_t* pByte = (const uint8_t*) pBytes;
+	for (size_t iByte = 0; iByte < numBytes; ++iByte)
+		hash = (hash ^ pByte[iByte]) * 0x100000001b3ull;
+	return hash;
+}
+
+// Fold a value into a running hash; the boost::hash_combine recipe, widened to 64 bits.
+//
+inline void hashCombine(uint64_t& seed, uint64_t value)
+{
+	seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
 #endif // Helpers_h
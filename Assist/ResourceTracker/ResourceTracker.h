@@ -84,11 +84,15 @@ VkResult trkCreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo* pC
 void trkDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer,
                           const VkAllocationCallbacks* pAllocator);
 
-// Graphics Pipelines
+// Graphics and Compute Pipelines
 VkResult trkCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache,
                                    uint32_t createInfoCount,
                                    const VkGraphicsPipelineCreateInfo* pCreateInfos,
                                    const VkAllocationCallbacks* pAllocator, VkPipeline* pPipelines);
+VkResult trkCreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache,
+                                  uint32_t createInfoCount,
+                                  const VkComputePipelineCreateInfo* pCreateInfos,
+                                  const VkAllocationCallbacks* pAllocator, VkPipeline* pPipelines);
 void trkDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks* pAllocator);
 
 // Pipeline Layouts
@@ -98,6 +102,12 @@ VkResult trkCreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateIn
 void trkDestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout,
                               const VkAllocationCallbacks* pAllocator);
 
+// Pipeline Caches
+VkResult trkCreatePipelineCache(VkDevice device, const VkPipelineCacheCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator, VkPipelineCache* pPipelineCache);
+void trkDestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache,
+                             const VkAllocationCallbacks* pAllocator);
+
 // Shader Modules
 VkResult trkCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule);
@@ -119,9 +129,14 @@ VkResult trkCreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateIn
 void trkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
                               const VkAllocationCallbacks* pAllocator);
 
+VkResult trkResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                VkDescriptorPoolResetFlags flags);
+
 // Descriptor Sets (allocation)
 VkResult trkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo* pAllocateInfo,
                                    VkDescriptorSet* pDescriptorSets);
+VkResult trkFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool,
+                               uint32_t descriptorSetCount, const VkDescriptorSet* pDescriptorSets);
 
 // Semaphores
 VkResult trkCreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo,
@@ -156,6 +171,11 @@ VkResult trkCreateEvent(VkDevice device, const VkEventCreateInfo* pCreateInfo,
                        const VkAllocationCallbacks* pAllocator, VkEvent* pEvent);
 void trkDestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks* pAllocator);
 
+// Query Pools
+VkResult trkCreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo,
+                           const VkAllocationCallbacks* pAllocator, VkQueryPool* pQueryPool);
+void trkDestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks* pAllocator);
+
 
 // MACRO INTERCEPTION: Redirect all Vulkan calls to tracking wrappers
 // These macros replace vkCreate*/vkDestroy* function names throughout VulkanModule
@@ -180,16 +200,21 @@ void trkDestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks
 #define vkCreateFramebuffer           trkCreateFramebuffer
 #define vkDestroyFramebuffer          trkDestroyFramebuffer
 #define vkCreateGraphicsPipelines     trkCreateGraphicsPipelines
+#define vkCreateComputePipelines      trkCreateComputePipelines
 #define vkDestroyPipeline             trkDestroyPipeline
 #define vkCreatePipelineLayout        trkCreatePipelineLayout
 #define vkDestroyPipelineLayout       trkDestroyPipelineLayout
+#define vkCreatePipelineCache         trkCreatePipelineCache
+#define vkDestroyPipelineCache        trkDestroyPipelineCache
 #define vkCreateShaderModule          trkCreateShaderModule
 #define vkDestroyShaderModule         trkDestroyShaderModule
 #define vkCreateDescriptorSetLayout   trkCreateDescriptorSetLayout
 #define vkDestroyDescriptorSetLayout  trkDestroyDescriptorSetLayout
 #define vkCreateDescriptorPool        trkCreateDescriptorPool
 #define vkDestroyDescriptorPool       trkDestroyDescriptorPool
+#define vkResetDescriptorPool         trkResetDescriptorPool
 #define vkAllocateDescriptorSets      trkAllocateDescriptorSets
+#define vkFreeDescriptorSets          trkFreeDescriptorSets
 #define vkCreateSemaphore             trkCreateSemaphore
 #define vkDestroySemaphore            trkDestroySemaphore
 #define vkCreateFence                 trkCreateFence
@@ -202,6 +227,8 @@ void trkDestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks
 #define vkDestroySampler              trkDestroySampler
 #define vkCreateEvent                 trkCreateEvent
 #define vkDestroyEvent                trkDestroyEvent
+#define vkCreateQueryPool             trkCreateQueryPool
+#define vkDestroyQueryPool            trkDestroyQueryPool
 
 #endif // NDEBUG
 
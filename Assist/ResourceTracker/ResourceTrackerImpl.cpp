@@ -223,6 +223,16 @@ void ResourceTracker::trackDescriptorSetAllocation(VkDescriptorPool pool, uint32
 }
 
 
+// Track descriptor sets individually freed back to their pool
+void ResourceTracker::trackDescriptorSetFree(VkDescriptorPool pool, uint32_t count)
+{
+	std::lock_guard<std::mutex> lock(trackingMutex);
+	auto it = poolToSetCount.find(pool);
+	if (it != poolToSetCount.end())
+		it->second = (it->second > count) ? it->second - count : 0;
+}
+
+
 // Get descriptor set count for a pool (and remove from map)
 uint32_t ResourceTracker::getDescriptorSetCountForPool(VkDescriptorPool pool)
 {
@@ -256,6 +266,7 @@ const char* ResourceTracker::resourceTypeName(VulkanResourceType type) const
 		case VK_RESOURCE_FRAMEBUFFER:			return "VkFramebuffer:";
 		case VK_RESOURCE_PIPELINE:				return "VkPipeline:";
 		case VK_RESOURCE_PIPELINE_LAYOUT:		return "VkPipelineLayout:";
+		case VK_RESOURCE_PIPELINE_CACHE:		return "VkPipelineCache:";
 		case VK_RESOURCE_SHADER_MODULE:			return "VkShaderModule:";
 
 		// Resources
@@ -280,6 +291,9 @@ const char* ResourceTracker::resourceTypeName(VulkanResourceType type) const
 		case VK_RESOURCE_COMMAND_POOL:			return "VkCommandPool:";
 		case VK_RESOURCE_COMMAND_BUFFER:		return "VkCommandBuffer:";
 
+		// Queries
+		case VK_RESOURCE_QUERY_POOL:			return "VkQueryPool:";
+
 		// Debug
 		case VK_RESOURCE_DEBUG_REPORT:			return "VkDebugReport:";
 
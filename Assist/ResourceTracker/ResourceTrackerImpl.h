@@ -45,6 +45,7 @@ enum VulkanResourceType {
 	VK_RESOURCE_FRAMEBUFFER,			// VkFramebuffer
 	VK_RESOURCE_PIPELINE,				// VkPipeline (graphics, compute)
 	VK_RESOURCE_PIPELINE_LAYOUT,		// VkPipelineLayout
+	VK_RESOURCE_PIPELINE_CACHE,			// VkPipelineCache
 	VK_RESOURCE_SHADER_MODULE,			// VkShaderModule
 
 	// Resources
@@ -69,6 +70,9 @@ enum VulkanResourceType {
 	VK_RESOURCE_COMMAND_POOL,			// VkCommandPool
 	VK_RESOURCE_COMMAND_BUFFER,			// VkCommandBuffer (freed automatically with pool, but tracked for completeness)
 
+	// Queries
+	VK_RESOURCE_QUERY_POOL,				// VkQueryPool (occlusion culling)
+
 	// Debug
 	VK_RESOURCE_DEBUG_REPORT,			// VkDebugReportCallbackEXT / VkDebugUtilsMessengerEXT
 
@@ -102,6 +106,7 @@ public:
 
 	// Descriptor set tracking (for implicit destruction when pool is destroyed)
 	void trackDescriptorSetAllocation(VkDescriptorPool pool, uint32_t count);
+	void trackDescriptorSetFree(VkDescriptorPool pool, uint32_t count);
 	uint32_t getDescriptorSetCountForPool(VkDescriptorPool pool);
 
 private:
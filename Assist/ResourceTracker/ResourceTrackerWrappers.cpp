@@ -42,16 +42,21 @@
 #undef vkCreateFramebuffer
 #undef vkDestroyFramebuffer
 #undef vkCreateGraphicsPipelines
+#undef vkCreateComputePipelines
 #undef vkDestroyPipeline
 #undef vkCreatePipelineLayout
 #undef vkDestroyPipelineLayout
+#undef vkCreatePipelineCache
+#undef vkDestroyPipelineCache
 #undef vkCreateShaderModule
 #undef vkDestroyShaderModule
 #undef vkCreateDescriptorSetLayout
 #undef vkDestroyDescriptorSetLayout
 #undef vkCreateDescriptorPool
 #undef vkDestroyDescriptorPool
+#undef vkResetDescriptorPool
 #undef vkAllocateDescriptorSets
+#undef vkFreeDescriptorSets
 #undef vkCreateSemaphore
 #undef vkDestroySemaphore
 #undef vkCreateFence
@@ -64,6 +69,8 @@
 #undef vkDestroySampler
 #undef vkCreateEvent
 #undef vkDestroyEvent
+#undef vkCreateQueryPool
+#undef vkDestroyQueryPool
 
 
 //
@@ -261,7 +268,7 @@ void trkDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer,
 
 
 //
-// Graphics Pipelines
+// Graphics and Compute Pipelines
 //
 
 VkResult trkCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
@@ -277,6 +284,19 @@ VkResult trkCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCac
 	return result;
 }
 
+VkResult trkCreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+								   const VkComputePipelineCreateInfo* pCreateInfos,
+								   const VkAllocationCallbacks* pAllocator, VkPipeline* pPipelines)
+{
+	VkResult result = vkCreateComputePipelines(device, pipelineCache, createInfoCount,
+											   pCreateInfos, pAllocator, pPipelines);
+	if (result == VK_SUCCESS) {
+		for (uint32_t i = 0; i < createInfoCount; i++)
+			VK_TRACK_CREATE(VK_RESOURCE_PIPELINE);
+	}
+	return result;
+}
+
 void trkDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks* pAllocator)
 {
 	vkDestroyPipeline(device, pipeline, pAllocator);
@@ -306,6 +326,27 @@ void trkDestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout,
 }
 
 
+//
+// Pipeline Caches
+//
+
+VkResult trkCreatePipelineCache(VkDevice device, const VkPipelineCacheCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator, VkPipelineCache* pPipelineCache)
+{
+	VkResult result = vkCreatePipelineCache(device, pCreateInfo, pAllocator, pPipelineCache);
+	if (result == VK_SUCCESS)
+		VK_TRACK_CREATE(VK_RESOURCE_PIPELINE_CACHE);
+	return result;
+}
+
+void trkDestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache,
+                             const VkAllocationCallbacks* pAllocator)
+{
+	vkDestroyPipelineCache(device, pipelineCache, pAllocator);
+	VK_TRACK_DESTROY(VK_RESOURCE_PIPELINE_CACHE);
+}
+
+
 //
 // Shader Modules
 //
@@ -379,6 +420,19 @@ void trkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
 		VK_TRACK_DESTROY(VK_RESOURCE_DESCRIPTOR_SET);
 }
 
+VkResult trkResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                VkDescriptorPoolResetFlags flags)
+{
+	// Resetting, like destroying, implicitly frees every descriptor set allocated from the pool
+	uint32_t descriptorSetCount = ResourceTracker::instance().getDescriptorSetCountForPool(descriptorPool);
+
+	VkResult result = vkResetDescriptorPool(device, descriptorPool, flags);
+
+	for (uint32_t i = 0; i < descriptorSetCount; i++)
+		VK_TRACK_DESTROY(VK_RESOURCE_DESCRIPTOR_SET);
+	return result;
+}
+
 
 //
 // Descriptor Sets (allocation)
@@ -399,6 +453,18 @@ VkResult trkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocat
 	return result;
 }
 
+VkResult trkFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool,
+                               uint32_t descriptorSetCount, const VkDescriptorSet* pDescriptorSets)
+{
+	VkResult result = vkFreeDescriptorSets(device, descriptorPool, descriptorSetCount, pDescriptorSets);
+	if (result == VK_SUCCESS) {
+		for (uint32_t i = 0; i < descriptorSetCount; i++)
+			VK_TRACK_DESTROY(VK_RESOURCE_DESCRIPTOR_SET);
+		ResourceTracker::instance().trackDescriptorSetFree(descriptorPool, descriptorSetCount);
+	}
+	return result;
+}
+
 
 //
 // Semaphores
@@ -527,4 +593,24 @@ void trkDestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks
 	VK_TRACK_DESTROY(VK_RESOURCE_EVENT);
 }
 
+
+//
+// Query Pools
+//
+
+VkResult trkCreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo,
+                           const VkAllocationCallbacks* pAllocator, VkQueryPool* pQueryPool)
+{
+	VkResult result = vkCreateQueryPool(device, pCreateInfo, pAllocator, pQueryPool);
+	if (result == VK_SUCCESS)
+		VK_TRACK_CREATE(VK_RESOURCE_QUERY_POOL);
+	return result;
+}
+
+void trkDestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks* pAllocator)
+{
+	vkDestroyQueryPool(device, queryPool, pAllocator);
+	VK_TRACK_DESTROY(VK_RESOURCE_QUERY_POOL);
+}
+
 #endif // NDEBUG
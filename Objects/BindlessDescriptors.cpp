@@ -0,0 +1,227 @@
+//
+// BindlessDescriptors.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "BindlessDescriptors.h"
+#include "SyncObjects.h"
+#include "ResourceTracker.h"
+
+
+void BindlessDescriptors::Create(VkDevice logicalDevice, uint32_t maxImages, uint32_t maxBuffers)
+{
+	device = logicalDevice;
+	imageSlots	= { .capacity = std::min(maxImages, MAX_IMAGES) };
+	bufferSlots	= { .capacity = std::min(maxBuffers, MAX_BUFFERS) };
+
+	createSetLayout();
+	createPoolAndSet();
+
+	Log(NOTE, "Bindless descriptors: %d image slots, %d buffer slots", imageSlots.capacity, bufferSlots.capacity);
+}
+
+void BindlessDescriptors::Destroy()
+{
+	if (device == VK_NULL_HANDLE)
+		return;
+
+	vkDestroyDescriptorPool(device, pool, nullALLOC);		// (freeing the set)
+	vkDestroyDescriptorSetLayout(device, setLayout, nullALLOC);
+	pool	  = VK_NULL_HANDLE;
+	set		  = VK_NULL_HANDLE;
+	setLayout = VK_NULL_HANDLE;
+	imageSlots	= {};
+	bufferSlots	= {};
+	device = VK_NULL_HANDLE;
+	Log(DEAD, "Destroyed: BindlessDescriptors");
+}
+
+
+void BindlessDescriptors::createSetLayout()
+{
+	VkDescriptorSetLayoutBinding bindings[] = {
+		{
+			.binding		 = IMAGES_BINDING,
+			.descriptorType	 = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+			.descriptorCount = imageSlots.capacity,
+			.stageFlags			= VK_SHADER_STAGE_ALL_GRAPHICS,
+			.pImmutableSamplers = nullptr
+		}, {
+			.binding		 = BUFFERS_BINDING,
+			.descriptorType	 = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.descriptorCount = bufferSlots.capacity,
+			.stageFlags			= VK_SHADER_STAGE_ALL_GRAPHICS,
+			.pImmutableSamplers = nullptr
+		}
+	};
+	const VkDescriptorBindingFlagsEXT bindless = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT
+											   | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT
+											   | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+	VkDescriptorBindingFlagsEXT bindingFlags[] = { bindless, bindless };
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+		.pNext	= nullptr,
+		.bindingCount	= N_ELEMENTS_IN_ARRAY(bindingFlags),
+		.pBindingFlags	= bindingFlags
+	};
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.pNext	= &bindingFlagsInfo,
+		.flags	= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+		.bindingCount = N_ELEMENTS_IN_ARRAY(bindings),
+		.pBindings	  = bindings
+	};
+
+	call = vkCreateDescriptorSetLayout(device, &layoutInfo, nullALLOC, &setLayout);
+	if (call != VK_SUCCESS)
+		Fatal("Create Bindless Descriptor Set Layout FAILURE" + ErrStr(call));
+}
+
+void BindlessDescriptors::createPoolAndSet()
+{
+	VkDescriptorPoolSize poolSizes[] = {
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageSlots.capacity  },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,		 bufferSlots.capacity }
+	};
+
+	VkDescriptorPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+		.maxSets		= 1,
+		.poolSizeCount	= N_ELEMENTS_IN_ARRAY(poolSizes),
+		.pPoolSizes		= poolSizes
+	};
+
+	call = vkCreateDescriptorPool(device, &poolInfo, nullALLOC, &pool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Bindless Descriptor Pool FAILURE" + ErrStr(call));
+
+	VkDescriptorSetAllocateInfo allocInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.pNext	= nullptr,
+		.descriptorPool		= pool,
+		.descriptorSetCount	= 1,
+		.pSetLayouts		= &setLayout
+	};
+
+	call = vkAllocateDescriptorSets(device, &allocInfo, &set);
+	if (call != VK_SUCCESS)
+		Fatal("Allocate Bindless Descriptor Set FAILURE" + ErrStr(call));
+}
+
+
+#pragma mark - Slots
+
+uint32_t BindlessDescriptors::RegisterImage(const VkDescriptorImageInfo& imageInfo)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	uint32_t slot = obtainSlot(imageSlots);
+	if (slot == NO_SLOT) {
+		Log(WARN, "Bindless image array full (%d); texture not registered.", imageSlots.capacity);
+		return NO_SLOT;
+	}
+
+	VkWriteDescriptorSet descriptorWrite = {
+		.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext	= nullptr,
+		.dstSet			 = set,
+		.dstBinding		 = IMAGES_BINDING,
+		.dstArrayElement = slot,
+		.descriptorCount	= 1,
+		.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		.pImageInfo			= &imageInfo,
+		.pBufferInfo		= nullptr,
+		.pTexelBufferView	= nullptr
+	};
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+	return slot;
+}
+
+uint32_t BindlessDescriptors::RegisterBuffer(const VkDescriptorBufferInfo& bufferInfo)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	uint32_t slot = obtainSlot(bufferSlots);
+	if (slot == NO_SLOT) {
+		Log(WARN, "Bindless buffer array full (%d); buffer not registered.", bufferSlots.capacity);
+		return NO_SLOT;
+	}
+
+	VkWriteDescriptorSet descriptorWrite = {
+		.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext	= nullptr,
+		.dstSet			 = set,
+		.dstBinding		 = BUFFERS_BINDING,
+		.dstArrayElement = slot,
+		.descriptorCount	= 1,
+		.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.pImageInfo			= nullptr,
+		.pBufferInfo		= &bufferInfo,
+		.pTexelBufferView	= nullptr
+	};
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+	return slot;
+}
+
+// The slot's descriptor is left as is (partially bound: simply not to be accessed) until reused, which
+//	is only once frames in flight that may still sample it have completed (see AdvanceFrame).
+//
+void BindlessDescriptors::UnregisterImage(uint32_t slot)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	releaseSlot(imageSlots, slot);
+}
+
+void BindlessDescriptors::UnregisterBuffer(uint32_t slot)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	releaseSlot(bufferSlots, slot);
+}
+
+// Call before recording each frame, once its fence has been waited: a slot retired during frame N was
+//	last used by no later a submission than N's, which has completed by frame N + MAX_FRAMES_IN_FLIGHT.
+//
+void BindlessDescriptors::AdvanceFrame()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	++frameCount;
+	freeRetired(imageSlots);
+	freeRetired(bufferSlots);
+}
+
+
+uint32_t BindlessDescriptors::obtainSlot(Slots& slots)
+{
+	if (! slots.freed.empty()) {
+		uint32_t slot = slots.freed.back();
+		slots.freed.pop_back();
+		return slot;
+	}
+	return slots.nUsed < slots.capacity ? slots.nUsed++ : NO_SLOT;
+}
+
+void BindlessDescriptors::releaseSlot(Slots& slots, uint32_t slot)
+{
+	if (device == VK_NULL_HANDLE || slot >= slots.nUsed)	// (destroyed already, or never registered)
+		return;
+	slots.retired.push_back({ slot, frameCount });
+}
+
+void BindlessDescriptors::freeRetired(Slots& slots)
+{
+	size_t nKept = 0;
+	for (Slots::Retired& retired : slots.retired)
+		if (frameCount - retired.frame >= MAX_FRAMES_IN_FLIGHT)
+			slots.freed.push_back(retired.slot);
+		else
+			slots.retired[nKept++] = retired;
+	slots.retired.resize(nKept);
+}
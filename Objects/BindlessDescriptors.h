@@ -0,0 +1,93 @@
+//
+// BindlessDescriptors.h
+//	Vulkan Setup
+//
+// One device-wide descriptor set holding large arrays of every texture (and, optionally, storage buffer),
+//	each registered into a slot, for shaders to index: "bindless" access.  Rather than every textured
+//	renderable binding its own COMBINED_IMAGE_SAMPLER in its own set (so every material a distinct set
+//	layout, and a distinct set to bind per draw), renderables customized BINDLESS bind this one set too,
+//	at SET_INDEX, and push their material's slot (DrawPushConstants.materialIndex) per draw:
+//		layout(set = 1, binding = 0) uniform sampler2D textures[];
+//		layout(set = 1, binding = 1) buffer Materials { ... } materials[];
+//		...	texture(textures[nonuniformEXT(draw.materialIndex)], uv)
+//	Their own set 0 then holds only UBOs, so renderables of differing textures share one set layout,
+//	one pipeline layout and (shaders equal) one pipeline, i.e. one batch (see RenderBatch).
+//
+// Requires VK_EXT_descriptor_indexing (core in Vulkan 1.2) features: partially bound arrays, so unused
+//	slots needn't hold valid descriptors, and update-after-bind, so slots are written while the set is
+//	bound, even by command buffers still pending (for slots those don't use).  GraphicsDevice enables
+//	them if supported and RenderSettings.useBindless, and only then Creates this; otherwise IsEnabled is
+//	false and renderables customized BINDLESS draw as any other, their textures in set 0.
+//
+// A slot unregistered is retired, not reused, until MAX_FRAMES_IN_FLIGHT frame boundaries later (see
+//	AdvanceFrame), as with update-after-bind, rewriting it could change what a frame still executing
+//	samples.  Only textures of renderables customized BINDLESS register (see TextureImage).
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef BindlessDescriptors_h
+#define BindlessDescriptors_h
+
+#include "VulkanPlatform.h"
+#include <mutex>
+
+
+class BindlessDescriptors
+{
+public:
+	BindlessDescriptors() = default;
+	~BindlessDescriptors()	{ Destroy(); }
+
+	static constexpr uint32_t SET_INDEX		  = 1;		// (following each renderable's own set 0)
+	static constexpr uint32_t IMAGES_BINDING  = 0;
+	static constexpr uint32_t BUFFERS_BINDING = 1;
+	static constexpr uint32_t MAX_IMAGES	  = 4096;	// (or fewer, if the device's limits are lower)
+	static constexpr uint32_t MAX_BUFFERS	  = 1024;
+	static constexpr uint32_t NO_SLOT		  = ~0u;
+
+		// MEMBERS
+private:
+	VkDevice				device	  = VK_NULL_HANDLE;
+	VkDescriptorSetLayout	setLayout = VK_NULL_HANDLE;
+	VkDescriptorPool		pool	  = VK_NULL_HANDLE;
+	VkDescriptorSet			set		  = VK_NULL_HANDLE;
+
+	struct Slots {
+		uint32_t			capacity = 0;
+		uint32_t			nUsed	 = 0;		// (high-water mark; below it, those freed are reused first)
+		vector<uint32_t>	freed;
+		struct Retired { uint32_t slot; uint64_t frame; };
+		vector<Retired>		retired;			// (unregistered, awaiting frames in flight)
+	}	imageSlots, bufferSlots;
+	uint64_t	frameCount = 0;
+
+	std::mutex	mutex;		// (textures may be created off the main thread)
+
+		// METHODS
+public:
+	void	Create(VkDevice logicalDevice, uint32_t maxImages, uint32_t maxBuffers);
+	void	Destroy();						// Idempotent.
+
+	// Write the descriptor into a free slot, returning it (or NO_SLOT if the array is full).
+	uint32_t	RegisterImage(const VkDescriptorImageInfo& imageInfo);
+	uint32_t	RegisterBuffer(const VkDescriptorBufferInfo& bufferInfo);
+	void		UnregisterImage(uint32_t slot);
+	void		UnregisterBuffer(uint32_t slot);
+
+	void		AdvanceFrame();		// At each frame boundary: frees slots retired long enough ago.
+private:
+	void		createSetLayout();
+	void		createPoolAndSet();
+	uint32_t	obtainSlot(Slots& slots);
+	void		releaseSlot(Slots& slots, uint32_t slot);
+	void		freeRetired(Slots& slots);
+
+		// getters
+public:
+	bool					IsEnabled()		{ return set != VK_NULL_HANDLE; }
+	VkDescriptorSet&		getSet()		{ return set;		}
+	VkDescriptorSetLayout	getSetLayout()	{ return setLayout; }
+};
+
+#endif	// BindlessDescriptors_h
@@ -109,10 +109,10 @@ void CommandBufferSet::recordCommands(vector<iRenderableBase*> pBufferRenderable
 	};
 
 	// Build pipeline batches for optimized recording; reduces pipeline binds from O(N) to O(M).
-	// Returns self-managed renderables (like ImGui) to render last.
-	vector<iRenderableBase*> selfManagedRenderables = batchManager.buildBatches(pBufferRenderables);
-
+	// Returns self-managed renderables (like ImGui) to render last.  (Also selects levels of detail.)
 	size_t numBufferSets = vkCommandBuffers.size();
+	vector<iRenderableBase*> selfManagedRenderables = batchManager.buildBatches(pBufferRenderables, (float) swapchainExtent.height,
+																				(uint32_t) numBufferSets);
 
 	for (int iBuffer = 0; iBuffer < numBufferSets; ++iBuffer)
 	{
@@ -122,16 +122,21 @@ void CommandBufferSet::recordCommands(vector<iRenderableBase*> pBufferRenderable
 		if (call != VK_SUCCESS)
 			Fatal("Fail to even Begin recording Command Buffer," + ErrStr(call));
 
+		batchManager.recordPreRenderPass(commandBuffer, iBuffer);
+
 //		if (iBuffer > 0)	// await prior buffer executions's completion
 //			event.CmdWaitRecordTo(commandBuffer);
 
 		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		GraphicsPipeline::CmdSetViewportAndScissor(commandBuffer, swapchainExtent);
 
 		// Record all batches with optimized pipeline binding, self-managed renderables last:
-		batchManager.recordBatches(commandBuffer, iBuffer, selfManagedRenderables);
+		batchManager.recordBatches(commandBuffer, iBuffer, swapchainExtent, selfManagedRenderables);
 
 		vkCmdEndRenderPass(commandBuffer);
 
+		batchManager.recordPostRenderPass(commandBuffer);
+
 //		if (iBuffer < numBufferSets - 1)	// trigger next buffer's execution to begin
 //			event.CmdSetRecordTo(commandBuffer);
 
@@ -149,6 +154,9 @@ CommandControl::CommandControl(Framebuffers& framebuffers, GraphicsDevice& graph
 {
 	pSingleton	= this;
 	Create(framebuffers);
+
+	// Renderables constructed from here on build their pipelines together, upon PostInitPrepBuffers.
+	GraphicsPipeline::BeginBuildPhase();
 }
 
 CommandControl*	CommandControl::pSingleton = nullptr;
@@ -181,6 +189,11 @@ void CommandControl::Destroy()
 //
 void CommandControl::PostInitPrepBuffers(VulkanSetup& vulkan)
 {
+	GraphicsPipeline::BuildPending();		// (all must exist before commands bind them)
+	GraphicsPipeline::CollectCompiled();
+	vulkan.device.getDescriptorWriter().Flush();	// (likewise descriptor sets' contents)
+	vulkan.textureLoader.Submit();					// (and textures', ahead on the queue of draws)
+
 	vector<iRenderableBase*> mergedRenderables;
 	BuildMergedVectorFromTypedSources(mergedRenderables);
 
@@ -212,6 +225,13 @@ void CommandControl::RecordRenderablesForNextFrame(VulkanSetup& vulkan, int iNex
 	vector<iRenderableBase*> mergedRenderables;
 	BuildMergedVectorFromTypedSources(mergedRenderables);
 
+	GraphicsPipeline::BuildPending();		// (in case PostInitPrepBuffers wasn't called since deferring any)
+	GraphicsPipeline::CollectCompiled();	// Frame boundary: swap in any finished compiling.
+	vulkan.device.getDescriptorWriter().Flush();
+	vulkan.textureLoader.Submit();
+	vulkan.device.getPipelineCache().SaveIfDue();
+	vulkan.device.getBindless().AdvanceFrame();
+
 	// Record command buffer for next frame.
 	buffersByFrame[iNextFrame].recordCommands(mergedRenderables, vulkan.framebuffers[iNextFrame],
 											  vulkan.swapchain.getExtent(), vulkan.renderPass.getVkRenderPass());
@@ -237,6 +257,9 @@ void CommandControl::RecreateBuffers(Framebuffers& framebuffers)
 void CommandControl::RecreateRenderables(VulkanSetup& vulkan)
 {
 	RecreateBuffers(vulkan.framebuffers);
+	GraphicsPipeline::BeginBuildPhase();
 	renderables.Recreate(vulkan);
+	if (pHiZCulling)
+		pHiZCulling->Recreate(vulkan);
 	PostInitPrepBuffers(vulkan);
 }
@@ -111,6 +111,8 @@ public:
 		// MEMBERS
 	bool		renderInOrderAdded;		// i.e. draw Renderables in same order as they were added
 
+	LODSelector	levelOfDetail;			// Tunes which level of detail meshes having them draw.
+
 	Renderables	renderables;						// size == numBufferSets
 
 	// Side note: Conceptually, "Renderables" may seem like they should be separate from the Vulkan
@@ -124,6 +126,9 @@ private:
 
 	CommandBufferSets	buffersByFrame;				// size == numFrames (Framebuffers.size())
 
+	OcclusionCulling*	pOcclusionCulling = nullptr;	// (app-owned, optional)
+	HiZCulling*			pHiZCulling		  = nullptr;	// (app-owned, optional; supersedes the above)
+
 		// METHODS
 	void recordCommands(int iFrame, vector<iRenderableBase*> pRenderables, VulkanSetup& vulkan);
 
@@ -144,12 +149,21 @@ public:
 	void RecreateBuffers(Framebuffers& framebuffers);
 	void RecreateRenderables(VulkanSetup& vulkan);
 
+	// Enable (or with nullptr, disable) culling of occluded renderables; see OcclusionCulling.h.
+	void SetOcclusionCulling(OcclusionCulling* pCulling) { pOcclusionCulling = pCulling; }
+
+	// Likewise, but on the GPU against last frame's depth; see HiZCulling.h.
+	void SetHiZCulling(HiZCulling* pCulling) { pHiZCulling = pCulling; }
+
 		// getters
 	uint32_t				NumFrames()	{ return numFrames; }
 	CommandPool&			getCommandPool() { return commandPool; }
 
 	static GraphicsDevice&	device()	{ return pSingleton->commandPool.device; }
 	static VkCommandPool&	vkPool()	{ return pSingleton->commandPool.vkCommandPool; }
+	static OcclusionCulling* occlusionCulling()	{ return pSingleton->pOcclusionCulling; }
+	static HiZCulling*		hiZCulling()		{ return pSingleton->pHiZCulling; }
+	static LODSelector&		lodSelector()		{ return pSingleton->levelOfDetail; }
 };
 
 #endif // CommandObjects_h
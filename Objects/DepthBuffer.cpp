@@ -10,9 +10,10 @@
 #include "DepthBuffer.h"
 
 
-DepthBuffer::DepthBuffer(Swapchain& swapchain, GraphicsDevice& graphics, bool enabled)
+DepthBuffer::DepthBuffer(Swapchain& swapchain, GraphicsDevice& graphics, bool enabled, bool sampled)
 	:	ImageResource(graphics),
-		graphicsDevice(graphics)
+		graphicsDevice(graphics),
+		isSampled(sampled)
 {
 	if (! enabled) return;
 
@@ -33,8 +34,10 @@ DepthBuffer::~DepthBuffer()
 void DepthBuffer::create()
 {
 	selectBestDepthFormat();
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+							| (isSampled ? VK_IMAGE_USAGE_SAMPLED_BIT : 0);
 	createImage(imageInfo.wide, imageInfo.high, imageInfo.format, VK_IMAGE_TILING_OPTIMAL,
-				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+				usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 	createImageView(VK_IMAGE_ASPECT_DEPTH_BIT);
 }
 
@@ -44,8 +47,10 @@ void DepthBuffer::selectBestDepthFormat() {
 		VK_FORMAT_D32_SFLOAT_S8_UINT,	// S8_UINT ≡ stencil component
 		VK_FORMAT_D24_UNORM_S8_UINT		//
 	};
+	VkFormatFeatureFlags features = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+								  | (isSampled ? VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT : 0);
 	auto format = findSupportedFormat(candidateFormats, N_ELEMENTS_IN_ARRAY(candidateFormats),
-									  VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+									  VK_IMAGE_TILING_OPTIMAL, features);
 	imageInfo.format = format;
 	graphicsDevice.getProfile().selectedDepthFormat = format;
 }
@@ -18,12 +18,13 @@
 class DepthBuffer : protected ImageResource
 {
 public:
-	DepthBuffer(Swapchain& swapchain, GraphicsDevice& graphics, bool enabled = true);
+	DepthBuffer(Swapchain& swapchain, GraphicsDevice& graphics, bool enabled = true, bool sampled = false);
 	~DepthBuffer();
 
 		// MEMBERS
 private:
 	GraphicsDevice&	graphicsDevice;
+	bool			isSampled;		// (read by shaders after the render pass, e.g. HiZCulling)
 
 		// METHODS
 private:
@@ -42,6 +43,9 @@ public:
 			return nullptr;
 		return &imageView;
 	}
+
+	VkExtent2D	getExtent()				{ return { (uint32_t) imageInfo.wide, (uint32_t) imageInfo.high }; }
+	bool		isSampledByShaders()	{ return isSampled; }
 };
 
 #endif	// DepthBuffer_h
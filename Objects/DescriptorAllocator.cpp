@@ -0,0 +1,139 @@
+//
+// DescriptorAllocator.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "DescriptorAllocator.h"
+#include "ResourceTracker.h"
+
+
+// Descriptors of each type that a pool provides, per set it may hold.
+//
+const VkDescriptorPoolSize POOL_SIZES_PER_SET[] = {
+	{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,			2 },
+	{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,	1 },
+	{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,	4 },
+	{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,			1 }
+};
+
+
+void DescriptorAllocator::Create(VkDevice logicalDevice)
+{
+	device = logicalDevice;
+}
+
+void DescriptorAllocator::Destroy()
+{
+	if (device == VK_NULL_HANDLE)
+		return;
+
+	int nPools = 0;
+	for (PoolList& list : poolLists) {
+		for (Pool& pool : list.pools)
+			vkDestroyDescriptorPool(device, pool.pool, nullALLOC);
+		for (VkDescriptorPool& pool : list.resetPools)
+			vkDestroyDescriptorPool(device, pool, nullALLOC);
+		nPools += (int) (list.pools.size() + list.resetPools.size());
+		list.pools.clear();
+		list.resetPools.clear();
+	}
+	device = VK_NULL_HANDLE;
+	Log(DEAD, "Destroyed: DescriptorAllocator (%d pools)", nPools);
+}
+
+
+void DescriptorAllocator::Allocate(const vector<VkDescriptorSetLayout>& layouts, vector<VkDescriptorSet>& sets,
+								   VkDescriptorPool& pool, DescriptorPoolClass poolClass)
+{
+	PoolList& list = poolLists[poolClass];
+	if (list.pools.empty())
+		list.pools.push_back({ obtainPool(poolClass), 0 });
+
+	sets.resize(layouts.size());
+
+	for (int attempt = 0; attempt < 2; ++attempt) {
+		Pool& current = list.pools.back();
+
+		VkDescriptorSetAllocateInfo allocInfo = {
+			.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.pNext	= nullptr,
+			.descriptorPool		= current.pool,
+			.descriptorSetCount	= (uint32_t) layouts.size(),
+			.pSetLayouts		= layouts.data()
+		};
+
+		VkResult result = vkAllocateDescriptorSets(device, &allocInfo, sets.data());
+		if (result == VK_SUCCESS) {
+			current.numLiveSets += (uint32_t) sets.size();
+			pool = current.pool;
+			return;
+		}
+		if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+			Fatal("Allocate Descriptor Sets FAILURE" + ErrStr(result));
+
+		list.pools.push_back({ obtainPool(poolClass), 0 });		// Current pool is full: roll to another.
+	}
+	Fatal("Allocate Descriptor Sets FAILURE: more than a whole pool holds");
+}
+
+void DescriptorAllocator::Free(vector<VkDescriptorSet>& sets, VkDescriptorPool pool, DescriptorPoolClass poolClass)
+{
+	if (sets.empty() || device == VK_NULL_HANDLE)
+		return;
+
+	PoolList& list = poolLists[poolClass];
+	for (size_t iPool = 0; iPool < list.pools.size(); ++iPool) {
+		Pool& found = list.pools[iPool];
+		if (found.pool != pool)
+			continue;
+
+		vkFreeDescriptorSets(device, pool, (uint32_t) sets.size(), sets.data());
+		found.numLiveSets -= (uint32_t) sets.size();
+
+		if (found.numLiveSets == 0 && iPool + 1 < list.pools.size()) {	// (retired pool, now empty)
+			vkResetDescriptorPool(device, pool, 0);
+			list.resetPools.push_back(pool);
+			list.pools.erase(list.pools.begin() + iPool);
+		}
+		break;
+	}
+	sets.clear();
+}
+
+
+VkDescriptorPool DescriptorAllocator::obtainPool(DescriptorPoolClass poolClass)
+{
+	PoolList& list = poolLists[poolClass];
+	if (! list.resetPools.empty()) {
+		VkDescriptorPool pool = list.resetPools.back();
+		list.resetPools.pop_back();
+		return pool;
+	}
+
+	const uint32_t nSizes = N_ELEMENTS_IN_ARRAY(POOL_SIZES_PER_SET);
+	VkDescriptorPoolSize poolSizes[nSizes];
+	for (uint32_t iSize = 0; iSize < nSizes; ++iSize)
+		poolSizes[iSize] = {
+			.type			 = POOL_SIZES_PER_SET[iSize].type,
+			.descriptorCount = POOL_SIZES_PER_SET[iSize].descriptorCount * SETS_PER_POOL
+		};
+
+	VkDescriptorPoolCreateInfo poolInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+		.maxSets		= SETS_PER_POOL,
+		.poolSizeCount	= nSizes,
+		.pPoolSizes		= poolSizes
+	};
+
+	VkDescriptorPool pool;
+	call = vkCreateDescriptorPool(device, &poolInfo, nullALLOC, &pool);
+	if (call != VK_SUCCESS)
+		Fatal("Create Descriptor Pool FAILURE" + ErrStr(call));
+	return pool;
+}
@@ -0,0 +1,66 @@
+//
+// DescriptorAllocator.h
+//	Vulkan Setup
+//
+// Device-wide allocator of descriptor sets, from a few large VkDescriptorPools shared by all, rather
+//	than a pool per Descriptors sized exactly for its sets (so thousands of renderables, thousands
+//	of pools).  Pools come in "classes," by how their sets are used, each a list of pools: sets are
+//	allocated from the newest, and once it is exhausted (VK_ERROR_OUT_OF_POOL_MEMORY, or _FRAGMENTED_POOL)
+//	another is added.  Sets are freed individually; an older pool with none left is then reset and
+//	kept to serve as the next new one, instead of creating another.
+//
+// Owned by GraphicsDevice, living and dying with its logical device; every set must be freed (or its
+//	owner destroyed) before that.  Pool sizes are ratios per set (see POOL_SIZES_PER_SET), generous
+//	enough for any renderable's set; a pool holds SETS_PER_POOL sets.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef DescriptorAllocator_h
+#define DescriptorAllocator_h
+
+#include "VulkanPlatform.h"
+
+
+enum DescriptorPoolClass {
+	GENERAL_SETS,			// e.g. each renderable's (see Descriptors), freed as renderables go
+	NUM_DESCRIPTOR_POOL_CLASSES
+};
+
+
+class DescriptorAllocator
+{
+public:
+	DescriptorAllocator() = default;
+	~DescriptorAllocator()	{ Destroy(); }
+
+	static constexpr uint32_t SETS_PER_POOL = 512;
+
+		// MEMBERS
+private:
+	VkDevice	device = VK_NULL_HANDLE;
+
+	struct Pool {
+		VkDescriptorPool	pool;
+		uint32_t			numLiveSets;
+	};
+	struct PoolList {
+		vector<Pool>				pools;		// (the last being the one allocated from)
+		vector<VkDescriptorPool>	resetPools;	// (emptied, ready for reuse)
+	}	poolLists[NUM_DESCRIPTOR_POOL_CLASSES];
+
+		// METHODS
+public:
+	void	Create(VkDevice logicalDevice);
+	void	Destroy();						// Idempotent.
+
+	// Allocate one set per layout, returning which pool they came from, to free them to.
+	void	Allocate(const vector<VkDescriptorSetLayout>& layouts, vector<VkDescriptorSet>& sets,
+					 VkDescriptorPool& pool, DescriptorPoolClass poolClass = GENERAL_SETS);
+	void	Free(vector<VkDescriptorSet>& sets, VkDescriptorPool pool,
+				 DescriptorPoolClass poolClass = GENERAL_SETS);
+private:
+	VkDescriptorPool	obtainPool(DescriptorPoolClass poolClass);
+};
+
+#endif	// DescriptorAllocator_h
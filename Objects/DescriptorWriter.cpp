@@ -0,0 +1,176 @@
+//
+// DescriptorWriter.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "DescriptorWriter.h"
+#include "LayoutCache.h"
+#include "ResourceTracker.h"
+#include <algorithm>
+
+
+void DescriptorWriter::Create(VkDevice logicalDevice, bool useTemplates, bool usePushDescriptors)
+{
+	device = logicalDevice;
+
+	if (useTemplates) {
+		createUpdateTemplate  = (PFN_vkCreateDescriptorUpdateTemplateKHR)
+								 vkGetDeviceProcAddr(device, "vkCreateDescriptorUpdateTemplateKHR");
+		destroyUpdateTemplate = (PFN_vkDestroyDescriptorUpdateTemplateKHR)
+								 vkGetDeviceProcAddr(device, "vkDestroyDescriptorUpdateTemplateKHR");
+		updateWithTemplate	  = (PFN_vkUpdateDescriptorSetWithTemplateKHR)
+								 vkGetDeviceProcAddr(device, "vkUpdateDescriptorSetWithTemplateKHR");
+		if (! createUpdateTemplate || ! destroyUpdateTemplate || ! updateWithTemplate)
+			updateWithTemplate = nullptr;
+	}
+	if (usePushDescriptors)
+		cmdPushDescriptorSet = (PFN_vkCmdPushDescriptorSetKHR)
+								vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetKHR");
+}
+
+void DescriptorWriter::Destroy()
+{
+	if (device == VK_NULL_HANDLE)
+		return;
+
+	pending.clear();
+	for (auto& [key, updateTemplate] : templates)
+		destroyUpdateTemplate(device, updateTemplate, nullALLOC);
+	if (! templates.empty())
+		Log(DEAD, "Destroyed: DescriptorWriter (%d update templates)", (int) templates.size());
+	templates.clear();
+
+	createUpdateTemplate  = nullptr;
+	destroyUpdateTemplate = nullptr;
+	updateWithTemplate	  = nullptr;
+	cmdPushDescriptorSet  = nullptr;
+	device = VK_NULL_HANDLE;
+}
+
+
+void DescriptorWriter::Write(VkDescriptorSet set, VkDescriptorSetLayout setLayout,
+							 const vector<VkDescriptorType>& types, vector<DescriptorInfo>&& infos)
+{
+	pending.push_back({
+		.set			= set,
+		.updateTemplate	= usesTemplates() ? obtainTemplate(setLayout, types) : VK_NULL_HANDLE,
+		.types			= types,
+		.infos			= std::move(infos)
+	});
+}
+
+void DescriptorWriter::Forget(const vector<VkDescriptorSet>& sets)
+{
+	std::erase_if(pending, [&sets](PendingWrite& write) {
+		return std::find(sets.begin(), sets.end(), write.set) != sets.end();
+	});
+}
+
+void DescriptorWriter::Flush()
+{
+	if (pending.empty())
+		return;
+
+	for (PendingWrite& write : pending)
+		if (write.updateTemplate != VK_NULL_HANDLE)
+			updateWithTemplate(device, write.set, write.updateTemplate, write.infos.data());
+
+	writeWithoutTemplates();
+	pending.clear();
+}
+
+// The rest, all in one call.
+//
+void DescriptorWriter::writeWithoutTemplates()
+{
+	vector<VkWriteDescriptorSet> descriptorWrites;
+
+	for (PendingWrite& write : pending)
+		if (write.updateTemplate == VK_NULL_HANDLE)
+			appendWrites(descriptorWrites, write.set, write.types, write.infos);
+
+	if (! descriptorWrites.empty())
+		vkUpdateDescriptorSets(device, (uint32_t) descriptorWrites.size(), descriptorWrites.data(), 0, nullptr);
+}
+
+void DescriptorWriter::appendWrites(vector<VkWriteDescriptorSet>& descriptorWrites, VkDescriptorSet set,
+									const vector<VkDescriptorType>& types, const vector<DescriptorInfo>& infos)
+{
+	for (uint32_t iBind = 0; iBind < (uint32_t) types.size(); ++iBind) {
+		bool isImage = types[iBind] == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites.push_back({
+			.sType	= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext	= nullptr,
+			.dstSet			 = set,
+			.dstBinding		 = iBind,
+			.dstArrayElement = 0,
+			.descriptorCount	= 1,
+			.descriptorType		= types[iBind],
+			.pImageInfo			= isImage ? &infos[iBind].image  : nullptr,
+			.pBufferInfo		= isImage ? nullptr : &infos[iBind].buffer,
+			.pTexelBufferView	= nullptr
+		});
+	}
+}
+
+
+// (dstSet is ignored when pushed.)
+//
+void DescriptorWriter::CmdPush(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t iSet,
+							   const vector<VkDescriptorType>& types, const vector<DescriptorInfo>& infos)
+{
+	vector<VkWriteDescriptorSet> descriptorWrites;
+	appendWrites(descriptorWrites, VK_NULL_HANDLE, types, infos);
+
+	cmdPushDescriptorSet(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, iSet,
+						 (uint32_t) descriptorWrites.size(), descriptorWrites.data());
+}
+
+
+// Every set of the same layout definition is written alike: binding i from infos[i].
+//
+VkDescriptorUpdateTemplateKHR DescriptorWriter::obtainTemplate(VkDescriptorSetLayout setLayout,
+															   const vector<VkDescriptorType>& types)
+{
+	uint64_t key = LayoutCache::SetLayoutKey(setLayout);
+	auto found = templates.find(key);
+	if (found != templates.end())
+		return found->second;
+
+	vector<VkDescriptorUpdateTemplateEntryKHR> entries(types.size());
+	for (uint32_t iBind = 0; iBind < (uint32_t) types.size(); ++iBind)
+		entries[iBind] = {
+			.dstBinding		 = iBind,
+			.dstArrayElement = 0,
+			.descriptorCount = 1,
+			.descriptorType	 = types[iBind],
+			.offset	= iBind * sizeof(DescriptorInfo),
+			.stride	= sizeof(DescriptorInfo)
+		};
+
+	VkDescriptorUpdateTemplateCreateInfoKHR templateInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.descriptorUpdateEntryCount	= (uint32_t) entries.size(),
+		.pDescriptorUpdateEntries	= entries.data(),
+		.templateType			= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR,
+		.descriptorSetLayout	= setLayout,
+		.pipelineBindPoint		= VK_PIPELINE_BIND_POINT_GRAPHICS,	// (these three unused,
+		.pipelineLayout			= VK_NULL_HANDLE,					//	 for a template of
+		.set					= 0									//	 _DESCRIPTOR_SET type)
+	};
+
+	VkDescriptorUpdateTemplateKHR updateTemplate;
+	VkResult result = createUpdateTemplate(device, &templateInfo, nullALLOC, &updateTemplate);
+	if (result != VK_SUCCESS) {
+		Log(WARN, "Create Descriptor Update Template failed" + ErrStr(result) + "; writing sets without.");
+		return VK_NULL_HANDLE;
+	}
+	templates[key] = updateTemplate;
+	return updateTemplate;
+}
@@ -0,0 +1,95 @@
+//
+// DescriptorWriter.h
+//	Vulkan Setup
+//
+// Device-wide writer of descriptor sets' contents, batched: rather than each Descriptors filling in
+//	VkWriteDescriptorSets and calling vkUpdateDescriptorSets per set (per swapchain image, per renderable),
+//	Write queues a set's descriptor infos, then Flush writes every one queued at once, before command
+//	buffers next record (and so bind them).  Spawning hundreds of renderables thus costs one pass.
+//
+// Where the device has VK_KHR_descriptor_update_template (core in Vulkan 1.1), each set is written by
+//	a VkDescriptorUpdateTemplate straight from its packed infos, the template created once per set layout
+//	(see LayoutCache::SetLayoutKey, shared by all of the same definition) and reused by every set of it.  Otherwise all
+//	queued sets' VkWriteDescriptorSets go to a single vkUpdateDescriptorSets.
+//
+// Where the device has VK_KHR_push_descriptor, a set whose contents change every draw needn't be a set at
+//	all: CmdPush records its descriptors straight into the command buffer (vkCmdPushDescriptorSetKHR),
+//	no set allocated, nor one per swapchain image, nor written in advance.  Its set layout must be created
+//	PUSH_DESCRIPTOR (see Descriptors), and a pipeline layout may hold only one such.
+//
+// Owned by GraphicsDevice, living and dying with its logical device.  A set freed while its write is
+//	still queued must be forgotten first (Forget).  Not thread-safe: use from the main thread.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef DescriptorWriter_h
+#define DescriptorWriter_h
+
+#include "VulkanPlatform.h"
+#include <unordered_map>
+
+
+// One binding's descriptor, packed (at a fixed stride) as an update template reads it.
+//
+union DescriptorInfo {
+	VkDescriptorBufferInfo	buffer;
+	VkDescriptorImageInfo	image;
+};
+
+
+class DescriptorWriter
+{
+public:
+	DescriptorWriter() = default;
+	~DescriptorWriter()	{ Destroy(); }
+
+	static constexpr uint32_t	MAX_PUSH_DESCRIPTORS = 32;	// (the least maxPushDescriptors a device may have)
+
+		// MEMBERS
+private:
+	VkDevice	device = VK_NULL_HANDLE;
+
+	struct PendingWrite {
+		VkDescriptorSet					set;
+		VkDescriptorUpdateTemplateKHR	updateTemplate;		// (VK_NULL_HANDLE: write without)
+		vector<VkDescriptorType>		types;				// (per binding, numbered from 0)
+		vector<DescriptorInfo>			infos;
+	};
+	vector<PendingWrite>	pending;
+
+	std::unordered_map<uint64_t, VkDescriptorUpdateTemplateKHR>	templates;	// by set layout key
+
+	PFN_vkCreateDescriptorUpdateTemplateKHR		createUpdateTemplate	= nullptr;
+	PFN_vkDestroyDescriptorUpdateTemplateKHR	destroyUpdateTemplate	= nullptr;
+	PFN_vkUpdateDescriptorSetWithTemplateKHR	updateWithTemplate		= nullptr;
+	PFN_vkCmdPushDescriptorSetKHR				cmdPushDescriptorSet	= nullptr;
+
+		// METHODS
+public:
+	void	Create(VkDevice logicalDevice, bool useTemplates, bool usePushDescriptors);
+	void	Destroy();						// Idempotent.
+
+	// Queue writing `infos` (one per binding, of `types`) into `set`, allocated with `setLayout`.
+	void	Write(VkDescriptorSet set, VkDescriptorSetLayout setLayout,
+				  const vector<VkDescriptorType>& types, vector<DescriptorInfo>&& infos);
+	void	Forget(const vector<VkDescriptorSet>& sets);
+	void	Flush();						// Call before recording commands that bind them.
+
+	// Record `infos` (one per binding, of `types`) as set index iSet of pipelineLayout, in place of binding a set.
+	void	CmdPush(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t iSet,
+					const vector<VkDescriptorType>& types, const vector<DescriptorInfo>& infos);
+private:
+	VkDescriptorUpdateTemplateKHR	obtainTemplate(VkDescriptorSetLayout setLayout,
+												   const vector<VkDescriptorType>& types);
+	void	writeWithoutTemplates();
+	void	appendWrites(vector<VkWriteDescriptorSet>& descriptorWrites, VkDescriptorSet set,
+						 const vector<VkDescriptorType>& types, const vector<DescriptorInfo>& infos);
+
+		// getters
+public:
+	bool	usesTemplates()			{ return updateWithTemplate != nullptr;	  }
+	bool	usesPushDescriptors()	{ return cmdPushDescriptorSet != nullptr; }
+};
+
+#endif	// DescriptorWriter_h
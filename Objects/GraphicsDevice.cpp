@@ -18,6 +18,7 @@
 #include "VulkanConfigure.h"
 #include "RenderSettings.h"
 #include "ResourceTracker.h"
+#include <algorithm>
 
 
 GraphicsDevice::GraphicsDevice(WindowSurface& surface, VulkanInstance& instance,
@@ -32,11 +33,18 @@ GraphicsDevice::GraphicsDevice(WindowSurface& surface, VulkanInstance& instance,
 	// Now-selected physicalDevice may not have correct Indices set, so make sure:
 	queueFamilies.DetermineFamilyIndex(physicalDevice, vkSurface);
 
+	assessBindlessSupport(instance.getVkInstance());
+	assessSynchronization2Support(instance.getVkInstance());
+
 	createLogicalDevice(validation);
 }
 
 GraphicsDevice::~GraphicsDevice()
 {
+	bindless.Destroy();
+	descriptorWriter.Destroy();
+	descriptorAllocator.Destroy();
+	pipelineCache.Destroy();
 	vkDestroyDevice(logicalDevice, nullALLOC);
 
 	Log(DEAD, "Destroyed: GraphicsDevice");
@@ -44,6 +52,10 @@ GraphicsDevice::~GraphicsDevice()
 
 void GraphicsDevice::DestroyLogicalDevice()
 {
+	bindless.Destroy();
+	descriptorWriter.Destroy();
+	descriptorAllocator.Destroy();
+	pipelineCache.Destroy();
 	vkDestroyDevice(logicalDevice, nullALLOC);
 	logicalDevice = VK_NULL_HANDLE;
 }
@@ -86,15 +98,46 @@ void GraphicsDevice::createLogicalDevice(ValidationLayers& validation)
 																					//	texture quality at oblique angles.
 	queueFamilies.InitializeQueueCreateInfos();
 
+	VkPhysicalDeviceFeatures supported;
+	vkGetPhysicalDeviceFeatures(physicalDevice, &supported);
+
 	VkPhysicalDeviceFeatures deviceFeatures = {	// Notes on requesting device-level features:
+		.drawIndirectFirstInstance = supported.drawIndirectFirstInstance,	// (HiZCulling's draw commands, see Renderable)
 		.samplerAnisotropy	= useAnisotropic,	// If any textures want anisotropic filtering, then it must be enabled at the
 												//	device level too (thus affect all objects on-screen equally, so expect that).
+		.textureCompressionETC2		= supported.textureCompressionETC2,		// Whichever block-compressed formats the device
+		.textureCompressionASTC_LDR	= supported.textureCompressionASTC_LDR,	//	has, for TextureContainer's KTX2 and DDS files
+		.textureCompressionBC		= supported.textureCompressionBC,		//	(IsImageFormatSupported reports the rest).
+		.shaderStorageImageWriteWithoutFormat = supported.shaderStorageImageWriteWithoutFormat,	// (MipmapGenerator's downsampler)
 		//	.fillModeNonSolid	= VK_TRUE		// This renders EVERYTHING on-screen as wireframe, which may be better done per-object at
 	};											//	pipeline level via .polygonMode = VK_POLYGON_MODE_LINE (search: Customizer.WIREFRAME).
 
+	canWriteStorageWithoutFormat = supported.shaderStorageImageWriteWithoutFormat;
+	canDrawIndirectFirstInstance = supported.drawIndirectFirstInstance;
+
+	VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR,
+		.pNext = NULL,
+		.synchronization2 = VK_TRUE
+	};
+	void* pMoreFeatures = isSynchronization2Supported ? &synchronization2Features : NULL;
+
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+		.pNext = pMoreFeatures,
+		.shaderSampledImageArrayNonUniformIndexing	= VK_TRUE,	// Only those BindlessDescriptors uses.
+		.shaderStorageBufferArrayNonUniformIndexing	= VK_TRUE,
+		.descriptorBindingSampledImageUpdateAfterBind	= VK_TRUE,
+		.descriptorBindingStorageBufferUpdateAfterBind	= VK_TRUE,
+		.descriptorBindingUpdateUnusedWhilePending		= VK_TRUE,
+		.descriptorBindingPartiallyBound				= VK_TRUE,
+		.runtimeDescriptorArray							= VK_TRUE
+	};
+	bool useBindless = isBindlessSupported && RenderSettings.useBindless;
+
 	VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeaturesKHR = {
 		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PORTABILITY_SUBSET_FEATURES_KHR,
-		.pNext = NULL,							// Link to the next structure in the chain, or NULL if this is the last one.
+		.pNext = useBindless ? &indexingFeatures : pMoreFeatures,	// Link to the next structure in the chain, or NULL if this is the last one.
 		.events = VK_TRUE						// Enable the events feature, for EventObjects vkCreateEvent (+ nix validation error).
 	};
 
@@ -121,6 +164,114 @@ void GraphicsDevice::createLogicalDevice(ValidationLayers& validation)
 		Fatal("Create Logical Device FAILURE" + ErrStr(call));
 
 	queueFamilies.GatherQueueHandlesFor(logicalDevice);
+
+	pipelineCache.Create(logicalDevice, selected.properties);
+	descriptorAllocator.Create(logicalDevice);
+	descriptorWriter.Create(logicalDevice, isExtensionSelected(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME),
+										   isExtensionSelected(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME));
+	if (useBindless)
+		bindless.Create(logicalDevice, maxBindlessImages, maxBindlessBuffers);
+}
+
+// Bindless descriptors (see BindlessDescriptors.h) need VK_EXT_descriptor_indexing, and of its features,
+//	every one enabled above; query them (and the array sizes allowed) via the "2" variants of the queries,
+//	which at Vulkan 1.0 come from VK_KHR_get_physical_device_properties2, so by way of the instance.
+//
+void GraphicsDevice::assessBindlessSupport(VkInstance instance)
+{
+	if (! isExtensionSelected(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)
+	 || ! isExtensionSelected(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
+		return;
+
+	auto getFeatures2	= (PFN_vkGetPhysicalDeviceFeatures2KHR)
+							vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR");
+	auto getProperties2	= (PFN_vkGetPhysicalDeviceProperties2KHR)
+							vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR");
+	if (! getFeatures2 || ! getProperties2)
+		return;
+
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexing = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT
+	};
+	VkPhysicalDeviceFeatures2KHR features = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+		.pNext = &indexing
+	};
+	getFeatures2(physicalDevice, &features);
+
+	isBindlessSupported = indexing.shaderSampledImageArrayNonUniformIndexing
+					   && indexing.shaderStorageBufferArrayNonUniformIndexing
+					   && indexing.descriptorBindingSampledImageUpdateAfterBind
+					   && indexing.descriptorBindingStorageBufferUpdateAfterBind
+					   && indexing.descriptorBindingUpdateUnusedWhilePending
+					   && indexing.descriptorBindingPartiallyBound
+					   && indexing.runtimeDescriptorArray;
+	if (! isBindlessSupported) {
+		Log(WARN, "Descriptor indexing lacks features for bindless; renderables customized BINDLESS bind per draw.");
+		return;
+	}
+
+	VkPhysicalDeviceDescriptorIndexingPropertiesEXT limits = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT
+	};
+	VkPhysicalDeviceProperties2KHR properties = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR,
+		.pNext = &limits
+	};
+	getProperties2(physicalDevice, &properties);
+
+	// Its images are combined image samplers, so count as samplers too; and images plus buffers, all
+	//	visible to the same stages, count against the per-stage total of resources.
+	maxBindlessImages  = std::min({ limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+									limits.maxDescriptorSetUpdateAfterBindSampledImages,
+									limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+									limits.maxDescriptorSetUpdateAfterBindSamplers,
+									BindlessDescriptors::MAX_IMAGES });
+	maxBindlessBuffers = std::min({ limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+									limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+									BindlessDescriptors::MAX_BUFFERS });
+
+	uint32_t maxResources = limits.maxPerStageUpdateAfterBindResources;
+	if ((uint64_t) maxBindlessImages + maxBindlessBuffers > maxResources) {	// (share it as MAX_ would)
+		uint64_t maxShare = (uint64_t) maxResources * BindlessDescriptors::MAX_BUFFERS
+						  / (BindlessDescriptors::MAX_IMAGES + BindlessDescriptors::MAX_BUFFERS);
+		maxBindlessBuffers = std::min(maxBindlessBuffers, (uint32_t) maxShare);
+		maxBindlessImages  = std::min(maxBindlessImages, maxResources - maxBindlessBuffers);
+	}
+}
+
+// VK_KHR_synchronization2 (core in Vulkan 1.3) lets barriers each carry their own stages, so that
+//	MipmapGenerator batches unlike transitions into one vkCmdPipelineBarrier2KHR.  Its feature must be
+//	both supported and enabled.
+//
+void GraphicsDevice::assessSynchronization2Support(VkInstance instance)
+{
+	if (! isExtensionSelected(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME))
+		return;
+
+	auto getFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2KHR)
+						 vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR");
+	if (! getFeatures2)
+		return;
+
+	VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2 = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR
+	};
+	VkPhysicalDeviceFeatures2KHR features = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+		.pNext = &synchronization2
+	};
+	getFeatures2(physicalDevice, &features);
+
+	isSynchronization2Supported = synchronization2.synchronization2 == VK_TRUE;
+}
+
+bool GraphicsDevice::isExtensionSelected(StrPtr extensionName)
+{
+	for (StrPtr selectedName : selected.extensionNames)
+		if (strcmp(selectedName, extensionName) == 0)
+			return true;
+	return false;
 }
 
 
@@ -23,6 +23,10 @@
 #include "WindowSurface.h"
 #include "DeviceQueues.h"
 #include "DeviceAssessment.h"
+#include "PipelineCache.h"
+#include "DescriptorAllocator.h"
+#include "BindlessDescriptors.h"
+#include "DescriptorWriter.h"
 
 
 class GraphicsDevice
@@ -45,6 +49,18 @@ private:
 
 	DeviceQueues		queueFamilies;
 
+	PipelineCache		pipelineCache;		// (lives and dies with logicalDevice)
+	DescriptorAllocator	descriptorAllocator;	// (likewise)
+	DescriptorWriter	descriptorWriter;		// (likewise)
+	BindlessDescriptors	bindless;				// (likewise, if supported and enabled)
+
+	bool				isBindlessSupported = false;	// (descriptor indexing features, see assessBindlessSupport)
+	uint32_t			maxBindlessImages	= 0,
+						maxBindlessBuffers	= 0;
+	bool				isSynchronization2Supported	 = false;	// (see assessSynchronization2Support)
+	bool				canWriteStorageWithoutFormat = false;	// (shaderStorageImageWriteWithoutFormat)
+	bool				canDrawIndirectFirstInstance = false;	// (drawIndirectFirstInstance)
+
 		// METHODS
 public:
 	// Two-phase device-loss recovery (sleep/wake): DestroyLogicalDevice() at WillSleep while the
@@ -54,6 +70,9 @@ public:
 
 private:
 	void determineDeviceExtensionSupport(VkPhysicalDevice* devices, int nDevices, DeviceAssessment& assays);
+	void assessBindlessSupport(VkInstance instance);
+	void assessSynchronization2Support(VkInstance instance);
+	bool isExtensionSelected(StrPtr extensionName);
 
 	VkPhysicalDevice selectGPU(VkInstance& instance, VkSurfaceKHR& surface,
 							   DeviceSelectionMethod choice = DEVICE_SELECTION_MODE);
@@ -76,6 +95,13 @@ public:
 	VkPhysicalDevice&	getGPU()		{ return physicalDevice;	  }
 	VkDevice&			getLogical()	{ return logicalDevice;		  }
 	DeviceProfile&		getProfile()	{ return selected;			  }
+	PipelineCache&		getPipelineCache()	{ return pipelineCache;	  }
+	DescriptorAllocator& getDescriptorAllocator()	{ return descriptorAllocator; }
+	DescriptorWriter&	getDescriptorWriter()	{ return descriptorWriter;	  }
+	BindlessDescriptors& getBindless()	{ return bindless;		  }
+	bool	hasSynchronization2()			{ return isSynchronization2Supported;  }
+	bool	writesStorageWithoutFormat()	{ return canWriteStorageWithoutFormat; }
+	bool	drawsIndirectFirstInstance()	{ return canDrawIndirectFirstInstance; }
 };
 
 #endif // DeviceAbstract_h
@@ -8,20 +8,31 @@
 //	© 0000 (uncopyrighted; use at will)
 //
 #include "GraphicsPipeline.h"
+#include "PipelineLibrary.h"
+#include "LayoutCache.h"
+#include "InstanceTypes.h"
+#include "Helpers.h"
+#include "ResourceTracker.h"
+#include <thread>
+#include <atomic>
+#include <unordered_set>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 
-GraphicsPipeline::GraphicsPipeline(ShaderModules& shaders, iRenderPass& renderPass,
-								   Swapchain& swapchain, GraphicsDevice& graphics,
-								   VertexAbstract* pVertex, Descriptors* pDescriptors,
-								   Customizer customize, VkExtent2D customExtent)
-	:	device(graphics.getLogical())
+GraphicsPipeline::GraphicsPipeline(ShaderModules& shaders, iRenderPass& renderPass, GraphicsDevice& graphics,
+								   VertexAbstract* pVertex, Descriptors* pDescriptors, Customizer customize,
+								   const SpecializationConstants* pSpecialization)
+	:	pipelineLayout(VK_NULL_HANDLE),
+		graphicsPipeline(VK_NULL_HANDLE),
+		device(graphics.getLogical()),
+		pipelineCache(graphics.getPipelineCache().getVkPipelineCache())
 {
 	pVertex->vetIsValid();
 
-	// Use custom extent if provided (width != 0), otherwise use swapchain's own extent.
-	VkExtent2D extent = (customExtent.width != 0) ? customExtent : swapchain.getExtent();
-
-	create(shaders, pVertex, extent, renderPass, pDescriptors, customize);
+	create(shaders, pVertex, renderPass, pDescriptors, customize, pSpecialization);
 }
 
 GraphicsPipeline::~GraphicsPipeline()
@@ -30,24 +41,181 @@ GraphicsPipeline::~GraphicsPipeline()
 }
 void GraphicsPipeline::destroy()
 {
-	vkDestroyPipeline(device, graphicsPipeline, nullALLOC);
-	vkDestroyPipelineLayout(device, pipelineLayout, nullALLOC);
-	Log(DEAD, "Destroyed: GraphicsPipeline (+ PipelineLayout)");
+	if (isFallback)
+		UnregisterFallback(*this);
+
+	if (isPending) {						// (never built: simply forget it)
+		std::erase(pendingBuilds, this);
+		isPending = false;
+	} else if (isCompiling) {				// (not yet the library's: finish, then destroy it ourself)
+		std::erase(compilingPipelines, this);
+		isCompiling = false;
+		asyncCompile.wait();
+		vkDestroyPipeline(device, compiled, nullALLOC);
+		LayoutCache::ReleasePipelineLayout(pipelineLayout);
+		compiled = VK_NULL_HANDLE;
+	} else
+		PipelineLibrary::Release(graphicsPipeline);		// (destroying pipeline and layout, if last to use them)
+
+	graphicsPipeline = VK_NULL_HANDLE;
+	pipelineLayout	 = VK_NULL_HANDLE;
+}
+
+
+bool					  GraphicsPipeline::isBuildPhase = false;
+vector<GraphicsPipeline*> GraphicsPipeline::pendingBuilds;
+bool					  GraphicsPipeline::compileAsync = true;
+vector<GraphicsPipeline*> GraphicsPipeline::compilingPipelines;
+std::unordered_map<uint64_t, GraphicsPipeline*>	GraphicsPipeline::fallbacks;
+
+template<typename T>
+static void appendBytes(string& bytes, const T* pValues, size_t nValues)	// (count-prefixed, so unambiguous)
+{
+	bytes.append((const char*) &nValues, sizeof(nValues));
+	bytes.append((const char*) pValues, nValues * sizeof(T));
+}
+
+// Gather all that goes into creating the pipeline, so that build() needs nothing else (and no shared
+//	object's mutable state, so that many may run at once), then build it now or later.
+//
+void GraphicsPipeline::create(ShaderModules& shaderModules, VertexAbstract* pVertex, iRenderPass& renderPass,
+							  Descriptors* pDescriptors, Customizer customize,
+							  const SpecializationConstants* pSpecialization)
+{
+	vector<VkVertexInputBindingDescription>&   bindings	  = state.bindings;
+	vector<VkVertexInputAttributeDescription>& attributes = state.attributes;
+	bindings.clear();
+	attributes.clear();
+	if (pVertex) {
+		bindings.assign(pVertex->pBindingDescriptions(),
+						pVertex->pBindingDescriptions() + pVertex->nBindingDescriptions());
+		attributes.assign(pVertex->pAttributeDescriptions(),
+						  pVertex->pAttributeDescriptions() + pVertex->nAttributeDescriptions());
+	}
+	if ((customize & AUTO_INSTANCE) && ! (pVertex && pVertex->instanceByteSize()))
+		appendInstanceTransform(bindings, attributes);
+
+	// Identify this pipeline by all that goes into creating it, then share it if it already exists.
+	//	(Everything but `customize` and specialization constants identifies its "family," from which
+	//	variants derive; and of that, all but shaders what it's compatible with, i.e. could stand in
+	//	for it, as a fallback.)
+	uint64_t compatKey = hashBytes(bindings.data(), bindings.size() * sizeof(bindings[0]));
+	hashCombine(compatKey, hashBytes(attributes.data(), attributes.size() * sizeof(attributes[0])));
+	hashCombine(compatKey, (uint64_t) renderPass.getVkRenderPass());
+	hashCombine(compatKey, pDescriptors ? pDescriptors->LayoutKey() : ~0ull);
+	uint64_t familyKey = compatKey;
+	hashCombine(familyKey, shaderModules.Identity());
+	uint64_t key = familyKey;
+	hashCombine(key, (uint64_t) customize);
+	hashCombine(key, pSpecialization ? pSpecialization->Key() : 0);
+	state.compatKey = compatKey;
+
+	VkPipelineShaderStageCreateInfo* pStages = shaderModules.ShaderStages();
+	state.stages.assign(pStages, pStages + shaderModules.NumShaderStages());
+	specializeStages(pSpecialization);
+	state.renderPass		 = renderPass.getVkRenderPass();
+	state.hasColorAttachment = renderPass.hasColorAttachment();
+	state.isDepthBufferUsed	 = renderPass.isDepthBufferUsed();
+	state.setLayouts		 = pDescriptors ? pDescriptors->SetLayouts() : vector<VkDescriptorSetLayout>();
+	state.customize			 = customize;
+	state.key				 = key;
+	state.familyKey			 = familyKey;
+	define(shaderModules);
+
+	if (PipelineLibrary::Acquire(key, state.definition, graphicsPipeline, pipelineLayout))
+		return;
+
+	if (isBuildPhase) {
+		pendingBuilds.push_back(this);
+		isPending = true;
+	} else if (compileAsync)
+		startCompiling();
+	else
+		build();
+}
+
+// The same state as the keys hash, but as bytes (layouts, render pass and shader modules by handle or
+//	serial, each unique to its definition), so that PipelineLibrary, or a fallback, matches exactly.
+//
+void GraphicsPipeline::define(ShaderModules& shaderModules)
+{
+	string& compat = state.compatDefinition;
+	compat.clear();
+	appendBytes(compat, state.bindings.data(), state.bindings.size());
+	appendBytes(compat, state.attributes.data(), state.attributes.size());
+	appendBytes(compat, &state.renderPass, 1);
+	appendBytes(compat, state.setLayouts.data(), state.setLayouts.size());
+
+	string& definition = state.definition;
+	definition = compat;
+	appendBytes(definition, shaderModules.Definition().data(), shaderModules.Definition().size());
+	appendBytes(definition, &state.customize, 1);
+	for (BuildState::Specialization& specialization : state.specializations) {
+		appendBytes(definition, specialization.entries.data(), specialization.entries.size());
+		appendBytes(definition, specialization.data.data(), specialization.data.size());
+	}
+}
+
+// Point each stage specialized at its own copy of its constants, kept in `state`, as build() may be later.
+//	(ShaderModules, shared by pipelines specialized differently, leaves pSpecializationInfo null.)
+//
+void GraphicsPipeline::specializeStages(const SpecializationConstants* pSpecialization)
+{
+	state.specializations.resize(state.stages.size());
+
+	for (size_t iStage = 0; iStage < state.stages.size(); ++iStage) {
+		BuildState::Specialization& specialization = state.specializations[iStage];
+		specialization.entries.clear();
+		specialization.data.clear();
+		if (pSpecialization)
+			pSpecialization->Gather(state.stages[iStage].stage, specialization.entries, specialization.data);
+		if (specialization.entries.empty())
+			continue;
+
+		specialization.info = {
+			.mapEntryCount	= (uint32_t) specialization.entries.size(),
+			.pMapEntries	= specialization.entries.data(),
+			.dataSize		= specialization.data.size() * sizeof(uint32_t),
+			.pData			= specialization.data.data()
+		};
+		state.stages[iStage].pSpecializationInfo = &specialization.info;
+	}
 }
 
+// Create the pipeline and its layout, now, and hand them to PipelineLibrary.
+//
+void GraphicsPipeline::build()
+{
+	createLayout();
+	compile(graphicsPipeline, PipelineLibrary::FamilyBase(state.familyKey));
+	PipelineLibrary::Add(state.key, state.definition, state.familyKey, device, graphicsPipeline, pipelineLayout);
+}
 
-void GraphicsPipeline::create(ShaderModules& shaderModules, VertexAbstract* pVertex,
-							  VkExtent2D swapchainExtent, iRenderPass& renderPass,
-							  Descriptors* pDescriptors, Customizer customize)
+// Shared with every other pipeline of the same descriptor set layouts (see LayoutCache).  There may be
+//	several sets, e.g. the bindless one, or those split by frequency (see Descriptors).
+//
+void GraphicsPipeline::createLayout()
 {
+	pipelineLayout = LayoutCache::AcquirePipelineLayout(device, state.setLayouts);
+}
+
+// Create the VkPipeline from `state` and pipelineLayout.  Safe to call from multiple threads at once,
+//	each for its own GraphicsPipeline: the pipeline cache is internally synchronized, results are local.
+//
+void GraphicsPipeline::compile(VkPipeline& pipeline, VkPipeline basePipeline)
+{
+	vector<VkVertexInputBindingDescription>&   bindings	  = state.bindings;
+	vector<VkVertexInputAttributeDescription>& attributes = state.attributes;
+	Customizer customize = state.customize;
+
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
 		.sType	= VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
 		.pNext	= nullptr,
 		.flags	= 0,
-		.vertexBindingDescriptionCount	 = pVertex ? pVertex->nBindingDescriptions()   : 0,
-		.pVertexBindingDescriptions		 = pVertex ? pVertex->pBindingDescriptions()   : nullptr,
-		.vertexAttributeDescriptionCount = pVertex ? pVertex->nAttributeDescriptions() : 0,
-		.pVertexAttributeDescriptions	 = pVertex ? pVertex->pAttributeDescriptions() : nullptr
+		.vertexBindingDescriptionCount	 = (uint32_t) bindings.size(),
+		.pVertexBindingDescriptions		 = bindings.empty()	  ? nullptr : bindings.data(),
+		.vertexAttributeDescriptionCount = (uint32_t) attributes.size(),
+		.pVertexAttributeDescriptions	 = attributes.empty() ? nullptr : attributes.data()
 	};
 
 	VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
@@ -61,26 +229,24 @@ void GraphicsPipeline::create(ShaderModules& shaderModules, VertexAbstract* pVer
 		.primitiveRestartEnable = VK_FALSE
 	};
 
-	VkViewport viewport = {
-		.x	= 0.0f,
-		.y	= 0.0f,
-		.width	= (float) swapchainExtent.width,
-		.height	= (float) swapchainExtent.height,
-		.minDepth = 0.0f,
-		.maxDepth = 1.0f
-	};
-	VkRect2D scissor = {
-		.offset = { 0, 0 },
-		.extent = swapchainExtent
-	};
 	VkPipelineViewportStateCreateInfo viewportState = {
 		.sType	= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
 		.pNext	= nullptr,
 		.flags	= 0,
 		.viewportCount	= 1,
-		.pViewports		= &viewport,
+		.pViewports		= nullptr,		// (dynamic: see CmdSetViewportAndScissor)
 		.scissorCount	= 1,
-		.pScissors		= &scissor
+		.pScissors		= nullptr
+	};
+
+	VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+	VkPipelineDynamicStateCreateInfo dynamicState = {
+		.sType	= VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.dynamicStateCount	= N_ELEMENTS_IN_ARRAY(dynamicStates),
+		.pDynamicStates		= dynamicStates
 	};
 
 	// Simplest way to INVERT_Z is VK_FRONT_FACE_CLOCKWISE, since Vulkan is COUNTER_CLOCKWISE.
@@ -142,8 +308,8 @@ void GraphicsPipeline::create(ShaderModules& shaderModules, VertexAbstract* pVer
 		.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
 		.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
 		.alphaBlendOp		 = VK_BLEND_OP_ADD,
-		.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-						| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT
+		.colorWriteMask = (VkFlags) (customize & DISABLE_COLOR_WRITE ? 0 : VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+												| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT)
 	};
 	VkPipelineColorBlendStateCreateInfo colorBlending = {
 		.sType	= VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
@@ -151,59 +317,309 @@ void GraphicsPipeline::create(ShaderModules& shaderModules, VertexAbstract* pVer
 		.flags	= 0,
 		.logicOpEnable		= VK_FALSE,
 		.logicOp			= VK_LOGIC_OP_COPY,
-		.attachmentCount	= static_cast<uint32_t>(renderPass.hasColorAttachment() ? 1 : 0),
-		.pAttachments		= renderPass.hasColorAttachment() ? &colorBlendAttachment : nullptr,
+		.attachmentCount	= static_cast<uint32_t>(state.hasColorAttachment ? 1 : 0),
+		.pAttachments		= state.hasColorAttachment ? &colorBlendAttachment : nullptr,
 		.blendConstants		= { 0.0f, 0.0f, 0.0f, 0.0f }
 	};
 
-	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
-		.sType	= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-		.pNext	= nullptr,
-		.flags	= 0,
-		.setLayoutCount	= pDescriptors ? (uint32_t) 1 : 0,
-		.pSetLayouts	= pDescriptors ? pDescriptors->getpLayout() : nullptr,
-		/*.pushConstantRangeCount = 0,		// can pass values into shader
-		.pPushConstantRanges	= nullptr*/
-	};
-
-	call = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullALLOC, &pipelineLayout);
-
-	if (call != VK_SUCCESS)
-		Fatal("Create Pipeline Layout FAILURE" + ErrStr(call));
 
 	VkGraphicsPipelineCreateInfo pipelineInfo = {
 		.sType	= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
 		.pNext	= nullptr,
-		.flags	= 0,
-		.stageCount			 = shaderModules.NumShaderStages(),
-		.pStages			 = shaderModules.ShaderStages(),
+		.flags	= (VkPipelineCreateFlags) (VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT
+					| (basePipeline != VK_NULL_HANDLE ? VK_PIPELINE_CREATE_DERIVATIVE_BIT : 0)),
+		.stageCount			 = (uint32_t) state.stages.size(),
+		.pStages			 = state.stages.data(),
 		.pVertexInputState	 = &vertexInputInfo,
 		.pInputAssemblyState = &inputAssembly,
 		.pTessellationState	 = nullptr,
 		.pViewportState		 = &viewportState,
 		.pRasterizationState = &rasterizer,
 		.pMultisampleState	 = &multisampling,
-		.pDepthStencilState	 = renderPass.isDepthBufferUsed() ? &depthStencil : nullptr,
+		.pDepthStencilState	 = state.isDepthBufferUsed ? &depthStencil : nullptr,
 		.pColorBlendState	 = &colorBlending,
-		.pDynamicState		 = nullptr,
+		.pDynamicState		 = &dynamicState,
 		.layout				 = pipelineLayout,
-		.renderPass			 = renderPass.getVkRenderPass(),
+		.renderPass			 = state.renderPass,
 		.subpass			 = 0,
-		.basePipelineHandle	 = VK_NULL_HANDLE,
+		.basePipelineHandle	 = basePipeline,
 		.basePipelineIndex	 = -1
 	};
 
-	call = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, // number of pipelines
-									 &pipelineInfo, nullALLOC, &graphicsPipeline);
-	if (call != VK_SUCCESS)
-		Fatal("FAIL on Create Graphics Pipeline" + ErrStr(call));
+	VkResult result = vkCreateGraphicsPipelines(device, pipelineCache, 1, // number of pipelines
+												&pipelineInfo, nullALLOC, &pipeline);
+	if (result != VK_SUCCESS)
+		Fatal("FAIL on Create Graphics Pipeline" + ErrStr(result));
 }
 
-void GraphicsPipeline::Recreate(ShaderModules& shaders, iRenderPass& renderPass, Swapchain& swapchain,
-								VertexAbstract* pVertex, Descriptors* pDescriptors, Customizer customize)
+// Pipelines customized for AUTO_INSTANCE (unless their vertex type describes its own instance data)
+//	receive each instance's model matrix at INSTANCE_BINDING, located after the vertex's attributes:
+//		layout(location = N) in mat4 instanceModel;		// N == number of vertex attributes
+//
+void GraphicsPipeline::appendInstanceTransform(vector<VkVertexInputBindingDescription>& bindings,
+											   vector<VkVertexInputAttributeDescription>& attributes)
 {
+	uint32_t location = 0;
+	for (VkVertexInputAttributeDescription& attribute : attributes)
+		if (attribute.location >= location)
+			location = attribute.location + 1;
+
+	const InstanceAttribute* layout = InstanceTransform::layout;
+	const int nAttrs = N_ELEMENTS_IN_ARRAY(InstanceTransform::layout);
+
+	size_t iFirst = attributes.size();
+	attributes.resize(iFirst + numLocationsGivenInstanceAttributes(layout, nAttrs));
+	uint32_t stride = describeInstanceAttributes(layout, nAttrs, location, &attributes[iFirst]);
+	bindings.push_back(describeInstanceBinding(stride));
+}
+
+void GraphicsPipeline::Recreate(ShaderModules& shaders, iRenderPass& renderPass,
+								VertexAbstract* pVertex, Descriptors* pDescriptors, Customizer customize,
+								const SpecializationConstants* pSpecialization)
+{
+	bool wasFallback = isFallback;
 	destroy();
-	create(shaders, pVertex, swapchain.getExtent(), renderPass, pDescriptors, customize);
+	create(shaders, pVertex, renderPass, pDescriptors, customize, pSpecialization);
+	if (wasFallback)
+		RegisterFallback(*this);
+}
+
+
+// Build now, if deferred or compiling, for immediate use (e.g. by a secondary command buffer recorded
+//	at once, which would otherwise have to be recorded again once the real pipeline replaced a fallback).
+//
+void GraphicsPipeline::EnsureBuilt()
+{
+	if (isCompiling) {
+		std::erase(compilingPipelines, this);
+		finishCompiling();
+	}
+	if (! isPending)
+		return;
+
+	std::erase(pendingBuilds, this);
+	isPending = false;
+	if (! PipelineLibrary::Acquire(state.key, state.definition, graphicsPipeline, pipelineLayout))
+		build();
+}
+
+
+#pragma mark - Asynchronous
+
+// Background compiles queue for a fixed few threads, started on first use, rather than each taking a
+//	thread of its own.  A compile that fails (Fatal) leaves its exception in the future it returned.
+//
+static struct CompileWorkers {
+	static constexpr unsigned	MAX_THREADS = 2;	// (leaving cores for drawing and texture decoding)
+
+	std::deque<std::packaged_task<void()>>	queue;
+	vector<std::thread>			threads;
+	std::mutex					mutex;
+	std::condition_variable		queued;
+	bool						isStopping = false;
+
+	std::future<void> Enqueue(std::packaged_task<void()>&& task)
+	{
+		std::future<void> future = task.get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (threads.empty()) {
+				unsigned nThreads = std::min(MAX_THREADS, std::max(1u, std::thread::hardware_concurrency()));
+				for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+					threads.emplace_back([this] { work(); });
+			}
+			queue.push_back(std::move(task));
+		}
+		queued.notify_one();
+		return future;
+	}
+
+	void work()
+	{
+		for (;;) {
+			std::packaged_task<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				queued.wait(lock, [this] { return isStopping || ! queue.empty(); });
+				if (queue.empty())
+					return;
+				task = std::move(queue.front());
+				queue.pop_front();
+			}
+			task();
+		}
+	}
+
+	~CompileWorkers()		// (after every pipeline is gone, its compile awaited; so just drain, then join)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isStopping = true;
+		}
+		queued.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+} compileWorkers;
+
+// Compile in the background, meanwhile drawing with the fallback registered for compatible pipelines,
+//	if any, else not at all (see IsDrawable).  The layout is created now, so that descriptor sets bind
+//	to it either way.  (No derivative is made, as its base could be released while compiling.)
+//
+void GraphicsPipeline::startCompiling()
+{
+	createLayout();
+
+	auto found = fallbacks.find(state.compatKey);
+	bool isCompatible = found != fallbacks.end() && found->second->state.compatDefinition == state.compatDefinition;
+	graphicsPipeline = isCompatible ? found->second->graphicsPipeline : VK_NULL_HANDLE;
+
+	compiled = VK_NULL_HANDLE;
+	isCompiling = true;
+	compilingPipelines.push_back(this);
+	asyncCompile = compileWorkers.Enqueue(std::packaged_task<void()>([this]() { compile(compiled, VK_NULL_HANDLE); }));
+}
+
+// Swap in the compiled pipeline, waiting for it if need be.  (Caller has removed it from compilingPipelines.)
+//	If compiling failed, rethrow that here on the main thread, left with neither pipeline nor layout.
+//
+void GraphicsPipeline::finishCompiling()
+{
+	isCompiling = false;
+	try {
+		asyncCompile.get();
+	} catch (...) {
+		LayoutCache::ReleasePipelineLayout(pipelineLayout);
+		graphicsPipeline = VK_NULL_HANDLE;
+		pipelineLayout	 = VK_NULL_HANDLE;
+		throw;
+	}
+
+	graphicsPipeline = compiled;
+	compiled = VK_NULL_HANDLE;
+	PipelineLibrary::Add(state.key, state.definition, state.familyKey, device, graphicsPipeline, pipelineLayout);
+}
+
+// Call at a frame boundary, before recording: every pipeline finished compiling replaces its fallback
+//	(or starts drawing) from the next frame on, never partway through one.  Returns true if any did.
+//
+bool GraphicsPipeline::CollectCompiled()
+{
+	bool anyReplaced = false;
+
+	for (size_t iCompiling = 0; iCompiling < compilingPipelines.size(); ) {
+		GraphicsPipeline* pPipeline = compilingPipelines[iCompiling];
+		if (pPipeline->asyncCompile.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++iCompiling;
+			continue;
+		}
+		compilingPipelines.erase(compilingPipelines.begin() + iCompiling);
+		pPipeline->finishCompiling();
+		anyReplaced = true;
+	}
+	return anyReplaced;
+}
+
+// Stand in for any compiling pipeline with the same vertex input, render pass and descriptor set layout
+//	(hence pipeline layout); typically simple shaders, e.g. flat gray.  Built at once, if not already.
+//
+void GraphicsPipeline::RegisterFallback(GraphicsPipeline& fallback)
+{
+	fallback.EnsureBuilt();
+	fallbacks[fallback.state.compatKey] = &fallback;
+	fallback.isFallback = true;
+}
+
+// Pipelines still compiling, that stood in this one, then draw nothing until done.
+//
+void GraphicsPipeline::UnregisterFallback(GraphicsPipeline& fallback)
+{
+	auto found = fallbacks.find(fallback.state.compatKey);
+	if (found != fallbacks.end() && found->second == &fallback)
+		fallbacks.erase(found);
+	fallback.isFallback = false;
+
+	for (GraphicsPipeline* pPipeline : compilingPipelines)
+		if (pPipeline->graphicsPipeline == fallback.graphicsPipeline)
+			pPipeline->graphicsPipeline = VK_NULL_HANDLE;
+}
+
+// Until BuildPending, defer creating pipelines (e.g. as renderables are constructed at startup or
+//	recreated) so that all may then be created at once, in parallel.
+//
+void GraphicsPipeline::BeginBuildPhase()
+{
+	isBuildPhase = true;
+}
+
+// Create every deferred pipeline, spread across worker threads (plus this one), and end the build phase.
+//	Pipelines sharing a key are built once: the first of each, after which the rest acquire it.  A build
+//	that fails (Fatal) on a worker is rethrown here, once all are joined, rather than terminating.
+//
+void GraphicsPipeline::BuildPending()
+{
+	isBuildPhase = false;
+	if (pendingBuilds.empty())
+		return;
+
+	vector<GraphicsPipeline*> builds, duplicates;
+	std::unordered_set<uint64_t> keys;
+	for (GraphicsPipeline* pPipeline : pendingBuilds) {
+		pPipeline->isPending = false;
+		if (keys.insert(pPipeline->state.key).second)
+			builds.push_back(pPipeline);
+		else
+			duplicates.push_back(pPipeline);
+	}
+	pendingBuilds.clear();
+
+	size_t nThreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), builds.size());
+	vector<std::exception_ptr> errors(nThreads);		// (one per thread)
+	std::atomic<size_t> iNext = 0;
+	auto buildNext = [&](size_t iThread) {
+		try {
+			for (size_t iBuild; (iBuild = iNext++) < builds.size(); )
+				builds[iBuild]->build();
+		} catch (...) {
+			errors[iThread] = std::current_exception();
+			iNext = builds.size();		// (stop the others too)
+		}
+	};
+	vector<std::thread> workers;
+	for (size_t iThread = 1; iThread < nThreads; ++iThread)
+		workers.emplace_back(buildNext, iThread);
+	buildNext(0);
+	for (std::thread& worker : workers)
+		worker.join();
+	for (std::exception_ptr& error : errors)
+		if (error)
+			std::rethrow_exception(error);
+
+	for (GraphicsPipeline* pPipeline : duplicates)
+		if (! PipelineLibrary::Acquire(pPipeline->state.key, pPipeline->state.definition,
+									   pPipeline->graphicsPipeline, pPipeline->pipelineLayout))
+			pPipeline->build();
+
+	Log(LOW, "Built %u pipelines (+%u shared) on %u threads.", (uint32_t) builds.size(),
+		(uint32_t) duplicates.size(), (uint32_t) nThreads);
+}
+
+void GraphicsPipeline::CmdSetViewportAndScissor(VkCommandBuffer& commandBuffer, VkExtent2D extent)
+{
+	VkViewport viewport = {
+		.x	= 0.0f,
+		.y	= 0.0f,
+		.width	= (float) extent.width,
+		.height	= (float) extent.height,
+		.minDepth = 0.0f,
+		.maxDepth = 1.0f
+	};
+	VkRect2D scissor = {
+		.offset = { 0, 0 },
+		.extent = extent
+	};
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 }
 
 
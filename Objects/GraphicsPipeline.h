@@ -3,6 +3,19 @@
 //	Vulkan Setup
 //
 // Encapsulate the Pipeline.
+//	Viewport and scissor are dynamic state, set per render pass (CmdSetViewportAndScissor), so a pipeline
+//	is independent of the size it draws at, and needn't be rebuilt when the window resizes.
+//
+// Creation may be deferred: between BeginBuildPhase and BuildPending, pipelines constructed or recreated
+//	only record their creation state, then BuildPending creates them all at once, across worker threads.
+//	CommandControl opens such a phase at startup and around recreating renderables, and closes it
+//	before recording command buffers, i.e. before any pipeline is first bound.
+//
+// Outside such a phase, e.g. a renderable added mid-session, creation is asynchronous (if compileAsync):
+//	the pipeline compiles on one of a few background threads (queued, if they're busy), and until
+//	CollectCompiled swaps it in, at a frame boundary, it is drawn with a registered fallback pipeline
+//	(RegisterFallback) compatible with it, or if there is none, not drawn at all (check IsDrawable).
+//	So streaming in new content never hitches.  A compile that fails is rethrown by CollectCompiled.
 //
 // 1/31/19 Tadd Jensen
 //	© 0000 (uncopyrighted; use at whim)
@@ -17,15 +30,18 @@
 #include "VertexAbstract.h"
 #include "Descriptors.h"
 #include "Customizer.h"
+#include "DrawPushConstants.h"
+#include "SpecializationConstants.h"
+#include <future>
+#include <unordered_map>
 
 
 class GraphicsPipeline
 {
 public:
-	GraphicsPipeline(ShaderModules& shaders, iRenderPass& renderPass,
-					 Swapchain& swapchain, GraphicsDevice& graphics,
+	GraphicsPipeline(ShaderModules& shaders, iRenderPass& renderPass, GraphicsDevice& graphics,
 					 VertexAbstract* pVertex = nullptr, Descriptors* pDescriptors = nullptr,
-					 Customizer customize = NONE, VkExtent2D customExtent = { 0, 0 });
+					 Customizer customize = NONE, const SpecializationConstants* pSpecialization = nullptr);
 
 	~GraphicsPipeline();
 
@@ -35,19 +51,76 @@ private:
 	VkPipeline		 graphicsPipeline;
 
 	VkDevice		 device;
+	VkPipelineCache& pipelineCache;
+
+	struct BuildState {		// All that build() needs, captured by create().
+		vector<VkPipelineShaderStageCreateInfo>	  stages;
+		struct Specialization {					// (per stage, if any: what its pSpecializationInfo points to)
+			vector<VkSpecializationMapEntry>	entries;
+			vector<uint32_t>					data;
+			VkSpecializationInfo				info;
+		};
+		vector<Specialization>	specializations;
+		vector<VkVertexInputBindingDescription>	  bindings;
+		vector<VkVertexInputAttributeDescription> attributes;
+		VkRenderPass			renderPass;
+		bool					hasColorAttachment;
+		bool					isDepthBufferUsed;
+		vector<VkDescriptorSetLayout>	setLayouts;	// (in set order; empty if no descriptors)
+		Customizer				customize;
+		uint64_t				key, familyKey;	// (see PipelineLibrary)
+		uint64_t				compatKey;		// (for finding a fallback)
+		string					definition;		// What key hashes, as bytes, to tell apart a collision;
+		string					compatDefinition;	//	likewise compatKey.
+	}	state;
+	bool	isPending = false;					// Awaiting BuildPending.
+
+	bool				isCompiling = false;	// Asynchronously, into:
+	VkPipeline			compiled	= VK_NULL_HANDLE;
+	std::future<void>	asyncCompile;
+	bool				isFallback	= false;
+
+	static bool						 isBuildPhase;
+	static vector<GraphicsPipeline*> pendingBuilds;
+	static vector<GraphicsPipeline*> compilingPipelines;
+	static std::unordered_map<uint64_t, GraphicsPipeline*>	fallbacks;	// by compatKey
+public:
+	static bool						 compileAsync;		// (or else, outside a build phase, create at once)
 
 		// METHODS
 private:
-	void create(ShaderModules& shaderModules, VertexAbstract* pVertex, VkExtent2D swapchainExtent,
-				iRenderPass& renderPass, Descriptors* pDescriptors, Customizer customize);
+	void create(ShaderModules& shaderModules, VertexAbstract* pVertex, iRenderPass& renderPass,
+				Descriptors* pDescriptors, Customizer customize, const SpecializationConstants* pSpecialization);
+	void specializeStages(const SpecializationConstants* pSpecialization);
+	void define(ShaderModules& shaderModules);
+	void build();
+	void createLayout();
+	void compile(VkPipeline& pipeline, VkPipeline basePipeline);
+	void startCompiling();
+	void finishCompiling();
 	void destroy();
+	void appendInstanceTransform(vector<VkVertexInputBindingDescription>& bindings,
+								 vector<VkVertexInputAttributeDescription>& attributes);
 public:
-	void Recreate(ShaderModules& shaderModules, iRenderPass& renderPass, Swapchain& swapchain,
+	void Recreate(ShaderModules& shaderModules, iRenderPass& renderPass,
 				  VertexAbstract* pVertex = nullptr, Descriptors* pDescriptors = nullptr,
-				  Customizer customize = NONE);
+				  Customizer customize = NONE, const SpecializationConstants* pSpecialization = nullptr);
+
+	static void BeginBuildPhase();
+	static void BuildPending();
+	void		EnsureBuilt();
+
+	static bool CollectCompiled();
+	static void RegisterFallback(GraphicsPipeline& fallback);
+	static void UnregisterFallback(GraphicsPipeline& fallback);
+
+	// Follow each vkCmdBeginRenderPass with this (or within a secondary command buffer, before its draws).
+	static void CmdSetViewportAndScissor(VkCommandBuffer& commandBuffer, VkExtent2D extent);
+
 		// getters
 	VkPipeline&  getVkPipeline()			{ return graphicsPipeline;	}
 	VkPipelineLayout&  getPipelineLayout()	{ return pipelineLayout;	}
+	bool		IsDrawable()	{ return graphicsPipeline != VK_NULL_HANDLE; }	// (its own, or a fallback)
 };
 
 #endif // GraphicsPipeline_h
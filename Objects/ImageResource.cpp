@@ -75,8 +75,12 @@ void ImageResource::createImageView(VkImageAspectFlags aspectFlags/* = VK_IMAGE_
 // Note that certain formats, e.g. produce: VK_ERROR_FORMAT_NOT_SUPPORTED: VkFormat VK_FORMAT_R8G8B8_UNORM is not supported on this platform.
 //
 void ImageResource::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling,
-								VkImageUsageFlags usage, VkMemoryPropertyFlags properties)
+								VkImageUsageFlags usage, VkMemoryPropertyFlags properties, uint32_t numLevels/* = 0*/)
 {
+	uint32_t mipLevels = ! pMipmaps ? 1
+					   : numLevels ? pMipmaps->SetNumberOfLevels(numLevels)
+					   : pMipmaps->CalculateNumberOfLevels(width, height);
+
 	VkImageCreateInfo imageInfo = {
 		.sType	= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
 		.pNext	= nullptr,
@@ -84,7 +88,7 @@ void ImageResource::createImage(uint32_t width, uint32_t height, VkFormat format
 		.imageType	 = VK_IMAGE_TYPE_2D,
 		.format		 = format,
 		.extent		 = { width, height, 1 /* = depth, must be 1 */ },
-		.mipLevels	 = pMipmaps ? pMipmaps->CalculateNumberOfLevels(width, height) : 1,
+		.mipLevels	 = mipLevels,
 		.arrayLayers = 1,
 		.samples	 = VK_SAMPLE_COUNT_1_BIT,
 		.tiling		 = tiling,
@@ -42,7 +42,8 @@ protected:
 	void destroy();
 	void createImageView(VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT);
 	void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling,
-					 VkImageUsageFlags usage, VkMemoryPropertyFlags properties);
+					 VkImageUsageFlags usage, VkMemoryPropertyFlags properties,
+					 uint32_t numLevels = 0);	// (0: all, if mipmapped, down to 1 x 1)
 		// getters
 public:
 	VkImage&	getImage()	{ return image;		}
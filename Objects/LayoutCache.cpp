@@ -0,0 +1,189 @@
+//
+// LayoutCache.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "LayoutCache.h"
+#include "DrawPushConstants.h"
+#include "Helpers.h"
+#include "ResourceTracker.h"
+
+
+std::unordered_multimap<uint64_t, LayoutCache::Entry<VkDescriptorSetLayout>>	LayoutCache::setLayouts;
+std::unordered_map<VkDescriptorSetLayout, uint64_t>							LayoutCache::setLayoutKeys;
+std::unordered_multimap<uint64_t, LayoutCache::Entry<VkPipelineLayout>>		LayoutCache::pipelineLayouts;
+std::unordered_map<VkPipelineLayout, uint64_t>								LayoutCache::pipelineLayoutKeys;
+uint64_t																	LayoutCache::nextSerial = 1;
+std::mutex																	LayoutCache::mutex;
+
+
+// The entry of this very definition (not merely of equal hash), else end.
+//
+template<typename VkLayout>
+typename std::unordered_multimap<uint64_t, LayoutCache::Entry<VkLayout>>::iterator
+	LayoutCache::find(std::unordered_multimap<uint64_t, Entry<VkLayout>>& entries, uint64_t key, const string& definition)
+{
+	auto [first, last] = entries.equal_range(key);
+	for (auto found = first; found != last; ++found)
+		if (found->second.definition == definition)
+			return found;
+	return entries.end();
+}
+
+// The entry of this layout (among those of its hash).
+//
+template<typename VkLayout>
+typename std::unordered_multimap<uint64_t, LayoutCache::Entry<VkLayout>>::iterator
+	LayoutCache::find(std::unordered_multimap<uint64_t, Entry<VkLayout>>& entries, uint64_t key, VkLayout layout)
+{
+	auto [first, last] = entries.equal_range(key);
+	for (auto found = first; found != last; ++found)
+		if (found->second.layout == layout)
+			return found;
+	return entries.end();
+}
+
+
+#pragma mark - Descriptor Set Layouts
+
+VkDescriptorSetLayout LayoutCache::AcquireSetLayout(VkDevice device, const vector<VkDescriptorSetLayoutBinding>& bindings,
+													VkDescriptorSetLayoutCreateFlags flags)
+{
+	string definition;
+	definition.append((const char*) &device, sizeof(device));
+	definition.append((const char*) &flags, sizeof(flags));
+	for (const VkDescriptorSetLayoutBinding& binding : bindings) {
+		definition.append((const char*) &binding.binding, sizeof(binding.binding));
+		definition.append((const char*) &binding.descriptorType, sizeof(binding.descriptorType));
+		definition.append((const char*) &binding.descriptorCount, sizeof(binding.descriptorCount));
+		definition.append((const char*) &binding.stageFlags, sizeof(binding.stageFlags));
+		if (binding.pImmutableSamplers != nullptr)		// (by the samplers, not where they're listed)
+			definition.append((const char*) binding.pImmutableSamplers, binding.descriptorCount * sizeof(VkSampler));
+		else
+			definition.append(sizeof(VkSampler), '\0');
+	}
+	uint64_t key = hashBytes(definition.data(), definition.size());
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = find(setLayouts, key, definition);
+	if (found != setLayouts.end()) {
+		++found->second.refCount;
+		return found->second.layout;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= flags,
+		.bindingCount = (uint32_t) bindings.size(),
+		.pBindings	  = bindings.empty() ? nullptr : bindings.data()
+	};
+
+	VkDescriptorSetLayout setLayout;
+	VkResult result = vkCreateDescriptorSetLayout(device, &layoutInfo, nullALLOC, &setLayout);
+	if (result != VK_SUCCESS)
+		Fatal("Create Descriptor Set Layout FAILURE" + ErrStr(result));
+
+	setLayouts.insert({ key, { setLayout, device, 1, std::move(definition), nextSerial++ } });
+	setLayoutKeys[setLayout] = key;
+	return setLayout;
+}
+
+void LayoutCache::ReleaseSetLayout(VkDescriptorSetLayout setLayout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto foundKey = setLayoutKeys.find(setLayout);
+	if (foundKey == setLayoutKeys.end())
+		return;
+	auto found = find(setLayouts, foundKey->second, setLayout);
+	if (--found->second.refCount > 0)
+		return;
+
+	vkDestroyDescriptorSetLayout(found->second.device, setLayout, nullALLOC);
+	setLayouts.erase(found);
+	setLayoutKeys.erase(foundKey);
+}
+
+uint64_t LayoutCache::SetLayoutKey(VkDescriptorSetLayout setLayout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto foundKey = setLayoutKeys.find(setLayout);
+	if (foundKey == setLayoutKeys.end())
+		return (uint64_t) setLayout;	// (not ours: by handle)
+	return find(setLayouts, foundKey->second, setLayout)->second.serial;
+}
+
+
+#pragma mark - Pipeline Layouts
+
+VkPipelineLayout LayoutCache::AcquirePipelineLayout(VkDevice device, const vector<VkDescriptorSetLayout>& setLayouts)
+{
+	uint32_t pushConstantsSize = sizeof(DrawPushConstants);
+	string definition;
+	definition.append((const char*) &device, sizeof(device));
+	definition.append((const char*) &DrawPushConstants::STAGES, sizeof(DrawPushConstants::STAGES));
+	definition.append((const char*) &pushConstantsSize, sizeof(pushConstantsSize));
+	for (VkDescriptorSetLayout setLayout : setLayouts) {
+		uint64_t setLayoutKey = SetLayoutKey(setLayout);
+		definition.append((const char*) &setLayoutKey, sizeof(setLayoutKey));
+	}
+	uint64_t key = hashBytes(definition.data(), definition.size());
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = find(pipelineLayouts, key, definition);
+	if (found != pipelineLayouts.end()) {
+		++found->second.refCount;
+		return found->second.layout;
+	}
+
+	// Declared identically by every pipeline, whether or not its shaders use it, so that pushed
+	//	values remain valid when the next draw binds a different pipeline.
+	VkPushConstantRange pushConstantRange = {
+		.stageFlags	= DrawPushConstants::STAGES,
+		.offset		= 0,
+		.size		= sizeof(DrawPushConstants)
+	};
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+		.sType	= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.setLayoutCount	= (uint32_t) setLayouts.size(),
+		.pSetLayouts	= setLayouts.empty() ? nullptr : setLayouts.data(),
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges	= &pushConstantRange
+	};
+
+	VkPipelineLayout pipelineLayout;
+	VkResult result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullALLOC, &pipelineLayout);
+	if (result != VK_SUCCESS)
+		Fatal("Create Pipeline Layout FAILURE" + ErrStr(result));
+
+	pipelineLayouts.insert({ key, { pipelineLayout, device, 1, std::move(definition), nextSerial++ } });
+	pipelineLayoutKeys[pipelineLayout] = key;
+	return pipelineLayout;
+}
+
+void LayoutCache::ReleasePipelineLayout(VkPipelineLayout pipelineLayout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto foundKey = pipelineLayoutKeys.find(pipelineLayout);
+	if (foundKey == pipelineLayoutKeys.end())
+		return;
+	auto found = find(pipelineLayouts, foundKey->second, pipelineLayout);
+	if (--found->second.refCount > 0)
+		return;
+
+	vkDestroyPipelineLayout(found->second.device, pipelineLayout, nullALLOC);
+	pipelineLayouts.erase(found);
+	pipelineLayoutKeys.erase(foundKey);
+}
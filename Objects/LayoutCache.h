@@ -0,0 +1,67 @@
+//
+// LayoutCache.h
+//	Vulkan Setup
+//
+// Share descriptor set layouts and pipeline layouts: most renderables bind one of only a handful of
+//	"shapes" of descriptor set, so rather than each creating its own VkDescriptorSetLayout (Descriptors)
+//	and VkPipelineLayout (GraphicsPipeline), they acquire them here, keyed by a hash of their definition,
+//	the definition itself kept with each and compared on a hash match (so a collision never returns the
+//	wrong layout), and reference-counted so the last release destroys them.  Fewer driver objects, and pipelines with
+//	the very same layout are trivially compatible, so descriptor sets stay bound across pipeline changes.
+//
+// Immutable samplers are part of a set layout's definition by their handles.  Pipeline layouts are
+//	defined by their set layouts' serials (not handles, which may be reused once destroyed), plus the
+//	push constant range that every pipeline layout declares (DrawPushConstants).
+//	Thread-safe, as pipelines may be built in parallel (see GraphicsPipeline::BuildPending).
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef LayoutCache_h
+#define LayoutCache_h
+
+#include "VulkanPlatform.h"
+#include <unordered_map>
+#include <mutex>
+
+
+class LayoutCache
+{
+	template<typename VkLayout>
+	struct Entry {
+		VkLayout	layout;
+		VkDevice	device;
+		uint32_t	refCount;
+		string		definition;		// (what it was created from, compared on a hash match)
+		uint64_t	serial;			// (unique to this layout, never reused as handles may be)
+	};
+
+		// MEMBERS
+private:
+	static std::unordered_multimap<uint64_t, Entry<VkDescriptorSetLayout>>	setLayouts;			// by hash
+	static std::unordered_map<VkDescriptorSetLayout, uint64_t>				setLayoutKeys;		// by layout
+	static std::unordered_multimap<uint64_t, Entry<VkPipelineLayout>>		pipelineLayouts;
+	static std::unordered_map<VkPipelineLayout, uint64_t>					pipelineLayoutKeys;
+	static uint64_t		nextSerial;
+	static std::mutex	mutex;
+
+		// METHODS
+private:
+	template<typename VkLayout>
+	static typename std::unordered_multimap<uint64_t, Entry<VkLayout>>::iterator
+		find(std::unordered_multimap<uint64_t, Entry<VkLayout>>& entries, uint64_t key, const string& definition);
+	template<typename VkLayout>
+	static typename std::unordered_multimap<uint64_t, Entry<VkLayout>>::iterator
+		find(std::unordered_multimap<uint64_t, Entry<VkLayout>>& entries, uint64_t key, VkLayout layout);
+
+public:
+	static VkDescriptorSetLayout	AcquireSetLayout(VkDevice device, const vector<VkDescriptorSetLayoutBinding>& bindings,
+													 VkDescriptorSetLayoutCreateFlags flags = 0);
+	static void						ReleaseSetLayout(VkDescriptorSetLayout setLayout);
+	static uint64_t					SetLayoutKey(VkDescriptorSetLayout setLayout);	// Equal keys, same layout.
+
+	static VkPipelineLayout	AcquirePipelineLayout(VkDevice device, const vector<VkDescriptorSetLayout>& setLayouts);
+	static void				ReleasePipelineLayout(VkPipelineLayout pipelineLayout);
+};
+
+#endif	// LayoutCache_h
@@ -0,0 +1,197 @@
+//
+// PipelineCache.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "PipelineCache.h"
+#include "FileSystem.h"
+#include "Helpers.h"
+#include "ResourceTracker.h"
+#include <cstdio>
+#include <cstring>
+
+
+// Precedes the cache data in its file.
+//
+struct PipelineCacheFileHeader
+{
+	char		magic[4];
+	uint32_t	version;
+	uint32_t	vendorID;
+	uint32_t	deviceID;
+	uint32_t	driverVersion;
+	uint8_t		pipelineCacheUUID[VK_UUID_SIZE];
+	uint64_t	dataSize;
+	uint64_t	dataHash;
+};
+
+const char		FileMagic[4] = { 'V', 'P', 'L', 'C' };
+const uint32_t	FileVersion	 = 1;
+
+
+void PipelineCache::Create(VkDevice logicalDevice, const VkPhysicalDeviceProperties& deviceProperties)
+{
+	device	   = logicalDevice;
+	properties = deviceProperties;
+
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), "pipeline-cache-%04x-%04x.bin", properties.vendorID, properties.deviceID);
+	filePath = FileSystem::AppLocalStorageDirectory() + fileName;
+
+	vector<uint8_t> initialData = load();
+
+	VkPipelineCacheCreateInfo createInfo = {
+		.sType	= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+		.pNext	= nullptr,
+		.flags	= 0,
+		.initialDataSize = initialData.size(),
+		.pInitialData	 = initialData.empty() ? nullptr : initialData.data()
+	};
+
+	call = vkCreatePipelineCache(device, &createInfo, nullALLOC, &pipelineCache);
+	if (call != VK_SUCCESS && ! initialData.empty()) {
+		Log(WARN, "Pipeline cache data rejected by driver" + ErrStr(call) + "; starting empty.");
+		createInfo.initialDataSize = 0;
+		createInfo.pInitialData	   = nullptr;
+		call = vkCreatePipelineCache(device, &createInfo, nullALLOC, &pipelineCache);
+	}
+	if (call != VK_SUCCESS)
+		Fatal("Create Pipeline Cache FAILURE" + ErrStr(call));
+
+	savedSize = initialData.size();
+	lastSaveCheck = std::chrono::steady_clock::now();
+}
+
+void PipelineCache::Destroy()
+{
+	if (pipelineCache == VK_NULL_HANDLE)
+		return;
+
+	Save();
+	vkDestroyPipelineCache(device, pipelineCache, nullALLOC);
+	pipelineCache = VK_NULL_HANDLE;
+	Log(DEAD, "Destroyed: PipelineCache");
+}
+
+
+size_t PipelineCache::dataSize()
+{
+	size_t size = 0;
+	call = vkGetPipelineCacheData(device, pipelineCache, &size, nullptr);
+	return call == VK_SUCCESS ? size : 0;
+}
+
+// Write to a temporary file then rename it over the old, so that a crash mid-write leaves the
+//	previous cache intact rather than a truncated one.
+//
+void PipelineCache::Save()
+{
+	if (pipelineCache == VK_NULL_HANDLE)
+		return;
+
+	size_t size = dataSize();
+	if (size == 0)
+		return;
+	vector<uint8_t> data(size);
+	call = vkGetPipelineCacheData(device, pipelineCache, &size, data.data());
+	if (call != VK_SUCCESS && call != VK_INCOMPLETE)
+		return;
+	data.resize(size);
+
+	PipelineCacheFileHeader header;
+	memset(&header, 0, sizeof(header));				// (padding too, as written whole)
+	header.version		 = FileVersion;
+	header.vendorID		 = properties.vendorID;
+	header.deviceID		 = properties.deviceID;
+	header.driverVersion = properties.driverVersion;
+	header.dataSize		 = size;
+	header.dataHash		 = hashBytes(data.data(), size);
+	memcpy(header.magic, FileMagic, sizeof(header.magic));
+	memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+	string tempPath = filePath + ".tmp";
+	{
+		ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write((const char*) &header, sizeof(header));
+		file.write((const char*) data.data(), size);
+		if (! file) {
+			Log(WARN, "Could not write pipeline cache: %s", tempPath.c_str());
+			return;
+		}
+	}
+	if (! FileSystem::RenameReplacing(tempPath, filePath)) {
+		Log(WARN, "Could not replace pipeline cache: %s", filePath.c_str());
+		std::remove(tempPath.c_str());
+		return;
+	}
+	savedSize = size;
+}
+
+void PipelineCache::SaveIfDue()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (now - lastSaveCheck < std::chrono::seconds(SAVE_INTERVAL_SECONDS))
+		return;
+	lastSaveCheck = now;
+
+	if (pipelineCache != VK_NULL_HANDLE && dataSize() != savedSize)
+		Save();
+}
+
+
+// Return the saved cache data, or nothing if there is none, or it is for another GPU or driver, or
+//	the file is truncated or otherwise corrupt.
+//
+vector<uint8_t> PipelineCache::load()
+{
+	ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (! file.is_open())
+		return {};
+	uint64_t fileSize = (uint64_t) file.tellg();
+	file.seekg(0);
+
+	PipelineCacheFileHeader header;
+	file.read((char*) &header, sizeof(header));
+	if (! file || memcmp(header.magic, FileMagic, sizeof(header.magic)) != 0 || header.version != FileVersion
+		|| header.vendorID != properties.vendorID || header.deviceID != properties.deviceID
+		|| header.driverVersion != properties.driverVersion
+		|| memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+		Log(NOTE, "Pipeline cache is for another device or driver; rebuilding it.");
+		return {};
+	}
+
+	if (header.dataSize > fileSize - sizeof(header)) {		// (before allocating it)
+		Log(WARN, "Pipeline cache file truncated; rebuilding it.");
+		return {};
+	}
+
+	vector<uint8_t> data(header.dataSize);
+	file.read((char*) data.data(), header.dataSize);
+	if (! file || hashBytes(data.data(), data.size()) != header.dataHash || ! isCompatible(data)) {
+		Log(WARN, "Pipeline cache file corrupt; rebuilding it.");
+		return {};
+	}
+
+	if (LogLimit(LOW))
+		Log(RAW, "Read: pipeline cache - file: %s", filePath.c_str());
+	return data;
+}
+
+// The driver's own header, at the front of its data, must also name this device.
+//
+bool PipelineCache::isCompatible(const vector<uint8_t>& data)
+{
+	VkPipelineCacheHeaderVersionOne vkHeader;
+	if (data.size() < sizeof(vkHeader))
+		return false;
+	memcpy(&vkHeader, data.data(), sizeof(vkHeader));
+
+	return vkHeader.headerSize >= sizeof(vkHeader) && vkHeader.headerSize <= data.size()
+		&& vkHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+		&& vkHeader.vendorID == properties.vendorID && vkHeader.deviceID == properties.deviceID
+		&& memcmp(vkHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
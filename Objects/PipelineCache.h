@@ -0,0 +1,60 @@
+//
+// PipelineCache.h
+//	Vulkan Setup
+//
+// Device-wide VkPipelineCache, persisted between runs so that pipelines compiled on one launch
+//	needn't be compiled again on the next.  Every pipeline creation passes it.
+//
+// Its file (in the app's local storage directory) is named for the GPU's vendorID and deviceID, and
+//	prefixed by a header also recording driverVersion and pipelineCacheUUID, plus the data's size
+//	and hash.  Any mismatch, e.g. after a driver update, and the file is ignored (then overwritten);
+//	the Vulkan header within the data is validated likewise, before the driver ever sees it.
+//
+// Saved when destroyed (with the logical device, including at sleep teardown), and periodically
+//	while running (see SaveIfDue), should the app never exit cleanly.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef PipelineCache_h
+#define PipelineCache_h
+
+#include "VulkanPlatform.h"
+#include <chrono>
+
+
+class PipelineCache
+{
+public:
+	PipelineCache() = default;
+	~PipelineCache()	{ Destroy(); }
+
+	static constexpr int SAVE_INTERVAL_SECONDS = 60;
+
+		// MEMBERS
+private:
+	VkPipelineCache				pipelineCache = VK_NULL_HANDLE;
+	VkDevice					device		  = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties	properties	  = {};
+	string						filePath;
+
+	size_t		savedSize = 0;			// (bytes of cache data last saved or loaded)
+	std::chrono::steady_clock::time_point	lastSaveCheck;
+
+		// METHODS
+public:
+	void	Create(VkDevice logicalDevice, const VkPhysicalDeviceProperties& deviceProperties);
+	void	Destroy();						// Saves first.  Idempotent.
+	void	Save();
+	void	SaveIfDue();					// Call per frame: saves, if grown, every SAVE_INTERVAL_SECONDS.
+private:
+	vector<uint8_t>	load();
+	bool	isCompatible(const vector<uint8_t>& data);
+	size_t	dataSize();
+
+		// getters
+public:
+	VkPipelineCache&	getVkPipelineCache()	{ return pipelineCache; }
+};
+
+#endif	// PipelineCache_h
@@ -0,0 +1,109 @@
+//
+// PipelineLibrary.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "PipelineLibrary.h"
+#include "LayoutCache.h"
+#include "ResourceTracker.h"
+#include <algorithm>
+
+
+std::unordered_multimap<uint64_t, PipelineLibrary::Entry> PipelineLibrary::entries;
+std::unordered_map<VkPipeline, uint64_t>				PipelineLibrary::keys;
+std::mutex												PipelineLibrary::mutex;
+
+
+// (Caller holds mutex.)
+//
+PipelineLibrary::Entry* PipelineLibrary::find(uint64_t key, const string& definition)
+{
+	auto [first, last] = entries.equal_range(key);
+	for (auto iEntry = first; iEntry != last; ++iEntry)
+		if (iEntry->second.definition == definition)
+			return &iEntry->second;
+	return nullptr;
+}
+
+bool PipelineLibrary::Acquire(uint64_t key, const string& definition, VkPipeline& pipeline, VkPipelineLayout& layout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Entry* pEntry = find(key, definition);
+	if (! pEntry)
+		return false;
+
+	++pEntry->refCount;
+	pipeline = pEntry->pipeline;
+	layout	 = pEntry->layout;
+	return true;
+}
+
+VkPipeline PipelineLibrary::FamilyBase(uint64_t familyKey)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto& [key, entry] : entries)
+		if (entry.familyKey == familyKey)
+			return entry.pipeline;
+	return VK_NULL_HANDLE;
+}
+
+bool PipelineLibrary::Add(uint64_t key, const string& definition, uint64_t familyKey, VkDevice device,
+						  VkPipeline& pipeline, VkPipelineLayout& layout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (Entry* pEntry = find(key, definition)) {
+		vkDestroyPipeline(device, pipeline, nullALLOC);
+		LayoutCache::ReleasePipelineLayout(layout);
+		++pEntry->refCount;
+		pipeline = pEntry->pipeline;
+		layout	 = pEntry->layout;
+		return false;
+	}
+
+	entries.insert({ key, {
+		.pipeline	= pipeline,
+		.layout		= layout,
+		.device		= device,
+		.definition	= definition,
+		.familyKey	= familyKey,
+		.refCount	= 1
+	}});
+	keys[pipeline] = key;
+	return true;
+}
+
+void PipelineLibrary::Release(VkPipeline pipeline)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto foundKey = keys.find(pipeline);
+	if (foundKey == keys.end())
+		return;
+	auto [first, last] = entries.equal_range(foundKey->second);
+	auto found = std::find_if(first, last, [pipeline](auto& keyed) { return keyed.second.pipeline == pipeline; });
+	Entry& entry = found->second;
+
+	if (--entry.refCount > 0)
+		return;
+
+	vkDestroyPipeline(entry.device, entry.pipeline, nullALLOC);
+	LayoutCache::ReleasePipelineLayout(entry.layout);
+	Log(DEAD, "Destroyed: GraphicsPipeline");
+
+	entries.erase(found);
+	keys.erase(foundKey);
+}
+
+size_t PipelineLibrary::NumPipelines()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return entries.size();
+}
@@ -0,0 +1,73 @@
+//
+// PipelineLibrary.h
+//	Vulkan Setup
+//
+// Share one VkPipeline (and its VkPipelineLayout) among every GraphicsPipeline created from the same
+//	state, rather than each renderable compiling, and later binding, its own copy.  GraphicsPipeline
+//	hashes its full creation state into a key (see GraphicsPipeline::create): shader code, vertex
+//	bindings and attributes, Customizer bits, render pass and subpass, and descriptor set layout
+//	definition.  An equal key acquires the existing pipeline, reference-counted, and the last release
+//	destroys it.  Each entry also keeps that state as bytes (its "definition"), compared on a key match,
+//	so that a hash collision makes a pipeline of its own rather than sharing the wrong one.  Sharing
+//	also lets RenderBatch (which groups by VkPipeline) draw more per bind.
+//
+// Pipelines whose state differs only in Customizer bits (e.g. blending, culling or depth test) form
+//	a "family:" each is created ALLOW_DERIVATIVES, and a new variant derives from an existing member
+//	(basePipelineHandle), which drivers may use to compile it faster.
+//
+// Each entry holds a reference to its pipeline layout (see LayoutCache), released along with it.
+//	Each renderable still binds its own descriptor sets, allocated from the same shared set layout.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef PipelineLibrary_h
+#define PipelineLibrary_h
+
+#include "VulkanPlatform.h"
+#include <unordered_map>
+#include <mutex>
+
+
+class PipelineLibrary
+{
+public:
+	struct Entry {
+		VkPipeline			pipeline;
+		VkPipelineLayout	layout;
+		VkDevice			device;
+		string				definition;		// (the full state hashed into its key)
+		uint64_t			familyKey;
+		uint32_t			refCount;
+	};
+
+		// MEMBERS
+private:
+	static std::unordered_multimap<uint64_t, Entry>	entries;	// by key (distinct definitions, if colliding)
+	static std::unordered_map<VkPipeline, uint64_t>	keys;		// by pipeline, for Release
+	static std::mutex	mutex;
+
+		// METHODS
+public:
+	// Return true, and the shared pipeline plus its layout (now referenced once more), if one exists for
+	//	key and definition.
+	static bool	Acquire(uint64_t key, const string& definition, VkPipeline& pipeline, VkPipelineLayout& layout);
+
+	// A pipeline of the same family to derive a new one from, or VK_NULL_HANDLE if none.
+	static VkPipeline	FamilyBase(uint64_t familyKey);
+
+	// Hand a newly created pipeline and layout over to the library, referenced once.  Returns false if
+	//	another thread added one for the same key (and definition) meanwhile, in which case that one is returned instead
+	//	(now referenced) and the caller's is destroyed.
+	static bool	Add(uint64_t key, const string& definition, uint64_t familyKey, VkDevice device,
+					VkPipeline& pipeline, VkPipelineLayout& layout);
+
+	// Destroy the pipeline (releasing its layout) when no other GraphicsPipeline still holds it.
+	static void	Release(VkPipeline pipeline);
+
+	static size_t	NumPipelines();
+private:
+	static Entry*	find(uint64_t key, const string& definition);
+};
+
+#endif	// PipelineLibrary_h
@@ -11,8 +11,9 @@
 #include "ResourceTracker.h"
 
 
-RenderPass::RenderPass(GraphicsDevice& graphicsDevice)
-	:	device(graphicsDevice)
+RenderPass::RenderPass(GraphicsDevice& graphicsDevice, bool keepDepthForCompute)
+	:	device(graphicsDevice),
+		keepDepth(keepDepthForCompute)
 {
 	create();
 }
@@ -66,11 +67,12 @@ void RenderPass::create(VkFormat imageFormat, VkFormat depthFormat = VK_FORMAT_U
 		.format			= depthFormat,
 		.samples		= VK_SAMPLE_COUNT_1_BIT,
 		.loadOp			= VK_ATTACHMENT_LOAD_OP_CLEAR,
-		.storeOp		= VK_ATTACHMENT_STORE_OP_DONT_CARE,
+		.storeOp		= keepDepth ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
 		.stencilLoadOp	= VK_ATTACHMENT_LOAD_OP_DONT_CARE,
 		.stencilStoreOp	= VK_ATTACHMENT_STORE_OP_DONT_CARE,
 		.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED,
-		.finalLayout	= VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+		.finalLayout	= keepDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL	// (sampled afterward)
+								  : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
 	};
 
 	VkAttachmentReference depthAttachmentRef = {
@@ -105,18 +107,27 @@ void RenderPass::create(VkFormat imageFormat, VkFormat depthFormat = VK_FORMAT_U
 
 	const VkFlags zero = 0;
 
-	VkSubpassDependency dependency = {
+	VkSubpassDependency dependencies[] = {{
 		.srcSubpass		 = VK_SUBPASS_EXTERNAL,
 		.dstSubpass		 = 0,
 		.srcStageMask	 = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
-						 | (isDepthBufferUsed() ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT : zero),
+						 | (isDepthBufferUsed() ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT : zero)
+						 | (keepsDepth() ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : zero),	// (prior frame's reads)
 		.dstStageMask	 = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
 						 | (isDepthBufferUsed() ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT : zero),
 		.srcAccessMask	 = 0,
 		.dstAccessMask	 = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
 						 | (isDepthBufferUsed() ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : zero),
 		.dependencyFlags = 0
-	};
+	}, {										// Only if keepsDepth: depth writes finish before
+		.srcSubpass		 = 0,					//	compute shaders read them.
+		.dstSubpass		 = VK_SUBPASS_EXTERNAL,
+		.srcStageMask	 = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+		.dstStageMask	 = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		.srcAccessMask	 = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+		.dstAccessMask	 = VK_ACCESS_SHADER_READ_BIT,
+		.dependencyFlags = 0
+	}};
 
 	VkRenderPassCreateInfo renderPassInfo = {
 		.sType	= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
@@ -126,8 +137,8 @@ void RenderPass::create(VkFormat imageFormat, VkFormat depthFormat = VK_FORMAT_U
 		.pAttachments	 = pAttachments,
 		.subpassCount	 = 1,
 		.pSubpasses		 = &subpass,
-		.dependencyCount = 1,
-		.pDependencies	 = &dependency
+		.dependencyCount = keepsDepth() ? 2u : 1u,
+		.pDependencies	 = dependencies
 	};
 
 	call = vkCreateRenderPass(device.getLogical(), &renderPassInfo, nullALLOC, &renderPass);
@@ -3,6 +3,8 @@
 //	Vulkan Setup
 //
 // Encapsulate the process to initialize/create VkRenderPass.
+//	If keepDepth, the depth attachment is stored and left readable by compute shaders
+//	after the pass (for a depth pyramid, see HiZCulling) rather than discarded.
 //
 // 1/31/19 Tadd Jensen
 //	© 0000 (uncopyrighted; use at will)
@@ -19,7 +21,7 @@ class RenderPass : public iRenderPass
 {
 		// XSTRUCT
 public:
-	RenderPass(GraphicsDevice& graphicsDevice);
+	RenderPass(GraphicsDevice& graphicsDevice, bool keepDepth = false);
 	~RenderPass();
 
 		// MEMBERS
@@ -27,6 +29,7 @@ private:
 	VkRenderPass renderPass;
 
 	GraphicsDevice&	 device;		// Save to destruct as constructed.
+	bool			 keepDepth;
 
 		// METHODS
 private:
@@ -44,6 +47,8 @@ public:
 
 	bool	isDepthBufferUsed() override		{ return useDepthBuffer; }
 
+	bool	keepsDepth()						{ return keepDepth && useDepthBuffer; }
+
 	bool	useDepthBuffer = false;	// treated as read-only (i.e.
 };									//	set then not re-referenced)
 
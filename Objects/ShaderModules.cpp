@@ -10,6 +10,15 @@
 #include "ShaderModules.h"
 #include "PlatformSpecifics.h"	// (for __emplace_back on iOS, possibly)
 #include "ResourceTracker.h"
+#include "Helpers.h"
+#include <cstring>
+#include <algorithm>
+
+
+std::unordered_multimap<uint64_t, ShaderModules::SharedModule> ShaderModules::sharedModules;
+std::unordered_map<VkShaderModule, uint64_t>				ShaderModules::sharedModuleKeys;
+uint64_t													ShaderModules::nextSerial = 1;
+std::mutex													ShaderModules::mutex;
 
 
 ShaderModules::ShaderModules(GraphicsDevice& graphics)
@@ -21,9 +30,12 @@ ShaderModules::ShaderModules(Shaders& shaders, GraphicsDevice& graphics)
 {
 	for (auto& shader : shaders )
 	{
-		ShaderCodeType shaderCode = fileSystem.ReadShaderFile(shader.nameShaderFile);
+		ShaderCodeType shaderCode = FileSystem::MapShaderFile(shader.nameShaderFile);
+
+		uint64_t codeHash = hashBytes(shaderCode.data(), shaderCode.size());
 
-		VkShaderModule shaderModule = createShaderModule(shaderCode);
+		uint64_t serial;
+		VkShaderModule shaderModule = acquireShaderModule(shaderCode, codeHash, shader.nameShaderFile, serial);
 
 		StrPtr entrypointFunctionName = shader.nameEntrypointFunction;
 		if (entrypointFunctionName == nullptr)
@@ -32,6 +44,14 @@ ShaderModules::ShaderModules(Shaders& shaders, GraphicsDevice& graphics)
 		shaderModules.emplace_back(shaderModule);
 		shaderStageBits.emplace_back(static_cast<VkShaderStageFlagBits>(shader.fileType));
 		nameFunctionEntrypoints.emplace_back(entrypointFunctionName);
+
+		hashCombine(identity, codeHash);
+		hashCombine(identity, shader.fileType);
+		hashCombine(identity, hashBytes(entrypointFunctionName, strlen(entrypointFunctionName)));
+
+		definition.append((const char*) &serial, sizeof(serial));
+		definition.append((const char*) &shader.fileType, sizeof(shader.fileType));
+		definition.append(entrypointFunctionName, strlen(entrypointFunctionName) + 1);
 	}
 }
 
@@ -40,9 +60,62 @@ ShaderModules::~ShaderModules()
 	size_t nModules = shaderModules.size();
 
 	for (auto& shaderModule : shaderModules)
-		vkDestroyShaderModule(device, shaderModule, nullALLOC);
+		releaseShaderModule(shaderModule);
 
-	Log(DEAD, "Destroyed: %u ShaderModules", nModules);
+	Log(DEAD, "Released: %u ShaderModules", nModules);
+}
+
+
+// Reuse the module of identical SPIR-V if already created (on this device), else create it from the
+//	mapped bytes.  Identical meaning byte for byte, not merely of equal hash: on a hash match the file
+//	the shared module was created from is mapped again and compared, rather than keeping its code.
+//
+VkShaderModule ShaderModules::acquireShaderModule(ShaderCodeType& code, uint64_t codeHash, StrPtr fileName,
+												  uint64_t& serial)
+{
+	uint64_t key = codeHash;
+	hashCombine(key, reinterpret_cast<uintptr_t>(device));
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto [first, last] = sharedModules.equal_range(key);
+	for (auto found = first; found != last; ++found) {
+		SharedModule& shared = found->second;
+		ShaderCodeType sharedCode = FileSystem::MapShaderFile(shared.fileName);
+		if (sharedCode.size() == code.size() && memcmp(sharedCode.data(), code.data(), code.size()) == 0) {
+			++shared.refCount;
+			serial = shared.serial;
+			return shared.shaderModule;
+		}
+	}
+
+	VkShaderModule shaderModule = createShaderModule(code);
+	serial = nextSerial++;
+	sharedModules.insert({ key, {
+		.shaderModule = shaderModule,
+		.fileName	  = fileName,
+		.refCount	  = 1,
+		.serial		  = serial
+	}});
+	sharedModuleKeys[shaderModule] = key;
+	return shaderModule;
+}
+
+void ShaderModules::releaseShaderModule(VkShaderModule shaderModule)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto foundKey = sharedModuleKeys.find(shaderModule);
+	if (foundKey == sharedModuleKeys.end())
+		return;
+
+	auto [first, last] = sharedModules.equal_range(foundKey->second);
+	auto found = std::find_if(first, last, [shaderModule](auto& keyed) { return keyed.second.shaderModule == shaderModule; });
+	if (--found->second.refCount == 0) {
+		vkDestroyShaderModule(device, shaderModule, nullALLOC);
+		sharedModules.erase(found);
+		sharedModuleKeys.erase(foundKey);
+	}
 }
 
 
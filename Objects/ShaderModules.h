@@ -5,6 +5,12 @@
 // Encapsulate all that goes into a VkShaderModule,
 //	and multiple ones at that.
 //
+// SPIR-V is memory-mapped (see MappedFile), so its bytes go straight to vkCreateShaderModule, and each
+//	VkShaderModule is shared device-wide by a hash of those bytes: identical code, under whatever file
+//	name, is one module, reference-counted so the last ShaderModules holding it destroys it.  (Each
+//	keeps the name of the file it came from, re-mapped and compared on a hash match, so a collision
+//	never shares the wrong one, yet no copy of the code stays resident.)
+//
 // 5/19/19 Tadd Jensen
 //	© 0000 (uncopyrighted; use at will)
 //
@@ -14,9 +20,11 @@
 #include "GraphicsDevice.h"
 #include "Shader.h"
 #include "FileSystem.h"
+#include <unordered_map>
+#include <mutex>
 
 
-typedef const vector<char>	ShaderCodeType;
+typedef const MappedFile	ShaderCodeType;
 
 
 class ShaderModules
@@ -33,11 +41,23 @@ private:
 	vector<VkShaderModule>			shaderModules;
 	vector<VkShaderStageFlagBits>	shaderStageBits;
 	vector<StrPtr>					nameFunctionEntrypoints;
+	uint64_t						identity = 0;	// (hash of each stage's SPIR-V, stage and entry point)
+	string							definition;		// (each stage's module serial, stage and entry point)
 
 	vector<VkPipelineShaderStageCreateInfo>	shaderStageInfos;
 	
 	VkDevice	device;
-	FileSystem	fileSystem;
+
+	struct SharedModule {
+		VkShaderModule	shaderModule;
+		string			fileName;		// (what it was created from, to compare against)
+		uint32_t		refCount;
+		uint64_t		serial;			// (unique to this module, never reused as handles may be)
+	};
+	static std::unordered_multimap<uint64_t, SharedModule> sharedModules;	// by hash of SPIR-V (and device)
+	static std::unordered_map<VkShaderModule, uint64_t>	sharedModuleKeys;
+	static uint64_t		nextSerial;
+	static std::mutex	mutex;
 
 		// METHODS
 public:
@@ -45,11 +65,15 @@ public:
 	uint32_t						 NumShaderStages();
 
 private:
+	VkShaderModule acquireShaderModule(ShaderCodeType& code, uint64_t codeHash, StrPtr fileName, uint64_t& serial);
+	void releaseShaderModule(VkShaderModule shaderModule);
 	VkShaderModule createShaderModule(ShaderCodeType& code);
 	void createShaderStageInfos();
 
 		// getters
 public:
+	uint64_t	Identity()	{ return identity; }		// Equal for modules built from identical code.
+	const string& Definition()	{ return definition; }	// Equal only for modules sharing the same code.
 };
 
 #endif // ShaderModules_h
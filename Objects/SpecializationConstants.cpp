@@ -0,0 +1,80 @@
+//
+// SpecializationConstants.cpp
+//	Vulkan Setup
+//
+// See matched header file for definitive main comment.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#include "SpecializationConstants.h"
+#include "VulkanConfigure.h"
+#include "Helpers.h"
+#include <cstring>
+
+
+SpecializationConstants& SpecializationConstants::Set(VkShaderStageFlags stages, uint32_t constantID, int32_t value)
+{
+	return set(stages, constantID, static_cast<uint32_t>(value));
+}
+
+SpecializationConstants& SpecializationConstants::Set(VkShaderStageFlags stages, uint32_t constantID, uint32_t value)
+{
+	return set(stages, constantID, value);
+}
+
+SpecializationConstants& SpecializationConstants::Set(VkShaderStageFlags stages, uint32_t constantID, float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return set(stages, constantID, bits);
+}
+
+SpecializationConstants& SpecializationConstants::Set(VkShaderStageFlags stages, uint32_t constantID, bool value)
+{
+	return set(stages, constantID, static_cast<uint32_t>(value ? VK_TRUE : VK_FALSE));
+}
+
+SpecializationConstants& SpecializationConstants::set(VkShaderStageFlags stages, uint32_t constantID, uint32_t bits)
+{
+	auto iConstant = constants.begin();
+	while (iConstant != constants.end() && iConstant->constantID < constantID)
+		++iConstant;
+
+	if (iConstant != constants.end() && iConstant->constantID == constantID)
+		*iConstant = { stages, constantID, bits };
+	else
+		constants.insert(iConstant, { stages, constantID, bits });
+	return *this;
+}
+
+
+SpecializationConstants& SpecializationConstants::SetConfigured(VkShaderStageFlags stages)
+{
+	Set(stages, PCF_KERNEL_RADIUS_ID, (int32_t) PCF_KERNEL_RADIUS);
+	Set(stages, SHADOW_BIAS_ID, SHADOW_BIAS);
+	return *this;
+}
+
+
+void SpecializationConstants::Gather(VkShaderStageFlagBits stage, vector<VkSpecializationMapEntry>& entries,
+									 vector<uint32_t>& data) const
+{
+	entries.clear();
+	data.clear();
+
+	for (const Constant& constant : constants)
+		if (constant.stages & stage) {
+			entries.push_back({
+				.constantID = constant.constantID,
+				.offset		= (uint32_t) (data.size() * sizeof(uint32_t)),
+				.size		= sizeof(uint32_t)
+			});
+			data.push_back(constant.value);
+		}
+}
+
+uint64_t SpecializationConstants::Key() const
+{
+	return constants.empty() ? 0 : hashBytes(constants.data(), constants.size() * sizeof(Constant));
+}
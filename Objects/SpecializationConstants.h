@@ -0,0 +1,68 @@
+//
+// SpecializationConstants.h
+//	Vulkan Setup
+//
+// Values fixed at pipeline creation, rather than read at runtime (from a UBO or push constant) for every
+//	vertex or fragment: a shader declares them, e.g.
+//		layout(constant_id = 0) const int  PCF_KERNEL_RADIUS = 1;
+//		layout(constant_id = 2) const bool SHADOWS_ENABLED	 = true;
+//	and each pipeline built from it may specialize them differently, the driver then folding constants
+//	and eliminating dead branches, as if compiled with those values.  Carried by DrawableProperties
+//	(`specialization`), per shader stage, into GraphicsPipeline, whose key includes them, so variants
+//	are distinct pipelines (while sharing ShaderModules, and pipeline family for derivation).
+//
+// All values are 4 bytes: int32_t, uint32_t, float, or bool (as VkBool32), matching GLSL int, uint,
+//	float and bool.  IDs below FIRST_USER_CONSTANT_ID are reserved for VulkanConfigure.h's settings
+//	(see SetConfigured), so shaders that declare them needn't hard-code what is configured there.
+//
+// Created 10/18/26 by Tadd Jensen
+//	© 0000 (uncopyrighted; use at will)
+//
+#ifndef SpecializationConstants_h
+#define SpecializationConstants_h
+
+#include "VulkanPlatform.h"
+
+
+enum SpecializationConstantID : uint32_t {
+	PCF_KERNEL_RADIUS_ID	= 0,	// int,	  VulkanConfigure.h's PCF_KERNEL_RADIUS
+	SHADOW_BIAS_ID			= 1,	// float, SHADOW_BIAS
+	FIRST_USER_CONSTANT_ID	= 16
+};
+
+
+class SpecializationConstants
+{
+		// MEMBERS
+private:
+	struct Constant {
+		VkShaderStageFlags	stages;
+		uint32_t			constantID;
+		uint32_t			value;		// (bits of whichever 4-byte type)
+	};
+	vector<Constant>	constants;		// (ordered by constantID)
+
+		// METHODS
+public:
+	// Specialize constant_id `constantID` in the given stage(s); replaces any value already set for it.
+	SpecializationConstants& Set(VkShaderStageFlags stages, uint32_t constantID, int32_t value);
+	SpecializationConstants& Set(VkShaderStageFlags stages, uint32_t constantID, uint32_t value);
+	SpecializationConstants& Set(VkShaderStageFlags stages, uint32_t constantID, float value);
+	SpecializationConstants& Set(VkShaderStageFlags stages, uint32_t constantID, bool value);
+
+	// Set the reserved IDs to VulkanConfigure.h's values, for the fragment stage by default.
+	SpecializationConstants& SetConfigured(VkShaderStageFlags stages = VK_SHADER_STAGE_FRAGMENT_BIT);
+
+	// Fill `entries`, and the `data` they index, with those specializing `stage` (none: left empty).
+	void		Gather(VkShaderStageFlagBits stage, vector<VkSpecializationMapEntry>& entries,
+					   vector<uint32_t>& data) const;
+	uint64_t	Key() const;			// (0 if none set)
+private:
+	SpecializationConstants& set(VkShaderStageFlags stages, uint32_t constantID, uint32_t bits);
+
+		// getters
+public:
+	bool	empty() const	{ return constants.empty(); }
+};
+
+#endif	// SpecializationConstants_h
@@ -12,6 +12,18 @@
 #include "FileSystem.h"
 
 #include <fstream>
+#include <cstdio>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
 
 
 const StrPtr SHADER_SUBDIRECTORY  = "shaders/compiled/";
@@ -63,6 +75,14 @@ vector<char> FileSystem::ReadShaderFile(const string& shaderFilename)
 	return readFile(shaderFilename, SHADER_SUBDIRECTORY, "shader");
 }
 
+MappedFile FileSystem::MapShaderFile(const string& shaderFilename)
+{
+	const string fullPath = ExeAccompaniedFullPath(shaderFilename, SHADER_SUBDIRECTORY);
+	if (LogLimit(LOW))
+		Log(RAW, "Map: shader - file: %s", fullPath.c_str());
+	return MappedFile(fullPath);
+}
+
 vector<char> FileSystem::ReadTextureFile(const string& imageFilename)
 {
 	return readFile(imageFilename, TEXTURE_SUBDIRECTORY, "texture");
@@ -98,3 +118,121 @@ vector<char> FileSystem::readFile(const string& pathName)
 
 	return buffer;
 }
+
+// Rename a file over another, replacing it if it exists (which std::rename won't do on Windows).
+//
+bool FileSystem::RenameReplacing(const string& fromPathName, const string& toPathName)
+{
+#ifdef _WIN32
+	return MoveFileExA(fromPathName.c_str(), toPathName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return std::rename(fromPathName.c_str(), toPathName.c_str()) == 0;
+#endif
+}
+
+
+#pragma mark - MappedFile
+
+MappedFile::MappedFile(const string& pathName)
+{
+	if (map(pathName))
+		return;
+
+	std::ifstream file(pathName, std::ios::ate | std::ios::binary);		// (else read it, as readFile)
+
+	if (!file.is_open())
+		Fatal("Failed to open file: \"" + pathName + "\"!");
+
+	nBytes = (size_t) file.tellg();
+	buffer.resize(nBytes);
+
+	file.seekg(0);
+	file.read(buffer.data(), nBytes);
+
+	pBytes = buffer.data();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	:	nBytes(other.nBytes),
+		isMapped(other.isMapped),
+		buffer(std::move(other.buffer))
+{
+	pBytes = isMapped ? other.pBytes : buffer.data();
+	other.pBytes   = nullptr;
+	other.nBytes   = 0;
+	other.isMapped = false;
+}
+
+MappedFile::~MappedFile()
+{
+	unmap();
+}
+
+
+// (An empty file, which can't be mapped, is simply read.)
+//
+#ifdef _WIN32
+
+bool MappedFile::map(const string& pathName)
+{
+	HANDLE file = CreateFileA(pathName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+							  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (! mapping)
+		return false;
+
+	void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);			// (the view keeps it open)
+	if (! pView)
+		return false;
+
+	pBytes	 = static_cast<const char*>(pView);
+	nBytes	 = (size_t) fileSize.QuadPart;
+	isMapped = true;
+	return true;
+}
+
+void MappedFile::unmap()
+{
+	if (isMapped)
+		UnmapViewOfFile(pBytes);
+	isMapped = false;
+}
+
+#else
+
+bool MappedFile::map(const string& pathName)
+{
+	int fd = open(pathName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat status;
+	void* pView = MAP_FAILED;
+	if (fstat(fd, &status) == 0 && status.st_size > 0)
+		pView = mmap(nullptr, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);						// (the mapping keeps it open)
+	if (pView == MAP_FAILED)
+		return false;
+
+	pBytes	 = static_cast<const char*>(pView);
+	nBytes	 = (size_t) status.st_size;
+	isMapped = true;
+	return true;
+}
+
+void MappedFile::unmap()
+{
+	if (isMapped)
+		munmap(const_cast<char*>(pBytes), nBytes);
+	isMapped = false;
+}
+
+#endif
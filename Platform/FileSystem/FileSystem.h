@@ -27,6 +27,38 @@ using std::ifstream;		//
 #endif
 
 
+// Read-only view of a whole file: memory-mapped where the platform allows (else read into memory
+//	instead), so its bytes can go straight to e.g. vkCreateShaderModule without being copied.
+//	Mapped pages are page-aligned, so suitably aligned for SPIR-V's uint32_t words.
+//
+class MappedFile
+{
+public:
+	MappedFile(const string& pathName);
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+		// MEMBERS
+private:
+	const char*		pBytes	 = nullptr;
+	size_t			nBytes	 = 0;
+	bool			isMapped = false;
+	vector<char>	buffer;				// (if not mapped)
+
+		// METHODS
+private:
+	bool map(const string& pathName);
+	void unmap();
+
+		// getters
+public:
+	const char*	data() const	{ return pBytes; }
+	size_t		size() const	{ return nBytes; }
+};
+
+
 class FileSystem : LocalFileSystem
 {
 		// MEMBERS
@@ -54,7 +86,10 @@ public:
 	static string TerrainFileFullPath(StrPtr fileName);
 
 	vector<char> ReadShaderFile(const string& shaderFilename);
+	static MappedFile MapShaderFile(const string& shaderFilename);
 	vector<char> ReadTextureFile(const string& imageFilename);
+
+	static bool RenameReplacing(const string& fromPathName, const string& toPathName);
 private:
 	vector<char> readFile(const string& fileName, const char* subdirectoryName, const char* showFileType);
 	vector<char> readFile(const string& pathName);
@@ -27,6 +27,8 @@ ImageInfo ImageSDL::Load(StrPtr filePath)
 {
 	Log(RAW, "Load: image - file: %s", filePath);
 
+	if (pImage)						// (previous image, if reused)
+		SDL_FreeSurface(pImage);
 	pImage = IMG_Load(filePath);
 
 	if (!pImage || pImage->pixels == NULL)
@@ -34,8 +34,10 @@ struct ImageInfo {
 
 class iImageSource
 {
-		// pure-virtual methods
 public:
+	virtual ~iImageSource() { }
+
+		// pure-virtual methods
 	virtual ImageInfo Load(StrPtr fileName) = 0;
 
 	virtual ImageInfo ConvertTo(VkFormat format, bool fallbackOnFailure = true) = 0;
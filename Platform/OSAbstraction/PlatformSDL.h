@@ -83,6 +83,7 @@ public:
 	void ExitFullScreen();
 
 	iImageSource& ImageSource()	 { return static_cast<iImageSource&>(image); }
+	iImageSource* NewImageSource() { return new ImageSDL(); }
 	void InitGUISystem()		 { ImGui_ImplSDL2_InitForVulkan(pWindow); }
 	void GUISystemNewFrame()	 { ImGui_ImplSDL2_NewFrame(); }
 	void GUISystemProcessEvent(SDL_Event* pEvent)
@@ -70,6 +70,9 @@ public:
 	virtual void ClearEvents()	= 0;
 
 	virtual iImageSource& ImageSource() = 0;
+	virtual iImageSource* NewImageSource() { return nullptr; }	// Another, independent of the above (e.g. one
+																//	per worker thread), caller to delete; or null
+																//	if platform can't decode concurrently.
 
 	virtual void ShowSoftKeyboard(bool show = true) { /* if platform doesn't have/need
 														 "soft" keyboard, that's okay */ }
@@ -18,6 +18,9 @@ struct
 
 	const VkBool32	useMipLod		= true;		// Enable Mipmapping/Level-of-detail (especially for grid floor).
 
+	const bool		useBindless		= true;		// Register textures in one device-wide array, for renderables
+												//	customized BINDLESS (if the device supports descriptor indexing).
+
 } RenderSettings;
 
 #endif	// RenderSettings_h
@@ -123,12 +123,22 @@ const StrPtr DEVICE_EXTENSION_NAMES[] = {
 //			 ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
 	SWAPCHAIN_EXTENSION
 	,VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME
+	,VK_KHR_MAINTENANCE3_EXTENSION_NAME			// (required by the next)
+	,VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME	// For BindlessDescriptors.
+	,VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME	// For DescriptorWriter.
+	,VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME				// For DescriptorWriter::CmdPush.
+	,VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME			// For MipmapGenerator's barriers.
 };
 const int N_DEVICE_EXTENSION_NAMES = N_ELEMENTS_IN_ARRAY(DEVICE_EXTENSION_NAMES);
 
 const bool REQUIRE_DEVICE_EXTENSION[] = {
 	true
 	,false
+	,false
+	,false
+	,false
+	,false
+	,false
 };
 
 
@@ -22,10 +22,12 @@ VulkanSetup::VulkanSetup(iPlatform& platform,
 		windowSurface(vulkan, platform),
 		device(windowSurface, vulkan, validation),
 		swapchain(device, windowSurface),
-		depthBuffer(swapchain, device, !(directive & NO_DEPTH_BUFFER)),
-		renderPass(device),
+		depthBuffer(swapchain, device, !(directive & NO_DEPTH_BUFFER), directive & DEPTH_PYRAMID),
+		renderPass(device, directive & DEPTH_PYRAMID),
 		framebuffers(swapchain, depthBuffer, renderPass, device),
 		syncObjects(device),
+		frameConstants(swapchain, device),
+		textureLoader(device, platform),
 		command(* new CommandControl(framebuffers, device))		// initialize CommandPool
 {
 	Log(GOAL, "----V-U-L-K-A-N---R-E-A-D-Y----");
@@ -46,6 +48,7 @@ void VulkanSetup::RecreateRenderingResources()
 	swapchain.Recreate();
 	depthBuffer.Recreate(swapchain);
 	framebuffers.Recreate(swapchain, depthBuffer, renderPass);
+	frameConstants.Recreate(swapchain);		// (swapchain image count may differ)
 
 	// note, not needing re-creation: commandPool, syncObjs, renderPass, device, window
 
@@ -85,6 +88,8 @@ void VulkanSetup::TeardownForSleep(const std::function<void()>& destroyAppResour
 	command.Destroy();						// CPU buffer-set array (VkCommandBuffers freed with the pool)
 	command.getCommandPool().destroy();
 	syncObjects.destroy();
+	frameConstants.destroy();
+	textureLoader.destroy();
 	framebuffers.destroy();
 	renderPass.destroy();
 	depthBuffer.destroy();
@@ -107,8 +112,11 @@ void VulkanSetup::RebuildAfterSleep(const std::function<void()>& rebuildAppResou
 	renderPass.Recreate();
 	framebuffers.Recreate(swapchain, depthBuffer, renderPass);
 	syncObjects.Recreate();
+	frameConstants.Recreate(swapchain);
+	textureLoader.Recreate();
 	command.Create(framebuffers);
 
+	GraphicsPipeline::BeginBuildPhase();	// (built together by PostInitPrepBuffers)
 	if (rebuildAppResources)
 		rebuildAppResources();
 
@@ -23,6 +23,8 @@
 #include "RenderPass.h"
 #include "Framebuffers.h"
 #include "SyncObjects.h"
+#include "FrameConstants.h"
+#include "TextureLoader.h"
 #include <functional>
 
 class CommandControl;
@@ -30,7 +32,8 @@ class CommandControl;
 
 enum SteerSetup {	// minor tailoring of the setup process
 	BASIC			= 0,
-	NO_DEPTH_BUFFER = 0b00000001
+	NO_DEPTH_BUFFER = 0b00000001,
+	DEPTH_PYRAMID	= 0b00000010	// Keep depth buffer after render pass, sampleable, for HiZCulling.
 };
 
 
@@ -61,6 +64,8 @@ public:
 	RenderPass			renderPass;
 	Framebuffers		framebuffers;
 	SyncObjects			syncObjects;
+	FrameConstants		frameConstants;		// (shared camera/light UBO, see FrameConstants.h)
+	TextureLoader		textureLoader;		// (parallel decode, batched upload, see TextureLoader.h)
 	CommandControl&		command;
 
 
@@ -200,6 +200,11 @@ void VulkanTester::draw()
 
 		vulkan.command.renderables.UpdateUniformBuffers(iNextImage);
 
+		UBO_Frame& frame = vulkan.frameConstants.frame;		// (shared by any renderable SETS_BY_FREQUENCY)
+		frame.camera.view = MVP.view;
+		frame.camera.proj = MVP.proj;
+		vulkan.frameConstants.Update(iNextImage);
+
 		// SUBMIT --------------------------------------------------------------------------------------
 
 		VkPipelineStageFlags waitStageFlags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;